@@ -0,0 +1,250 @@
+#include "mjpc/alert_rules.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+namespace mjpc {
+
+const char* const AlertRuleSet::kDefaultRules =
+    "overspeed: speed_kmh > 120 clear 115 for 0.5\n"
+    "overheat: temperature > 105 clear 100 for 2\n"
+    "low_fuel: fuel < 20 clear 22\n"
+    "redline: rpm > 6000 clear 5800 for 0.2\n";
+
+// ============ 信号 ============
+const char* AlertSignalName(AlertSignal signal) {
+    static const char* const kNames[ALERT_SIGNAL_COUNT] = {
+        "speed_kmh", "speed_ms", "rpm", "fuel", "temperature", "battery_level",
+        "throttle", "brake", "steering"
+    };
+    if (signal < 0 || signal >= ALERT_SIGNAL_COUNT) return "unknown";
+    return kNames[signal];
+}
+
+void FillAlertSignals(const DashboardData& data, AlertSignals* signals) {
+    double* v = signals->value;
+    v[ALERT_SPEED_KMH] = data.speed_kmh;
+    v[ALERT_SPEED_MS] = data.speed_ms;
+    v[ALERT_RPM] = data.rpm;
+    v[ALERT_FUEL] = data.fuel;
+    v[ALERT_TEMPERATURE] = data.temperature;
+    v[ALERT_BATTERY] = data.battery_level;
+    v[ALERT_THROTTLE] = data.throttle;
+    v[ALERT_BRAKE] = data.brake;
+    v[ALERT_STEERING] = data.steering;
+}
+
+// ============ 编译 ============
+namespace {
+
+bool ParseNumber(const std::string& token, double* value) {
+    char* end = nullptr;
+    *value = strtod(token.c_str(), &end);
+    return end != token.c_str() && *end == '\0' && std::isfinite(*value);
+}
+
+}  // namespace
+
+AlertRuleSet::AlertRuleSet() {
+    Compile(kDefaultRules);
+}
+
+bool AlertRuleSet::Compile(const std::string& text, std::string* error) {
+    // 先编译到临时表，全部无误后再替换
+    Rule rules[kMaxAlertRules];
+    char names[kMaxAlertRules][kAlertNameLength];
+    int count = 0;
+    char message[160];
+    auto fail = [&](int line) {
+        if (error) *error = "alert rule " + std::to_string(line) + ": " + message;
+        return false;
+    };
+
+    std::vector<std::string> lines;
+    size_t begin = 0;
+    while (begin <= text.size()) {
+        size_t end = text.find_first_of(";\n", begin);
+        if (end == std::string::npos) end = text.size();
+        std::string line = text.substr(begin, end - begin);
+        line = line.substr(0, line.find('#'));
+        if (line.find_first_not_of(" \t\r") != std::string::npos) lines.push_back(line);
+        begin = end + 1;
+    }
+
+    for (int n = 0; n < static_cast<int>(lines.size()); n++) {
+        const std::string& line = lines[n];
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            snprintf(message, sizeof(message), "expected 'name: signal > value'");
+            return fail(n + 1);
+        }
+        std::string name = line.substr(0, colon);
+        name.erase(0, name.find_first_not_of(" \t"));
+        name.erase(name.find_last_not_of(" \t") + 1);
+        if (name.empty() || name.size() >= kAlertNameLength) {
+            snprintf(message, sizeof(message), "name must be 1-%d characters", kAlertNameLength - 1);
+            return fail(n + 1);
+        }
+        for (int i = 0; i < count; i++) {
+            if (name == names[i]) {
+                snprintf(message, sizeof(message), "duplicate name '%s'", name.c_str());
+                return fail(n + 1);
+            }
+        }
+        if (count == kMaxAlertRules) {
+            snprintf(message, sizeof(message), "more than %d rules", kMaxAlertRules);
+            return fail(n + 1);
+        }
+
+        std::istringstream tokens(line.substr(colon + 1));
+        std::string token;
+        Rule rule = {};
+        tokens >> token;
+        int signal = 0;
+        while (signal < ALERT_SIGNAL_COUNT && token != AlertSignalName(static_cast<AlertSignal>(signal))) {
+            signal++;
+        }
+        if (signal == ALERT_SIGNAL_COUNT) {
+            snprintf(message, sizeof(message), "unknown signal '%s'", token.c_str());
+            return fail(n + 1);
+        }
+        rule.signal = static_cast<uint8_t>(signal);
+
+        tokens >> token;
+        if (token == "rate") {
+            rule.rate = 1;
+            tokens >> token;
+        }
+        if (token != ">" && token != "<") {
+            snprintf(message, sizeof(message), "expected '>' or '<', got '%s'", token.c_str());
+            return fail(n + 1);
+        }
+        rule.sign = token == "<" ? -1.0f : 1.0f;
+
+        double threshold, clear;
+        if (!(tokens >> token) || !ParseNumber(token, &threshold)) {
+            snprintf(message, sizeof(message), "invalid threshold '%s'", token.c_str());
+            return fail(n + 1);
+        }
+        clear = threshold;
+        double raise_delay = 0.0, clear_delay = 0.0;
+        while (tokens >> token) {
+            std::string value;
+            double number;
+            if (!(tokens >> value) || !ParseNumber(value, &number)) {
+                snprintf(message, sizeof(message), "'%s' needs a number", token.c_str());
+                return fail(n + 1);
+            }
+            if (token == "clear") {
+                clear = number;
+            } else if ((token == "for" || token == "hold") && number >= 0.0) {
+                (token == "for" ? raise_delay : clear_delay) = number;
+            } else {
+                snprintf(message, sizeof(message), "unexpected '%s %s'", token.c_str(), value.c_str());
+                return fail(n + 1);
+            }
+        }
+        // 解除值必须在阈值的"安全"一侧，否则滞回带为负
+        if (rule.sign * clear > rule.sign * threshold) {
+            snprintf(message, sizeof(message), "clear %g is past threshold %g", clear, threshold);
+            return fail(n + 1);
+        }
+        rule.raise = rule.sign * threshold;
+        rule.clear = rule.sign * clear;
+        rule.raise_delay = static_cast<float>(raise_delay);
+        rule.clear_delay = static_cast<float>(clear_delay);
+
+        rules[count] = rule;
+        std::strncpy(names[count], name.c_str(), kAlertNameLength);
+        count++;
+    }
+
+    num_rules_ = count;
+    uses_rate_ = false;
+    for (int i = 0; i < count; i++) {
+        rules_[i] = rules[i];
+        std::memcpy(names_[i], names[i], kAlertNameLength);
+        uses_rate_ |= rules[i].rate != 0;
+    }
+    return true;
+}
+
+int AlertRuleSet::Find(const char* name) const {
+    for (int i = 0; i < num_rules_; i++) {
+        if (strncmp(names_[i], name, kAlertNameLength) == 0) return i;
+    }
+    return -1;
+}
+
+// ============ 求值 ============
+double AlertRuleSet::Value(int rule, const AlertSignals& signals, const AlertState& state) const {
+    const Rule& r = rules_[rule];
+    return r.rate ? state.rate[r.signal] : signals.value[r.signal];
+}
+
+AlertMask AlertRuleSet::Evaluate(const AlertSignals& signals, double dt, AlertState* state) const {
+    state->raised = 0;
+    state->cleared = 0;
+    if (!(dt > 0.0)) return state->active;
+
+    if (uses_rate_) {
+        const double inv_dt = 1.0 / dt;
+        for (int s = 0; s < ALERT_SIGNAL_COUNT; s++) {
+            state->rate[s] = state->has_previous ? (signals.value[s] - state->previous[s]) * inv_dt : 0.0;
+            state->previous[s] = signals.value[s];
+        }
+        state->has_previous = true;
+    }
+
+    const float step = static_cast<float>(dt);
+    AlertMask active = state->active;
+    for (int i = 0; i < num_rules_; i++) {
+        const Rule& r = rules_[i];
+        const AlertMask bit = AlertMask(1) << i;
+        const bool on = (active & bit) != 0;
+        const double x = r.sign * (r.rate ? state->rate[r.signal] : signals.value[r.signal]);
+        // 滞回：未触发时与阈值比较，已触发时与解除值比较
+        const bool condition = x > (on ? r.clear : r.raise);
+        if (condition == on) {
+            state->timer[i] = 0.0f;
+            continue;
+        }
+        // 去抖：相反的条件持续够久才切换
+        state->timer[i] += step;
+        if (state->timer[i] >= (on ? r.clear_delay : r.raise_delay)) {
+            state->timer[i] = 0.0f;
+            active ^= bit;
+        }
+    }
+    state->raised = active & ~state->active;
+    state->cleared = state->active & ~active;
+    state->active = active;
+    return active;
+}
+
+void AlertRuleSet::Evaluate(const AlertSignals* signals, int count, double dt,
+                            AlertState* states) const {
+    for (int i = 0; i < count; i++) Evaluate(signals[i], dt, states + i);
+}
+
+// ============ 日志 ============
+void AlertLog::Record(const AlertRuleSet& rules, const AlertSignals& signals,
+                      const AlertState& state, double time, int vehicle) {
+    AlertMask changed = state.raised | state.cleared;
+    for (int i = 0; changed; i++, changed >>= 1) {
+        if (!(changed & 1u)) continue;
+        AlertEvent event;
+        event.time = time;
+        event.value = rules.Value(i, signals, state);
+        event.vehicle = vehicle;
+        event.rule = static_cast<int16_t>(i);
+        event.raised = (state.raised >> i) & 1u;
+        Push(event);
+    }
+}
+
+}  // namespace mjpc
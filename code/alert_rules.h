@@ -0,0 +1,144 @@
+#ifndef MJPC_ALERT_RULES_H_
+#define MJPC_ALERT_RULES_H_
+
+#include <cstdint>
+#include <string>
+
+#include "mjpc/dashboard_data.h"
+
+namespace mjpc {
+
+// ============ 警报信号 ============
+// 规则可引用的量；每步由调用方填入 AlertSignals（单车见 FillAlertSignals）
+enum AlertSignal {
+    ALERT_SPEED_KMH,
+    ALERT_SPEED_MS,
+    ALERT_RPM,
+    ALERT_FUEL,              // %
+    ALERT_TEMPERATURE,
+    ALERT_BATTERY,           // %
+    ALERT_THROTTLE,
+    ALERT_BRAKE,
+    ALERT_STEERING,
+    ALERT_SIGNAL_COUNT
+};
+
+// 规则文本中的信号名（与 DashboardData 字段同名）
+const char* AlertSignalName(AlertSignal signal);
+
+struct AlertSignals {
+    double value[ALERT_SIGNAL_COUNT] = {};
+};
+
+void FillAlertSignals(const DashboardData& data, AlertSignals* signals);
+
+// ============ 警报规则 ============
+// 文本格式，每条规则一行（或以 ';' 分隔），'#' 之后为注释：
+//
+//   名称: 信号 [rate] (>|<) 阈值 [clear 解除值] [for 秒] [hold 秒]
+//
+//   rate     比较信号的变化率（每秒），否则比较信号本身
+//   clear    滞回：'>' 规则在值低于解除值时才解除（'<' 规则相反），默认等于阈值
+//   for      条件持续这么久才触发（去抖）
+//   hold     解除条件持续这么久才解除
+//
+// 例：redline: rpm > 6000 clear 5800 for 0.2
+//
+// Compile 把规则编译成定长表（信号下标、方向、阈值、延时），'<' 规则预先取反，
+// 求值时所有规则都按 "x > 阈值" 比较。规则数不超过 kMaxAlertRules，
+// 第 i 条规则对应活动位掩码的第 i 位。
+constexpr int kMaxAlertRules = 32;
+constexpr int kAlertNameLength = 16;
+using AlertMask = uint32_t;
+
+// 每辆车的警报状态（POD，可以放在数组里批量求值）
+struct AlertState {
+    AlertMask active = 0;
+    AlertMask raised = 0;                      // 上一次 Evaluate 中触发的
+    AlertMask cleared = 0;                     // 上一次 Evaluate 中解除的
+    float timer[kMaxAlertRules] = {};          // 与当前状态相反的条件已持续的时间 (s)
+    double previous[ALERT_SIGNAL_COUNT] = {};  // 上一步的信号值（变化率用）
+    double rate[ALERT_SIGNAL_COUNT] = {};
+    bool has_previous = false;
+};
+
+class AlertRuleSet {
+public:
+    // README 中的超速、过热、低油量、红区警告
+    static const char* const kDefaultRules;
+    // 温度显示按这条规则的活动位标红（规则名称）
+    static constexpr const char* kOverheat = "overheat";
+
+    AlertRuleSet();
+
+    // 编译规则文本，成功后替换当前规则；失败时保留原规则，原因写入 error（可为空）
+    bool Compile(const std::string& text, std::string* error = nullptr);
+
+    int NumRules() const { return num_rules_; }
+    const char* Name(int rule) const { return names_[rule]; }
+    // 按名称查找规则，不存在时返回 -1
+    int Find(const char* name) const;
+    // 名为 name 的规则在活动位掩码中的位（没有该规则时为 0）
+    AlertMask Bit(const char* name) const {
+        int rule = Find(name);
+        return rule >= 0 ? AlertMask(1) << rule : 0;
+    }
+    // 规则比较的量（信号或其变化率），用于日志
+    double Value(int rule, const AlertSignals& signals, const AlertState& state) const;
+
+    // 推进 dt 秒并返回活动位掩码；dt <= 0 时不改变状态（只清空 raised/cleared）
+    AlertMask Evaluate(const AlertSignals& signals, double dt, AlertState* state) const;
+    // 多辆车（状态与信号一一对应）
+    void Evaluate(const AlertSignals* signals, int count, double dt, AlertState* states) const;
+
+private:
+    struct Rule {
+        uint8_t signal;
+        uint8_t rate;          // 1 为比较变化率
+        float sign;            // '<' 规则为 -1，比较前乘到值上
+        double raise;          // 已乘 sign
+        double clear;          // 已乘 sign
+        float raise_delay;
+        float clear_delay;
+    };
+
+    Rule rules_[kMaxAlertRules];
+    char names_[kMaxAlertRules][kAlertNameLength];
+    int num_rules_ = 0;
+    bool uses_rate_ = false;
+};
+
+// ============ 警报日志 ============
+// 定长环形缓冲，写满后覆盖最早的事件；Push 不分配内存
+struct AlertEvent {
+    double time = 0.0;         // 仿真时间 (s)
+    double value = 0.0;        // 规则比较的量
+    int32_t vehicle = 0;
+    int16_t rule = 0;
+    int16_t raised = 0;        // 1 触发，0 解除
+};
+
+class AlertLog {
+public:
+    static constexpr int kCapacity = 64;
+
+    void Clear() { count_ = 0; }
+    void Push(const AlertEvent& event) { events_[count_++ % kCapacity] = event; }
+    // 把 state 中本步触发和解除的规则各记一条
+    void Record(const AlertRuleSet& rules, const AlertSignals& signals, const AlertState& state,
+                double time, int vehicle = 0);
+
+    // 保留的事件数和按时间顺序的第 i 条（0 为最早）
+    int Size() const { return count_ < kCapacity ? static_cast<int>(count_) : kCapacity; }
+    const AlertEvent& At(int i) const { return events_[(count_ - Size() + i) % kCapacity]; }
+    // 累计事件数（含已被覆盖的），用于增量读取
+    uint64_t Total() const { return count_; }
+
+private:
+    AlertEvent events_[kCapacity];
+    uint64_t count_ = 0;
+};
+
+}  // namespace mjpc
+
+#endif  // MJPC_ALERT_RULES_H_
@@ -0,0 +1,272 @@
+#include "mjpc/console_view.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace mjpc {
+
+namespace {
+
+// 两个变化区间之间相同的单元格不超过此数时一并输出，比多一次光标移动（约 8 字节）省
+constexpr int kMaxGap = 6;
+
+// 显示宽度：东亚宽字符和常见 emoji 占两列
+int CodePointWidth(uint32_t code) {
+    if (code >= 0x1100 && code <= 0x115F) return 2;
+    if (code >= 0x2E80 && code <= 0xA4CF) return 2;
+    if (code >= 0xAC00 && code <= 0xD7A3) return 2;
+    if (code >= 0xF900 && code <= 0xFAFF) return 2;
+    if (code >= 0xFE30 && code <= 0xFE4F) return 2;
+    if (code >= 0xFF00 && code <= 0xFF60) return 2;
+    if (code >= 0xFFE0 && code <= 0xFFE6) return 2;
+    if (code >= 0x1F300 && code <= 0x1F64F) return 2;
+    if (code >= 0x1F900 && code <= 0x1F9FF) return 2;
+    return 1;
+}
+
+// 解码一个 UTF-8 字符，返回字节数；非法序列返回 0
+int DecodeUtf8(const char* text, uint32_t* code) {
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(text);
+    int length;
+    if (s[0] < 0x80) { *code = s[0]; return 1; }
+    else if ((s[0] & 0xE0) == 0xC0) { *code = s[0] & 0x1F; length = 2; }
+    else if ((s[0] & 0xF0) == 0xE0) { *code = s[0] & 0x0F; length = 3; }
+    else if ((s[0] & 0xF8) == 0xF0) { *code = s[0] & 0x07; length = 4; }
+    else return 0;
+    for (int i = 1; i < length; i++) {
+        if ((s[i] & 0xC0) != 0x80) return 0;
+        *code = (*code << 6) | (s[i] & 0x3F);
+    }
+    return length;
+}
+
+void AppendMove(std::string* out, int row, int col) {
+    char move[24];
+    int length = snprintf(move, sizeof(move), "\x1b[%d;%dH", row + 1, col + 1);
+    out->append(move, length);
+}
+
+}  // namespace
+
+// ============ 终端屏幕缓冲 ============
+TerminalScreen::TerminalScreen(int rows, int cols)
+    : rows_(std::max(rows, 1)), cols_(std::max(cols, 1)),
+      shown_(rows_ * cols_), next_(rows_ * cols_) {}
+
+void TerminalScreen::Clear() {
+    std::fill(next_.begin(), next_.end(), Cell());
+}
+
+int TerminalScreen::Put(int row, int col, const char* text) {
+    if (row < 0 || row >= rows_ || col < 0) return col;
+    Cell* line = &next_[row * cols_];
+    while (*text && col < cols_) {
+        uint32_t code = 0;
+        int length = DecodeUtf8(text, &code);
+        Cell cell;
+        if (length == 0) {
+            cell.bytes[0] = '?';
+            length = 1;
+        } else {
+            std::memcpy(cell.bytes, text, length);
+            cell.length = static_cast<uint8_t>(length);
+            cell.width = static_cast<uint8_t>(CodePointWidth(code));
+        }
+        text += length;
+        if (col + cell.width > cols_) break;
+
+        // 覆盖宽字符的一半时，另一半改为空格
+        if (line[col].width == 0 && col > 0) line[col - 1] = Cell();
+        int end = col + cell.width;
+        if (end < cols_ && line[end].width == 0) line[end] = Cell();
+
+        line[col] = cell;
+        if (cell.width == 2) {
+            line[col + 1] = Cell();
+            line[col + 1].length = 0;
+            line[col + 1].width = 0;
+        }
+        col = end;
+    }
+    return col;
+}
+
+int TerminalScreen::Printf(int row, int col, const char* format, ...) {
+    char text[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    return Put(row, col, text);
+}
+
+void TerminalScreen::Flush(std::string* out) {
+    bool full = !valid_;
+    if (full) out->append("\x1b[?25l\x1b[H\x1b[2J");   // 隐藏光标并清屏
+    valid_ = true;
+
+    int cursor_row = -1, cursor_col = -1;
+    for (int row = 0; row < rows_; row++) {
+        Cell* shown = &shown_[row * cols_];
+        const Cell* next = &next_[row * cols_];
+        int col = 0;
+        while (col < cols_) {
+            if (!full && next[col] == shown[col]) {
+                col++;
+                continue;
+            }
+            // 变化区间：相隔不超过 kMaxGap 的变化合并，两端不切开宽字符
+            int start = col;
+            while (start > 0 && (next[start].width == 0 || shown[start].width == 0)) start--;
+            int last = col;
+            for (int k = col + 1; k < cols_ && k - last <= kMaxGap; k++) {
+                if (full || next[k] != shown[k]) last = k;
+            }
+            int end = last + 1;
+            while (end < cols_ && (next[end].width == 0 || shown[end].width == 0)) end++;
+
+            if (row != cursor_row || start != cursor_col) AppendMove(out, row, start);
+            for (int k = start; k < end; k++) {
+                if (next[k].width > 0) out->append(next[k].bytes, next[k].length);
+                shown[k] = next[k];
+            }
+            cursor_row = row;
+            cursor_col = end;
+            col = end;
+        }
+    }
+}
+
+// ============ 终端仪表盘 ============
+ConsoleView::ConsoleView() : screen_(kRows, kCols) {
+    output_.reserve(4 * kRows * kCols + 256);
+    SetAlertRules(AlertRuleSet());
+}
+
+bool ConsoleView::Start(const ConsoleViewOptions& options) {
+    if (thread_.joinable()) return false;
+    options_ = options;
+    if (!options_.stream) options_.stream = stdout;
+    screen_.Invalidate();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = false;
+    }
+    thread_ = std::thread(&ConsoleView::Run, this);
+    return true;
+}
+
+void ConsoleView::Stop() {
+    if (!thread_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    thread_.join();
+    if (FramesDrawn() > 0) {
+        fputs(RestoreSequence(), options_.stream);
+        fflush(options_.stream);
+    }
+}
+
+void ConsoleView::Publish(const TelemetrySnapshot& snapshot) {
+    published_++;
+    if (snapshot.frame == 0) {
+        TelemetrySnapshot numbered = snapshot;
+        numbered.frame = published_;
+        latest_.Write(numbered);
+    } else {
+        latest_.Write(snapshot);
+    }
+}
+
+const char* ConsoleView::RestoreSequence() {
+    static const std::string sequence = "\x1b[" + std::to_string(kRows + 1) + ";1H\x1b[?25h";
+    return sequence.c_str();
+}
+
+const std::string& ConsoleView::Draw(const TelemetrySnapshot& snapshot) {
+    Layout(snapshot);
+    output_.clear();
+    screen_.Flush(&output_);
+    frames_drawn_.fetch_add(1, std::memory_order_relaxed);
+    bytes_written_.fetch_add(output_.size(), std::memory_order_relaxed);
+    return output_;
+}
+
+void ConsoleView::Run() {
+    auto period = std::chrono::duration<double>(1.0 / std::max(options_.rate_hz, 0.1));
+    uint64_t last_sequence = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+        lock.unlock();
+        // 序号为 0 表示还没有发布过，没有变化时不输出
+        uint64_t sequence = latest_.Sequence();
+        TelemetrySnapshot snapshot;
+        if (sequence != last_sequence && latest_.Read(&snapshot, &sequence)) {
+            last_sequence = sequence;
+            const std::string& output = Draw(snapshot);
+            fwrite(output.data(), 1, output.size(), options_.stream);
+            fflush(options_.stream);
+        }
+        lock.lock();
+        wake_.wait_for(lock, period, [this]() { return stop_; });
+    }
+}
+
+// ============ 布局 ============
+void ConsoleView::Layout(const TelemetrySnapshot& s) {
+    auto bar = [this](int row, int col, double value, int width) {
+        int filled = static_cast<int>(std::clamp(value, 0.0, 1.0) * width);
+        col = screen_.Put(row, col, "[");
+        for (int i = 0; i < width; i++) col = screen_.Put(row, col, i < filled ? "█" : " ");
+        screen_.Put(row, col, "]");
+    };
+
+    screen_.Clear();
+    screen_.Printf(0, 0, "汽车仪表盘   t=%10.2f s   frame %llu", s.time,
+                   static_cast<unsigned long long>(s.frame));
+    screen_.Printf(1, 0, "速度 %6.1f km/h  %5.1f m/s   加速度 %+6.2f m/s²",
+                   s.speed_kmh, s.speed_ms, s.acceleration);
+    int col = screen_.Printf(2, 0, "转速 %6.0f RPM  ", s.rpm);
+    bar(2, col, s.max_rpm > 0.0 ? s.rpm / s.max_rpm : 0.0, 24);
+
+    char gear[8];
+    if (s.gear == -1) snprintf(gear, sizeof(gear), "R");
+    else if (s.gear == 0) snprintf(gear, sizeof(gear), "N");
+    else snprintf(gear, sizeof(gear), "D%d", static_cast<int>(s.gear));
+    screen_.Printf(3, 0, "档位 %-3s  模式 %-15s  自动驾驶 %s", gear, s.mode,
+                   s.autopilot ? "开" : "关");
+
+    col = screen_.Printf(4, 0, "油门 %5.1f%%  ", s.throttle * 100.0);
+    bar(4, col, s.throttle, 24);
+    col = screen_.Printf(5, 0, "刹车 %5.1f%%  ", s.brake * 100.0);
+    bar(5, col, s.brake, 24);
+
+    // 转向：中心为 |，当前位置为 ^
+    col = screen_.Printf(6, 0, "转向 %+6.1f°  [", s.steering * 90.0);
+    const int width = 24, center = width / 2;
+    int position = center + static_cast<int>(std::lround(std::clamp(s.steering, -1.0, 1.0) * center));
+    position = std::min(position, width - 1);
+    for (int i = 0; i < width; i++) {
+        col = screen_.Put(6, col, i == position ? "^" : (i == center ? "|" : " "));
+    }
+    screen_.Put(6, col, "]");
+
+    bool overheat = (s.alerts & overheat_bit_.load(std::memory_order_relaxed)) != 0;
+    screen_.Printf(7, 0, "燃油 %5.1f%%   电池 %5.1f%%   温度 %5.1f°C%s", s.fuel,
+                   s.battery_level, s.temperature, overheat ? " 过热" : "");
+    screen_.Printf(8, 0, "位置 X=%+8.2f Y=%+8.2f Z=%+6.2f", s.car_x, s.car_y, s.car_z);
+    screen_.Printf(9, 0, "朝向 %6.1f°   里程 %8.2f km", s.car_heading * 180.0 / M_PI,
+                   s.trip_distance);
+    screen_.Printf(10, 0, "状态 %s", s.warning ? "警告" : "正常");
+}
+
+}  // namespace mjpc
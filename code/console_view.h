@@ -0,0 +1,133 @@
+#ifndef MJPC_CONSOLE_VIEW_H_
+#define MJPC_CONSOLE_VIEW_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mjpc/alert_rules.h"
+#include "mjpc/dashboard_data.h"
+#include "mjpc/seqlock.h"
+
+namespace mjpc {
+
+// ============ 终端屏幕缓冲（差量输出） ============
+// 按显示列保存上一次输出的内容和本次要输出的内容，Flush 只生成变化单元格的
+// ANSI 光标移动和文字。中文等宽字符占两列（第二列为续列）。不支持颜色和组合字符。
+class TerminalScreen {
+public:
+    TerminalScreen(int rows, int cols);
+
+    int Rows() const { return rows_; }
+    int Cols() const { return cols_; }
+
+    // 本帧内容清为空格（不影响上一次输出的内容）
+    void Clear();
+    // 从 (row, col) 写入 UTF-8 文本，超出行尾的部分截断；返回下一列
+    int Put(int row, int col, const char* text);
+    int Printf(int row, int col, const char* format, ...)
+#if defined(__GNUC__)
+        __attribute__((format(printf, 4, 5)))
+#endif
+        ;
+
+    // 把与上一次输出不同的单元格追加为 ANSI 序列（行列从 1 开始的绝对定位），
+    // 并记为已输出。首次调用或 Invalidate 之后清屏并整屏输出。
+    void Flush(std::string* out);
+    // 下次 Flush 整屏重绘（终端内容被其他输出破坏时）
+    void Invalidate() { valid_ = false; }
+
+private:
+    struct Cell {
+        char bytes[4] = {' '};
+        uint8_t length = 1;
+        uint8_t width = 1;           // 0 为宽字符的续列
+        bool operator==(const Cell& other) const {
+            return length == other.length && width == other.width &&
+                   std::memcmp(bytes, other.bytes, length) == 0;
+        }
+        bool operator!=(const Cell& other) const { return !(*this == other); }
+    };
+
+    int rows_;
+    int cols_;
+    bool valid_ = false;
+    std::vector<Cell> shown_;        // 终端上的内容
+    std::vector<Cell> next_;         // 本帧内容
+};
+
+// ============ 终端仪表盘 ============
+// PrintDataToConsole 的无头服务器版本：固定布局的文本界面原地刷新，每次只输出
+// 变化的单元格（通常每帧几十到一两百字节）。仿真线程用 Publish 把快照写入顺序锁，
+// 后台线程按墙钟频率读取最新快照并输出，仿真线程不做格式化和 I/O。
+//   ConsoleView view;
+//   view.Start();                      // 默认输出到 stdout，5 Hz
+//   dashboard.SetConsoleView(&view);   // 替代周期性的 PrintDataToConsole
+struct ConsoleViewOptions {
+    double rate_hz = 5.0;            // 刷新频率（墙钟）
+    FILE* stream = nullptr;          // 空为 stdout
+};
+
+class ConsoleView {
+public:
+    static constexpr int kRows = 11;
+    static constexpr int kCols = 60;
+
+    ConsoleView();
+    ~ConsoleView() { Stop(); }
+    ConsoleView(const ConsoleView&) = delete;
+    ConsoleView& operator=(const ConsoleView&) = delete;
+
+    // 启动后台刷新线程
+    bool Start(const ConsoleViewOptions& options = ConsoleViewOptions());
+    // 停止线程，光标移到界面下方并恢复显示
+    void Stop();
+    bool IsRunning() const { return thread_.joinable(); }
+
+    // 仿真线程调用：写入最新快照（frame 为 0 时按发布次数编号），不阻塞
+    void Publish(const TelemetrySnapshot& snapshot);
+
+    // 快照警报位掩码对应的规则表（默认为 AlertRuleSet::kDefaultRules），
+    // 温度按其中 overheat 规则的活动位标注过热。可在刷新线程运行时调用。
+    void SetAlertRules(const AlertRuleSet& rules) {
+        overheat_bit_.store(rules.Bit(AlertRuleSet::kOverheat), std::memory_order_relaxed);
+    }
+
+    // 同步绘制：排版快照并返回相对上一次 Draw 的差量输出，适合自己有轮询循环的
+    // 程序（例如 telemetry_monitor）；不要与 Start 同时使用。返回的引用在下次 Draw 前有效。
+    const std::string& Draw(const TelemetrySnapshot& snapshot);
+    // 界面结束时的收尾序列（光标移到界面下方并显示）
+    static const char* RestoreSequence();
+
+    uint64_t FramesDrawn() const { return frames_drawn_.load(std::memory_order_relaxed); }
+    uint64_t BytesWritten() const { return bytes_written_.load(std::memory_order_relaxed); }
+
+private:
+    void Layout(const TelemetrySnapshot& snapshot);
+    void Run();
+
+    TerminalScreen screen_;
+    std::string output_;
+    SeqLock<TelemetrySnapshot> latest_;
+    uint64_t published_ = 0;
+
+    ConsoleViewOptions options_;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+
+    std::atomic<AlertMask> overheat_bit_{0};
+    std::atomic<uint64_t> frames_drawn_{0};
+    std::atomic<uint64_t> bytes_written_{0};
+};
+
+}  // namespace mjpc
+
+#endif  // MJPC_CONSOLE_VIEW_H_
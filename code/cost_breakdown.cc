@@ -0,0 +1,100 @@
+#include "mjpc/cost_breakdown.h"
+
+#include <algorithm>
+
+namespace mjpc {
+
+void WeightedSquares(const double* residual, const double* weight, int n, double* out) {
+    for (int i = 0; i < n; i++) {
+        out[i] = weight[i] * residual[i] * residual[i];
+    }
+}
+
+// ============ 建表 ============
+void CostBreakdown::Initialize(const mjModel* m) {
+    if (m == model_) return;
+    model_ = m;
+    terms_.clear();
+    parameters_.clear();
+    ClearHistory();
+    if (!m) return;
+
+    int nuser = m->nuser_sensor;
+    for (int i = 0; i < m->nsensor && NumTerms() < kMaxTerms; i++) {
+        if (m->sensor_type[i] != mjSENS_USER) break;
+        const double* user = m->sensor_user + i * nuser;
+
+        Term term;
+        const char* name = mj_id2name(m, mjOBJ_SENSOR, i);
+        term.name = name ? name : "term_" + std::to_string(i);
+        term.residual_offset = m->sensor_adr[i];
+        term.dim = m->sensor_dim[i];
+        term.norm = nuser > 0 ? static_cast<NormType>(static_cast<int>(user[0])) : kQuadratic;
+        term.weight = nuser > 1 ? user[1] : 1.0;
+        term.parameter_offset = static_cast<int>(parameters_.size());
+        term.num_parameters = NormParameterDimension(term.norm);
+        for (int p = 0; p < term.num_parameters; p++) {
+            parameters_.push_back(4 + p < nuser ? user[4 + p] : 0.0);
+        }
+        terms_.push_back(term);
+    }
+
+    // 残差段 [begin, end)；非二次项的逐元素权重为 0，单独用 Norm 计算
+    quadratic_begin_ = terms_.empty() ? 0 : terms_.front().residual_offset;
+    int end = quadratic_begin_;
+    for (const Term& term : terms_) end = std::max(end, term.residual_offset + term.dim);
+    quadratic_size_ = end - quadratic_begin_;
+    element_weight_.assign(quadratic_size_, 0.0);
+    element_cost_.assign(quadratic_size_, 0.0);
+    for (const Term& term : terms_) {
+        if (term.norm != kQuadratic) continue;
+        for (int j = 0; j < term.dim; j++) {
+            element_weight_[term.residual_offset - quadratic_begin_ + j] = 0.5 * term.weight;
+        }
+    }
+    costs_.assign(terms_.size(), 0.0);
+    total_ = 0.0;
+}
+
+// ============ 计算 ============
+void CostBreakdown::Compute(const mjModel* m, const double* sensordata) {
+    Initialize(m);
+    if (terms_.empty() || !sensordata) return;
+
+    // 二次项（最常见）一次遍历整个残差段
+    WeightedSquares(sensordata + quadratic_begin_, element_weight_.data(), quadratic_size_,
+                    element_cost_.data());
+
+    total_ = 0.0;
+    for (int k = 0; k < NumTerms(); k++) {
+        const Term& term = terms_[k];
+        double cost = 0.0;
+        if (term.norm == kQuadratic) {
+            const double* segment = element_cost_.data() + term.residual_offset - quadratic_begin_;
+            for (int j = 0; j < term.dim; j++) cost += segment[j];
+        } else {
+            cost = term.weight * Norm(nullptr, nullptr, sensordata + term.residual_offset,
+                                      parameters_.data() + term.parameter_offset,
+                                      term.dim, term.norm);
+        }
+        costs_[k] = cost;
+        total_ += cost;
+    }
+}
+
+// ============ 历史 ============
+void CostBreakdown::PushHistory() {
+    float* slot = history_[history_head_];
+    for (int k = 0; k < kMaxTerms; k++) {
+        slot[k] = k < NumTerms() ? static_cast<float>(costs_[k]) : 0.0f;
+    }
+    history_head_ = (history_head_ + 1) % kHistoryLength;
+    history_count_ = std::min(history_count_ + 1, kHistoryLength);
+}
+
+const float* CostBreakdown::HistoryAt(int age) const {
+    int index = (history_head_ - 1 - age + 2 * kHistoryLength) % kHistoryLength;
+    return history_[index];
+}
+
+}  // namespace mjpc
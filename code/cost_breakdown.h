@@ -0,0 +1,74 @@
+#ifndef MJPC_COST_BREAKDOWN_H_
+#define MJPC_COST_BREAKDOWN_H_
+
+#include <mujoco/mujoco.h>
+
+#include <string>
+#include <vector>
+
+#include "mjpc/norm.h"
+
+namespace mjpc {
+
+// ============ 代价分项 ============
+// 任务的残差定义为模型中的 user 传感器（必须排在最前且连续），
+// sensor_user 依次为: 范数类型, 权重, 权重下限, 权重上限, 范数参数...
+// 第 k 项代价 = weight_k * Norm(r_k)，与规划器优化的目标一致。
+class CostBreakdown {
+public:
+    static constexpr int kMaxTerms = 16;
+    static constexpr int kHistoryLength = 120;
+
+    // 按模型建表；模型指针不变时直接返回
+    void Initialize(const mjModel* m);
+
+    // 从 sensordata 计算各项加权代价
+    void Compute(const mjModel* m, const double* sensordata);
+
+    int NumTerms() const { return static_cast<int>(terms_.size()); }
+    const char* TermName(int term) const { return terms_[term].name.c_str(); }
+    double TermCost(int term) const { return costs_[term]; }
+    double TotalCost() const { return total_; }
+
+    // 历史：把当前各项代价压入环形缓冲
+    void PushHistory();
+    int HistoryCount() const { return history_count_; }
+    // age 为 0 表示最新一次
+    const float* HistoryAt(int age) const;
+    void ClearHistory() { history_count_ = 0; history_head_ = 0; }
+
+private:
+    struct Term {
+        std::string name;
+        int residual_offset = 0;   // 在 sensordata 中的地址
+        int dim = 0;
+        NormType norm = kQuadratic;
+        double weight = 0.0;
+        int parameter_offset = 0;
+        int num_parameters = 0;
+    };
+
+    const mjModel* model_ = nullptr;
+    std::vector<Term> terms_;
+    std::vector<double> parameters_;
+
+    // 二次范数项的逐元素权重（0.5 * weight_k），残差段连续存放
+    int quadratic_begin_ = 0;
+    int quadratic_size_ = 0;
+    std::vector<double> element_weight_;
+    std::vector<double> element_cost_;
+
+    std::vector<double> costs_;
+    double total_ = 0.0;
+
+    float history_[kHistoryLength][kMaxTerms] = {};
+    int history_head_ = 0;
+    int history_count_ = 0;
+};
+
+// 逐元素加权平方：out[i] = w[i] * r[i]^2（连续数组，编译器可自动向量化）
+void WeightedSquares(const double* residual, const double* weight, int n, double* out);
+
+}  // namespace mjpc
+
+#endif  // MJPC_COST_BREAKDOWN_H_
@@ -1,12 +1,14 @@
 #include "mjpc/dashboard.h"
-#include <GLFW/glfw3.h>
+#include "mjpc/utilities.h"
 #include <cmath>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <string>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <chrono>
 
 #ifdef __APPLE__
 #include <OpenGL/gl.h>
@@ -20,19 +22,36 @@ namespace mjpc {
 #define M_PI 3.14159265358979323846
 #endif
 
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
+
 // 辅助函数：转换弧度到角度
 inline float RadToDeg(float rad) { return rad * 180.0f / M_PI; }
 // 辅助函数：转换角度到弧度
 inline float DegToRad(float deg) { return deg * M_PI / 180.0f; }
 
+// 辅助函数：把布局坐标（左上角为原点）中 viewport 的源矩形映射到它的窗口像素矩形
+static void ApplyViewport(const DashboardViewport& viewport, int width, int height) {
+    glViewport(viewport.left, viewport.bottom, viewport.width, viewport.height);
+    glScissor(viewport.left, viewport.bottom, viewport.width, viewport.height);
+    bool whole = viewport.source_width <= 0.0f || viewport.source_height <= 0.0f;
+    double left = whole ? 0.0 : viewport.source_x;
+    double top = whole ? 0.0 : viewport.source_y;
+    double right = whole ? width : left + viewport.source_width;
+    double bottom = whole ? height : top + viewport.source_height;
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glOrtho(left, right, bottom, top, -1.0, 1.0);
+    glMatrixMode(GL_MODELVIEW);
+}
+
 // ============ 构造函数和析构函数 ============
 Dashboard::Dashboard() 
     : last_update_time_(0),
       pulse_phase_(0.0f),
       glow_intensity_(0.0f),
       warning_blink_(0.0f),
-      animated_speed_(0.0f),
-      animated_rpm_(0.0f),
       window_width_(800),
       window_height_(600),
       dash_x_(80.0f),      // 向左移动
@@ -48,6 +67,28 @@ Dashboard::Dashboard()
     
     // 设置现代化深色主题
     SetDarkTheme();
+    
+    // 面积估算的顶点缓冲，预留足够容量避免逐帧分配
+    primitive_vertices_.reserve(512);
+    draw_list_.Reserve(512, 4096);
+    
+    // 周期任务，编号与 DashboardTask 一致
+    static const double kDefaultRates[TASK_COUNT] = {
+        RateScheduler::kEveryAdvance,   // motion
+        RateScheduler::kEveryAdvance,   // status
+        2.0,                            // temperature
+        2.0,                            // fuel
+        10.0,                           // trace
+        RateScheduler::kEveryAdvance,   // recorder（另按仿真时间是否推进过滤）
+        10.0,                           // strip_charts
+        10.0,                           // cost
+        0.5,                            // console
+        RateScheduler::kEveryAdvance,   // publish（另按仿真时间是否推进过滤）
+    };
+    for (int i = 0; i < TASK_COUNT; i++) {
+        scheduler_.Add(DashboardTaskName(static_cast<DashboardTask>(i)), kDefaultRates[i]);
+        update_rates_[i] = kDefaultRates[i];
+    }
 }
 
 Dashboard::~Dashboard() = default;
@@ -56,15 +97,16 @@ Dashboard::~Dashboard() = default;
 void Dashboard::Initialize(int width, int height) {
     window_width_ = width;
     window_height_ = height;
-    viewport_width_ = width;
-    viewport_height_ = height;
+    CalculateFollowPosition(nullptr, nullptr);
 }
 
 void Dashboard::SetViewport(int x, int y, int width, int height) {
-    viewport_x_ = x;
-    viewport_y_ = y;
-    viewport_width_ = width;
-    viewport_height_ = height;
+    DashboardViewport viewport;
+    viewport.left = x;
+    viewport.bottom = y;
+    viewport.width = width;
+    viewport.height = height;
+    viewports_.assign(1, viewport);
 }
 
 // ============ 主题设置 ============
@@ -86,53 +128,360 @@ void Dashboard::SetLightTheme() {
     theme_.success = Color(0.2f, 0.8f, 0.2f);     // 绿色
 }
 
+// ============ 混合模式 ============
+void Dashboard::SetAlphaBlend() {
+    if (blend_func_separate_) {
+        // 离屏目标：颜色按 alpha 混合，alpha 通道按 over 累积（结果为预乘 alpha）
+        blend_func_separate_(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    } else {
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+}
+
+// ============ 状态复制 ============
+void Dashboard::CopyStateFrom(const Dashboard& other) {
+    if (&other == this) return;
+    // 只复制 Render 读取的状态。遥测积分器、调度器、记录器/发布器和本帧的
+    // 图元缓冲不复制；GL 资源（辉光纹理、混合函数）属于各自的上下文。
+    // 容器按元素赋值，容量足够时不分配（第一次复制后即为定长）。
+    data_ = other.data_;
+    // 警报名称：复制规则表（定长），data_.alert_rules 指向本实例的副本
+    if (other.data_.alert_rules) {
+        render_alert_rules_ = *other.data_.alert_rules;
+        data_.alert_rules = &render_alert_rules_;
+    }
+    
+    // 画质：级别由主实例的调节器决定，副本不自行调节（调节器只用于调试显示）
+    quality_governor_ = other.quality_governor_;
+    adaptive_quality_ = false;
+    quality_level_ = other.quality_level_;
+    quality_ = other.quality_;
+    glow_texture_size_ = other.glow_texture_size_;
+    primitive_vertex_limit_ = other.primitive_vertex_limit_;
+    memory_budget_ = other.memory_budget_;
+    
+    // 动画和组件
+    pulse_phase_ = other.pulse_phase_;
+    glow_intensity_ = other.glow_intensity_;
+    warning_blink_ = other.warning_blink_;
+    widgets_ = other.widgets_;
+    
+    // 布局
+    window_width_ = other.window_width_;
+    window_height_ = other.window_height_;
+    viewports_.assign(other.viewports_.begin(), other.viewports_.end());
+    dash_x_ = other.dash_x_;
+    dash_y_ = other.dash_y_;
+    dash_width_ = other.dash_width_;
+    dash_height_ = other.dash_height_;
+    scale_ = other.scale_;
+    follow_car_ = other.follow_car_;
+    follow_mode_ = other.follow_mode_;
+    offset_x_ = other.offset_x_;
+    offset_y_ = other.offset_y_;
+    offset_z_ = other.offset_z_;
+    std::copy(other.cam_pos_, other.cam_pos_ + 3, cam_pos_);
+    std::copy(other.cam_forward_, other.cam_forward_ + 3, cam_forward_);
+    std::copy(other.cam_up_, other.cam_up_ + 3, cam_up_);
+    std::copy(other.cam_right_, other.cam_right_ + 3, cam_right_);
+    dark_theme_ = other.dark_theme_;
+    theme_ = other.theme_;
+    debug_overdraw_ = other.debug_overdraw_;
+    debug_overlay_ = other.debug_overlay_;
+    fill_accounting_ = other.fill_accounting_;
+    
+    // 规划器面板
+    planner_stats_ = other.planner_stats_;
+    show_planner_panel_ = other.show_planner_panel_;
+    planner_now_ = other.planner_now_;
+    planner_rollouts_per_sec_ = other.planner_rollouts_per_sec_;
+    planner_utilization_ = other.planner_utilization_;
+    std::copy(other.planner_history_, other.planner_history_ + PlannerStats::kHistoryLength,
+              planner_history_);
+    
+    // 趋势图（列数据已在主实例的 Update 中查询好）
+    show_strip_charts_ = other.show_strip_charts_;
+    strip_chart_window_ = other.strip_chart_window_;
+    strip_chart_channels_.assign(other.strip_chart_channels_.begin(),
+                                 other.strip_chart_channels_.end());
+    strip_chart_count_ = other.strip_chart_count_;
+    strip_chart_column_count_ = other.strip_chart_column_count_;
+    strip_chart_columns_.assign(other.strip_chart_columns_.begin(),
+                                other.strip_chart_columns_.end());
+    
+    // 估计器面板
+    estimated_pose_ = other.estimated_pose_;
+    estimator_valid_ = other.estimator_valid_;
+    estimator_error_ = other.estimator_error_;
+    estimator_error_rms_ = other.estimator_error_rms_;
+    estimator_error_max_ = other.estimator_error_max_;
+    estimator_heading_error_ = other.estimator_heading_error_;
+    estimator_consistency_ = other.estimator_consistency_;
+    
+    // 代价面板（项名和数组只在模型改变时重新分配）
+    cost_breakdown_ = other.cost_breakdown_;
+    show_cost_panel_ = other.show_cost_panel_;
+    
+    // 小地图
+    std::copy(&other.trace_[0][0], &other.trace_[0][0] + 2 * kTraceLength, &trace_[0][0]);
+    trace_head_ = other.trace_head_;
+    trace_count_ = other.trace_count_;
+    std::copy(&other.fleet_markers_[0][0], &other.fleet_markers_[0][0] + 2 * other.fleet_marker_count_,
+              &fleet_markers_[0][0]);
+    fleet_marker_count_ = other.fleet_marker_count_;
+}
+
+// ============ 组件名称 ============
+const char* DashboardWidgetName(DashboardWidget widget) {
+    static const char* const kNames[WIDGET_COUNT] = {
+        "glass", "gradient", "panel", "glow", "speedometer", "tachometer",
+        "digital_speed", "battery", "energy_flow", "autopilot", "navigation",
+        "minimap", "labels", "warning", "planner_panel", "strip_chart", "estimator",
+        "cost", "debug"
+    };
+    if (widget < 0 || widget >= WIDGET_COUNT) return "unknown";
+    return kNames[widget];
+}
+
+// ============ 周期任务 ============
+const char* DashboardTaskName(DashboardTask task) {
+    static const char* const kNames[TASK_COUNT] = {
+        "motion", "status", "temperature", "fuel", "trace", "recorder",
+        "strip_charts", "cost", "console", "publish"
+    };
+    if (task < 0 || task >= TASK_COUNT) return "unknown";
+    return kNames[task];
+}
+
+bool Dashboard::SetUpdateRates(const std::string& spec) {
+    // 先全部解析，确认无误后再应用
+    double rates[TASK_COUNT];
+    bool set[TASK_COUNT] = {};
+    size_t begin = 0;
+    while (begin < spec.size()) {
+        size_t end = spec.find(',', begin);
+        if (end == std::string::npos) end = spec.size();
+        std::string item = spec.substr(begin, end - begin);
+        begin = end + 1;
+        item.erase(0, item.find_first_not_of(" \t"));
+        item.erase(item.find_last_not_of(" \t") + 1);
+        if (item.empty()) continue;
+        
+        size_t equals = item.find('=');
+        if (equals == std::string::npos) return false;
+        std::string name = item.substr(0, equals);
+        const char* value = item.c_str() + equals + 1;
+        char* parsed_end = nullptr;
+        double rate = strtod(value, &parsed_end);
+        if (parsed_end == value || *parsed_end != '\0' || !(rate >= 0.0)) return false;
+        
+        int task = scheduler_.Find(name.c_str());
+        if (task < 0) return false;
+        rates[task] = rate;
+        set[task] = true;
+    }
+    for (int i = 0; i < TASK_COUNT; i++) {
+        if (set[i]) SetUpdateRate(static_cast<DashboardTask>(i), rates[i]);
+    }
+    return true;
+}
+
+void Dashboard::SetUpdateRate(DashboardTask task, double rate_hz) {
+    if (task < 0 || task >= TASK_COUNT) return;
+    update_rates_[task] = rate_hz;
+    ApplyUpdateRate(task);
+}
+
+void Dashboard::ApplyUpdateRate(int task) {
+    // 只有装饰性任务随画质降频；每次 Update 都执行的任务保持不变
+    double rate = update_rates_[task];
+    bool cosmetic = task == TASK_TRACE || task == TASK_STRIP_CHARTS || task == TASK_COST;
+    if (cosmetic && rate > 0.0) rate *= quality_.update_rate_scale;
+    scheduler_.SetRate(task, rate);
+}
+
+// ============ 画质 ============
+void Dashboard::SetAdaptiveQuality(const QualityGovernorOptions& options) {
+    quality_governor_.Configure(options);
+    adaptive_quality_ = true;
+    scene_ms_ = 0.0;
+    ApplyQualityLevel(quality_governor_.Level());
+}
+
+void Dashboard::DisableAdaptiveQuality() {
+    adaptive_quality_ = false;
+    ApplyQualityLevel(0);
+}
+
+void Dashboard::SetQualityLevel(int level) {
+    if (adaptive_quality_) {
+        quality_governor_.SetLevel(level);
+        level = quality_governor_.Level();
+    }
+    ApplyQualityLevel(std::clamp(level, 0, kQualityLevels - 1));
+}
+
+void Dashboard::ApplyQualityLevel(int level) {
+    if (level == quality_level_) return;
+    quality_level_ = level;
+    quality_ = GetQualitySettings(level);
+    ApplyUpdateRate(TASK_TRACE);
+    ApplyUpdateRate(TASK_STRIP_CHARTS);
+    ApplyUpdateRate(TASK_COST);
+    animation_pending_ = 0.0f;
+}
+
+// ============ 图元提交 ============
+// 图元记录到 draw_list_，批次和顶点在回放时统计（见 Render）
+void Dashboard::BeginPrimitive(unsigned int mode) {
+    if (fill_accounting_) {
+        primitive_mode_ = mode;
+        primitive_vertices_.clear();
+    }
+    draw_list_.Begin(mode, draw_state_);
+}
+
+void Dashboard::EmitVertex(float x, float y) {
+    EmitVertex(x, y, 0.0f, 0.0f);
+}
+
+void Dashboard::EmitVertex(float x, float y, float u, float v) {
+    if (local_transform_) {
+        float local_x = x;
+        x = local_origin_[0] + local_rotation_[0] * local_x - local_rotation_[1] * y;
+        y = local_origin_[1] + local_rotation_[1] * local_x + local_rotation_[0] * y;
+    }
+    if (fill_accounting_) RecordPrimitiveVertex(x, y);
+    draw_list_.Vertex(x, y, u, v, draw_color_);
+}
+
+void Dashboard::SetLocalTransform(float x, float y, float angle) {
+    local_transform_ = true;
+    local_origin_[0] = x;
+    local_origin_[1] = y;
+    local_rotation_[0] = cosf(angle);
+    local_rotation_[1] = sinf(angle);
+}
+
+void Dashboard::RecordPrimitiveVertex(float x, float y) {
+    // 超出预算的顶点不参与面积估算；按上限扩容，不依赖 vector 的倍增
+    size_t size = primitive_vertices_.size();
+    if (size + 2 > primitive_vertex_limit_) return;
+    if (size + 2 > primitive_vertices_.capacity()) {
+        primitive_vertices_.reserve(std::min(2 * size + 2, primitive_vertex_limit_));
+    }
+    primitive_vertices_.push_back(x);
+    primitive_vertices_.push_back(y);
+}
+
+void Dashboard::EndPrimitive() {
+    draw_list_.End();
+    if (!fill_accounting_) return;
+    
+    double area = PrimitiveArea();
+    frame_stats_.shaded_pixels += area;
+    frame_stats_.widget_pixels[current_widget_] += area;
+}
+
+// ============ 图元面积估算（屏幕像素） ============
+double Dashboard::PrimitiveArea() const {
+    const float* v = primitive_vertices_.data();
+    int n = static_cast<int>(primitive_vertices_.size() / 2);
+    
+    auto triangle = [v](int a, int b, int c) {
+        return 0.5 * fabs((v[2 * b] - v[2 * a]) * (v[2 * c + 1] - v[2 * a + 1]) -
+                          (v[2 * c] - v[2 * a]) * (v[2 * b + 1] - v[2 * a + 1]));
+    };
+    auto length = [v](int a, int b) {
+        double dx = v[2 * b] - v[2 * a];
+        double dy = v[2 * b + 1] - v[2 * a + 1];
+        return sqrt(dx * dx + dy * dy);
+    };
+    
+    double area = 0.0;
+    switch (primitive_mode_) {
+        case GL_TRIANGLES:
+            for (int i = 0; i + 2 < n; i += 3) area += triangle(i, i + 1, i + 2);
+            break;
+        case GL_TRIANGLE_FAN:
+            for (int i = 1; i + 1 < n; i++) area += triangle(0, i, i + 1);
+            break;
+        case GL_TRIANGLE_STRIP:
+            for (int i = 0; i + 2 < n; i++) area += triangle(i, i + 1, i + 2);
+            break;
+        case GL_QUADS:
+            for (int i = 0; i + 3 < n; i += 4) {
+                area += triangle(i, i + 1, i + 2) + triangle(i, i + 2, i + 3);
+            }
+            break;
+        case GL_LINES:
+        case GL_LINE_STRIP:
+        case GL_LINE_LOOP: {
+            // 线段按 长度 × 线宽 估算
+            float line_width = draw_state_.line_width;
+            int step = (primitive_mode_ == GL_LINES) ? 2 : 1;
+            for (int i = 0; i + 1 < n; i += step) area += length(i, i + 1) * line_width;
+            if (primitive_mode_ == GL_LINE_LOOP && n > 2) area += length(n - 1, 0) * line_width;
+            break;
+        }
+        case GL_POINTS: {
+            float point_size = draw_state_.point_size;
+            area = n * point_size * point_size;
+            break;
+        }
+        default:
+            break;
+    }
+    return area;
+}
+
 // ============ 基础绘制函数 ============
 void Dashboard::DrawGradientRect(float x, float y, float width, float height,
                                 const Color& c1, const Color& c2, bool horizontal) {
-    glBegin(GL_QUADS);
+    BeginPrimitive(GL_QUADS);
     
     if (horizontal) {
         // 水平渐变
-        glColor4f(c1.r, c1.g, c1.b, c1.a);
-        glVertex2f(x, y);
-        glVertex2f(x, y + height);
+        SetColor(c1.r, c1.g, c1.b, c1.a);
+        EmitVertex(x, y);
+        EmitVertex(x, y + height);
         
-        glColor4f(c2.r, c2.g, c2.b, c2.a);
-        glVertex2f(x + width, y + height);
-        glVertex2f(x + width, y);
+        SetColor(c2.r, c2.g, c2.b, c2.a);
+        EmitVertex(x + width, y + height);
+        EmitVertex(x + width, y);
     } else {
         // 垂直渐变
-        glColor4f(c1.r, c1.g, c1.b, c1.a);
-        glVertex2f(x, y + height);
-        glVertex2f(x + width, y + height);
+        SetColor(c1.r, c1.g, c1.b, c1.a);
+        EmitVertex(x, y + height);
+        EmitVertex(x + width, y + height);
         
-        glColor4f(c2.r, c2.g, c2.b, c2.a);
-        glVertex2f(x + width, y);
-        glVertex2f(x, y);
+        SetColor(c2.r, c2.g, c2.b, c2.a);
+        EmitVertex(x + width, y);
+        EmitVertex(x, y);
     }
     
-    glEnd();
+    EndPrimitive();
 }
 
 void Dashboard::DrawRoundedRect(float x, float y, float width, float height,
                                float radius, const Color& color) {
     // 简化实现：绘制矩形加圆角
-    glColor4f(color.r, color.g, color.b, color.a);
+    SetColor(color.r, color.g, color.b, color.a);
     
     // 绘制中心矩形
-    glBegin(GL_QUADS);
-    glVertex2f(x + radius, y);
-    glVertex2f(x + width - radius, y);
-    glVertex2f(x + width - radius, y + height);
-    glVertex2f(x + radius, y + height);
-    glEnd();
-    
-    glBegin(GL_QUADS);
-    glVertex2f(x, y + radius);
-    glVertex2f(x + width, y + radius);
-    glVertex2f(x + width, y + height - radius);
-    glVertex2f(x, y + height - radius);
-    glEnd();
+    BeginPrimitive(GL_QUADS);
+    EmitVertex(x + radius, y);
+    EmitVertex(x + width - radius, y);
+    EmitVertex(x + width - radius, y + height);
+    EmitVertex(x + radius, y + height);
+    EndPrimitive();
+    
+    BeginPrimitive(GL_QUADS);
+    EmitVertex(x, y + radius);
+    EmitVertex(x + width, y + radius);
+    EmitVertex(x + width, y + height - radius);
+    EmitVertex(x, y + height - radius);
+    EndPrimitive();
     
     // 绘制四个圆角
     DrawCircle(x + radius, y + radius, radius, color);
@@ -142,24 +491,24 @@ void Dashboard::DrawRoundedRect(float x, float y, float width, float height,
 }
 
 void Dashboard::DrawCircle(float cx, float cy, float radius, const Color& color) {
-    glColor4f(color.r, color.g, color.b, color.a);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex2f(cx, cy);
+    SetColor(color.r, color.g, color.b, color.a);
+    BeginPrimitive(GL_TRIANGLE_FAN);
+    EmitVertex(cx, cy);
     
-    const int segments = 32;
+    const int segments = quality_.circle_segments;
     for (int i = 0; i <= segments; i++) {
         float angle = 2.0f * M_PI * i / segments;
-        glVertex2f(cx + radius * cosf(angle), cy + radius * sinf(angle));
+        EmitVertex(cx + radius * cosf(angle), cy + radius * sinf(angle));
     }
-    glEnd();
+    EndPrimitive();
 }
 
 void Dashboard::DrawRing(float cx, float cy, float inner_radius, float outer_radius,
                         float start_angle, float end_angle, const Color& color) {
-    glColor4f(color.r, color.g, color.b, color.a);
+    SetColor(color.r, color.g, color.b, color.a);
     
-    const int segments = 32;
-    glBegin(GL_TRIANGLE_STRIP);
+    const int segments = quality_.circle_segments;
+    BeginPrimitive(GL_TRIANGLE_STRIP);
     
     for (int i = 0; i <= segments; i++) {
         float t = static_cast<float>(i) / segments;
@@ -167,10 +516,10 @@ void Dashboard::DrawRing(float cx, float cy, float inner_radius, float outer_rad
         float cos_angle = cosf(angle);
         float sin_angle = sinf(angle);
         
-        glVertex2f(cx + inner_radius * cos_angle, cy + inner_radius * sin_angle);
-        glVertex2f(cx + outer_radius * cos_angle, cy + outer_radius * sin_angle);
+        EmitVertex(cx + inner_radius * cos_angle, cy + inner_radius * sin_angle);
+        EmitVertex(cx + outer_radius * cos_angle, cy + outer_radius * sin_angle);
     }
-    glEnd();
+    EndPrimitive();
 }
 
 void Dashboard::DrawArc(float cx, float cy, float radius, float start_angle, 
@@ -182,9 +531,10 @@ void Dashboard::DrawArc(float cx, float cy, float radius, float start_angle,
 
 // ============ 现代化效果函数 ============
 void Dashboard::DrawGlassEffect(float x, float y, float width, float height) {
+    SetWidget(WIDGET_GLASS);
+    
     // 玻璃模糊效果
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    SetBlend(true);
     
     // 基础玻璃色
     Color glass_color(1.0f, 1.0f, 1.0f, 0.1f);
@@ -194,22 +544,134 @@ void Dashboard::DrawGlassEffect(float x, float y, float width, float height) {
     Color highlight_color(1.0f, 1.0f, 1.0f, 0.2f);
     DrawRoundedRect(x + 5, y + 5, width - 10, 20, 8.0f, highlight_color);
     
-    glDisable(GL_BLEND);
+    SetBlend(false);
 }
 
 void Dashboard::DrawNeonGlow(float x, float y, float radius, const Color& color, float intensity) {
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    if (!quality_.glow) return;
+    // 单个贴图四边形：预计算的径向衰减纹理 × 颜色，替代三层叠加的整圆
+    if (glow_texture_ == 0 || glow_texture_built_size_ != glow_texture_size_) CreateGlowTexture();
+    DashboardWidget owner = current_widget_;
+    SetWidget(WIDGET_GLOW);
+    
+    // 外层半径与峰值不透明度与原三层效果一致
+    float outer_radius = radius * (1.0f + kGlowLayerGrowth[0] * intensity);
+    float transmit = 1.0f;
+    for (int i = 0; i < kGlowLayers; i++) {
+        transmit *= 1.0f - color.a * intensity * kGlowLayerAlpha[i];
+    }
+    float peak_alpha = 1.0f - transmit;
+    
+    SetBlend(true);
+    SetTexture(glow_texture_);
+    
+    SetColor(color.r, color.g, color.b, peak_alpha);
+    BeginPrimitive(GL_QUADS);
+    EmitVertex(x - outer_radius, y - outer_radius, 0.0f, 0.0f);
+    EmitVertex(x + outer_radius, y - outer_radius, 1.0f, 0.0f);
+    EmitVertex(x + outer_radius, y + outer_radius, 1.0f, 1.0f);
+    EmitVertex(x - outer_radius, y + outer_radius, 0.0f, 1.0f);
+    EndPrimitive();
+    
+    SetTexture(0);
+    SetBlend(false);
+    SetWidget(owner);
+}
+
+// ============ 辉光纹理 ============
+void Dashboard::CreateGlowTexture() {
+    // 以标称强度下三层圆的叠加结果为轮廓，4x4 超采样抗锯齿，
+    // 归一化到中心为 1；边缘纹素为 0，保证四边形角落完全透明
+    // 边长由纹理预算决定（不超过 kGlowTextureSize）
+    const int size = glow_texture_size_;
+    unsigned char pixels[kGlowTextureSize * kGlowTextureSize];
+    const float nominal = kGlowNominalIntensity;
+    const float outer = 1.0f + kGlowLayerGrowth[0] * nominal;
+    const int samples = 4;
+    
+    auto coverage = [&](float rho) {
+        float transmit = 1.0f;
+        for (int i = 0; i < kGlowLayers; i++) {
+            if (rho <= 1.0f + kGlowLayerGrowth[i] * nominal) {
+                transmit *= 1.0f - nominal * kGlowLayerAlpha[i];
+            }
+        }
+        return 1.0f - transmit;
+    };
+    float center = coverage(0.0f);
+    
+    for (int j = 0; j < size; j++) {
+        for (int i = 0; i < size; i++) {
+            float sum = 0.0f;
+            for (int sj = 0; sj < samples; sj++) {
+                for (int si = 0; si < samples; si++) {
+                    float u = (i + (si + 0.5f) / samples) / size * 2.0f - 1.0f;
+                    float v = (j + (sj + 0.5f) / samples) / size * 2.0f - 1.0f;
+                    sum += coverage(sqrtf(u * u + v * v) * outer);
+                }
+            }
+            float value = sum / (samples * samples) / center;
+            pixels[j * size + i] = static_cast<unsigned char>(
+                std::min(value, 1.0f) * 255.0f + 0.5f);
+        }
+    }
+    
+    if (glow_texture_ == 0) glGenTextures(1, &glow_texture_);
+    glow_texture_built_size_ = size;
+    glBindTexture(GL_TEXTURE_2D, glow_texture_);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, size, size, 0,
+                 GL_ALPHA, GL_UNSIGNED_BYTE, pixels);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Dashboard::ReleaseGLResources() {
+    if (glow_texture_ != 0) {
+        glDeleteTextures(1, &glow_texture_);
+        glow_texture_ = 0;
+        glow_texture_built_size_ = 0;
+    }
+}
+
+// ============ 内存统计 ============
+MemoryUsage Dashboard::GetMemoryUsage() const {
+    MemoryUsage usage;
+    usage.bytes[MEMORY_VERTEX_BUFFERS] =
+        draw_list_.MemoryBytes() + primitive_vertices_.capacity() * sizeof(float);
+    usage.bytes[MEMORY_HISTORY] =
+        kFixedHistoryBytes + strip_chart_columns_.capacity() * sizeof(TelemetryPyramid::Column);
+    // 辉光纹理为单通道 8 位
+    usage.bytes[MEMORY_TEXTURES] =
+        static_cast<size_t>(glow_texture_built_size_) * glow_texture_built_size_;
+    usage.bytes[MEMORY_RECORDER] = recorder_ ? recorder_->MemoryBytes() : 0;
+    return usage;
+}
+
+void Dashboard::SetMemoryBudget(const MemoryBudget& budget) {
+    memory_budget_ = budget;
+    
+    // 顶点暂存：容量超出时释放，之后按上限扩容（绘制列表是渲染必需的，不受限制）
+    primitive_vertex_limit_ = budget.Limited(MEMORY_VERTEX_BUFFERS)
+        ? budget.cap[MEMORY_VERTEX_BUFFERS] / sizeof(float) : SIZE_MAX;
+    if (primitive_vertices_.capacity() > primitive_vertex_limit_) {
+        std::vector<float>().swap(primitive_vertices_);
+    }
     
-    // 多层发光效果
-    for (int i = 0; i < 3; i++) {
-        float glow_radius = radius * (1.0f + intensity * 0.3f * (3 - i));
-        float alpha = color.a * intensity * 0.2f * (3 - i) / 3.0f;
-        Color glow_color(color.r, color.g, color.b, alpha);
-        DrawCircle(x, y, glow_radius, glow_color);
+    // 辉光纹理：不超过上限的最大边长（减半），下一次绘制时重建
+    glow_texture_size_ = kGlowTextureSize;
+    if (budget.Limited(MEMORY_TEXTURES)) {
+        while (glow_texture_size_ > kGlowTextureMinSize &&
+               static_cast<size_t>(glow_texture_size_) * glow_texture_size_ >
+                   budget.cap[MEMORY_TEXTURES]) {
+            glow_texture_size_ /= 2;
+        }
     }
     
-    glDisable(GL_BLEND);
+    // 历史与记录器在下一次 Update 时按预算降采样/淘汰
 }
 
 // ============ 数字和文本绘制 ============
@@ -230,111 +692,126 @@ void Dashboard::DrawDigitSevenSegment(float x, float y, int digit, float size, c
     
     if (digit < 0 || digit > 9) return;
     
-    glColor4f(color.r, color.g, color.b, color.a);
-    glLineWidth(size * 0.2f);
+    SetColor(color.r, color.g, color.b, color.a);
+    SetLineWidth(size * 0.2f);
     
     // 段a（上横线）
     if (segments[digit][0]) {
-        glBegin(GL_LINES);
-        glVertex2f(x + size * 0.2f, y);
-        glVertex2f(x + size * 0.8f, y);
-        glEnd();
+        BeginPrimitive(GL_LINES);
+        EmitVertex(x + size * 0.2f, y);
+        EmitVertex(x + size * 0.8f, y);
+        EndPrimitive();
     }
     
     // 段b（右上竖线）
     if (segments[digit][1]) {
-        glBegin(GL_LINES);
-        glVertex2f(x + size * 0.8f, y);
-        glVertex2f(x + size * 0.8f, y + size * 0.5f);
-        glEnd();
+        BeginPrimitive(GL_LINES);
+        EmitVertex(x + size * 0.8f, y);
+        EmitVertex(x + size * 0.8f, y + size * 0.5f);
+        EndPrimitive();
     }
     
     // 段c（右下竖线）
     if (segments[digit][2]) {
-        glBegin(GL_LINES);
-        glVertex2f(x + size * 0.8f, y + size * 0.5f);
-        glVertex2f(x + size * 0.8f, y + size);
-        glEnd();
+        BeginPrimitive(GL_LINES);
+        EmitVertex(x + size * 0.8f, y + size * 0.5f);
+        EmitVertex(x + size * 0.8f, y + size);
+        EndPrimitive();
     }
     
     // 段d（下横线）
     if (segments[digit][3]) {
-        glBegin(GL_LINES);
-        glVertex2f(x + size * 0.2f, y + size);
-        glVertex2f(x + size * 0.8f, y + size);
-        glEnd();
+        BeginPrimitive(GL_LINES);
+        EmitVertex(x + size * 0.2f, y + size);
+        EmitVertex(x + size * 0.8f, y + size);
+        EndPrimitive();
     }
     
     // 段e（左下竖线）
     if (segments[digit][4]) {
-        glBegin(GL_LINES);
-        glVertex2f(x + size * 0.2f, y + size * 0.5f);
-        glVertex2f(x + size * 0.2f, y + size);
-        glEnd();
+        BeginPrimitive(GL_LINES);
+        EmitVertex(x + size * 0.2f, y + size * 0.5f);
+        EmitVertex(x + size * 0.2f, y + size);
+        EndPrimitive();
     }
     
     // 段f（左上竖线）
     if (segments[digit][5]) {
-        glBegin(GL_LINES);
-        glVertex2f(x + size * 0.2f, y);
-        glVertex2f(x + size * 0.2f, y + size * 0.5f);
-        glEnd();
+        BeginPrimitive(GL_LINES);
+        EmitVertex(x + size * 0.2f, y);
+        EmitVertex(x + size * 0.2f, y + size * 0.5f);
+        EndPrimitive();
     }
     
     // 段g（中横线）
     if (segments[digit][6]) {
-        glBegin(GL_LINES);
-        glVertex2f(x + size * 0.2f, y + size * 0.5f);
-        glVertex2f(x + size * 0.8f, y + size * 0.5f);
-        glEnd();
+        BeginPrimitive(GL_LINES);
+        EmitVertex(x + size * 0.2f, y + size * 0.5f);
+        EmitVertex(x + size * 0.8f, y + size * 0.5f);
+        EndPrimitive();
     }
     
-    glLineWidth(1.0f);
+    SetLineWidth(1.0f);
 }
 
 void Dashboard::DrawDigitalNumber(float x, float y, int number, float size, const Color& color) {
-    std::string num_str = std::to_string(number);
+    char num_str[16];
+    const char* end = std::to_chars(num_str, num_str + sizeof(num_str), number).ptr;
     float digit_width = size * 0.6f;
     float spacing = size * 0.1f;
-    float total_width = num_str.length() * (digit_width + spacing);
+    float total_width = (end - num_str) * (digit_width + spacing);
     
     float current_x = x - total_width * 0.5f;
-    for (char c : num_str) {
-        if (c >= '0' && c <= '9') {
-            int digit = c - '0';
+    for (const char* c = num_str; c < end; c++) {
+        if (*c >= '0' && *c <= '9') {
+            int digit = *c - '0';
             DrawDigitSevenSegment(current_x, y, digit, size, color);
         }
         current_x += digit_width + spacing;
     }
 }
 
-void Dashboard::DrawText(float x, float y, const std::string& text, float size, const Color& color) {
+void Dashboard::DrawText(float x, float y, const char* text, float size, const Color& color) {
     // 简化文本绘制（实际项目中应使用字体库）
-    glColor4f(color.r, color.g, color.b, color.a);
-    glPointSize(size * 0.5f);
-    glBegin(GL_POINTS);
+    SetColor(color.r, color.g, color.b, color.a);
+    SetPointSize(size * 0.5f);
+    BeginPrimitive(GL_POINTS);
     
     // 模拟字母绘制
-    for (size_t i = 0; i < text.length(); i++) {
+    for (size_t i = 0; text[i] != '\0'; i++) {
         char c = text[i];
         if (c != ' ') {
             // 简单的位置计算
             for (int j = 0; j < 3; j++) {
-                glVertex2f(x + i * size * 0.6f + (j * size * 0.1f), 
+                EmitVertex(x + i * size * 0.6f + (j * size * 0.1f), 
                           y + (j * size * 0.1f));
             }
         }
     }
-    glEnd();
-    glPointSize(1.0f);
+    EndPrimitive();
+    SetPointSize(1.0f);
 }
 
-// ============ 平滑动画函数 ============
-float Dashboard::SmoothValue(float current, float target, float smoothing) {
-    return current + (target - current) * smoothing;
+void Dashboard::DrawLabel(float x, float y, const char* text, float size, WidgetLabelStyle style) {
+    SetWidget(WIDGET_LABELS);
+    switch (style) {
+        case LABEL_PRIMARY: DrawText(x, y, text, size, theme_.primary); break;
+        case LABEL_WARNING: DrawText(x, y, text, size, theme_.warning); break;
+        case LABEL_VALUE: DrawText(x, y, text, size, Color::White(0.9f)); break;
+        case LABEL_CAPTION: DrawText(x, y, text, size, Color::LightGray(0.9f)); break;
+    }
 }
 
+// ============ 平滑动画函数 ============
 void Dashboard::UpdateAnimation(float delta_time) {
+    // 降画质时按较低频率更新，累积的时间一次推进
+    if (quality_.animation_rate_hz > 0.0) {
+        animation_pending_ += delta_time;
+        if (animation_pending_ < 1.0f / quality_.animation_rate_hz) return;
+        delta_time = animation_pending_;
+        animation_pending_ = 0.0f;
+    }
+    
     // 更新脉动相位（用于霓虹灯效果）
     pulse_phase_ += delta_time * 2.0f;
     if (pulse_phase_ > 2.0f * M_PI) {
@@ -354,29 +831,52 @@ void Dashboard::UpdateAnimation(float delta_time) {
         warning_blink_ = 0.0f;
     }
     
-    // 平滑速度动画
-    animated_speed_ = SmoothValue(animated_speed_, data_.speed_kmh, 0.1f);
-    animated_rpm_ = SmoothValue(animated_rpm_, data_.rpm, 0.1f);
+    // 各组件的动画（表盘指针平滑等）
+    widgets_.Update(data_, delta_time);
 }
 
 // ============ 数据更新函数 ============
 void Dashboard::Update(const mjModel* m, const mjData* d) {
     if (!m || !d) return;
     
-    // 获取当前时间
-    double current_time = glfwGetTime();
-    float delta_time = 0.0f;
-    if (last_update_time_ > 0) {
-        delta_time = static_cast<float>(current_time - last_update_time_);
+    // ============ 周期任务（按仿真时间调度，时间回退时全部立即执行） ============
+    uint32_t due = scheduler_.Advance(d->time);
+    auto run = [due](DashboardTask task) { return RateScheduler::Due(due, task); };
+    
+    // ============ 遥测积分（按仿真时间推进，不依赖墙钟） ============
+    uint32_t groups = 0;
+    if (run(TASK_MOTION)) groups |= TELEMETRY_MOTION;
+    if (run(TASK_STATUS)) groups |= TELEMETRY_STATUS;
+    if (run(TASK_TEMPERATURE)) groups |= TELEMETRY_TEMPERATURE;
+    if (run(TASK_FUEL)) groups |= TELEMETRY_ENERGY;
+    float delta_time = static_cast<float>(telemetry_.Step(m, d, &data_, groups));
+    if (recorder_ && d->time != last_update_time_ && run(TASK_RECORDER)) {
+        recorder_->Record(d->time, data_);
+        if (memory_budget_.Limited(MEMORY_RECORDER)) {
+            recorder_->Trim(memory_budget_.cap[MEMORY_RECORDER]);
+        }
     }
-    // 定期输出到终端（每2秒一次）
-    static double last_print_time = 0.0;
-    if (current_time - last_print_time > 2.0) {  // 每2秒输出一次
-        PrintDataToConsole();
-        last_print_time = current_time;
+    if ((publisher_ || broadcaster_ || console_view_) && d->time != last_update_time_ &&
+        run(TASK_PUBLISH)) {
+        if (publisher_ || console_view_) {
+            TelemetrySnapshot snapshot;
+            FillTelemetrySnapshot(data_, d->time, 0, &snapshot);
+            if (publisher_) publisher_->Publish(snapshot);
+            if (console_view_) console_view_->Publish(snapshot);
+        }
+        if (broadcaster_) broadcaster_->Publish(d->time, data_);
     }
-
-    last_update_time_ = current_time;
+    if (run(TASK_STRIP_CHARTS)) UpdateStripCharts();
+    if (d->time < last_update_time_) {
+        // 仿真被重置
+        ResetEstimatorStats();
+        cost_breakdown_.ClearHistory();
+        trace_count_ = 0;
+    }
+    last_update_time_ = d->time;
+    
+    // 定期输出到终端（终端界面自行刷新）
+    if (run(TASK_CONSOLE) && !console_view_) PrintDataToConsole();
 
     // ============ 计算车辆位置和方向 ============
 
@@ -389,90 +889,147 @@ void Dashboard::Update(const mjModel* m, const mjData* d) {
 
     CalculateFollowPosition(m, d);
     
-    // ============ 更新车辆数据 ============
-    
-    // 获取车身ID（假设为第一个body）
-    int car_body_id = 0;
-    if (m->nbody > 1) {
-        // 查找名为"car"或"chassis"的body
-        for (int i = 0; i < m->nbody; i++) {
-            const char* name = mj_id2name(m, mjOBJ_BODY, i);
-            if (name && (strstr(name, "car") || strstr(name, "chassis") || strstr(name, "body"))) {
-                car_body_id = i;
-                break;
-            }
-        }
-    }
-    
-    // 获取位置
-    int qpos_adr = m->body_dofadr[car_body_id];
-    if (qpos_adr + 2 < m->nq) {
-        data_.car_x = d->qpos[qpos_adr];
-        data_.car_y = d->qpos[qpos_adr + 1];
-        data_.car_z = d->qpos[qpos_adr + 2];
-    }
-    
-    // 获取速度
-    int qvel_adr = m->body_dofadr[car_body_id];
-    if (qvel_adr + 2 < m->nv) {
-        double vx = d->qvel[qvel_adr];
-        double vy = d->qvel[qvel_adr + 1];
-        data_.speed_ms = sqrt(vx * vx + vy * vy);
-        data_.speed_kmh = data_.speed_ms * 3.6f;
-    }
-    
-    // ============ 模拟其他数据 ============
-    
-    // 模拟转速（基于速度）
-    data_.rpm = 800.0f + data_.speed_kmh * 60.0f;
-    if (data_.rpm > data_.max_rpm) data_.rpm = data_.max_rpm;
-    if (data_.rpm < 800.0f) data_.rpm = 800.0f;
-    
-    // 模拟油量消耗
-    static double fuel_level = 100.0;
-    fuel_level -= 0.001f * (1.0f + data_.speed_kmh / 100.0f);
-    if (fuel_level < 0.0f) fuel_level = 100.0f;
-    data_.fuel = fuel_level;
-    
-    // 模拟温度
-    data_.temperature = 60.0f + (data_.rpm / data_.max_rpm) * 40.0f;
-    
-    // 模拟档位
-    if (data_.speed_kmh < 5.0f) data_.gear = 1;
-    else if (data_.speed_kmh < 15.0f) data_.gear = 2;
-    else if (data_.speed_kmh < 30.0f) data_.gear = 3;
-    else if (data_.speed_kmh < 50.0f) data_.gear = 4;
-    else if (data_.speed_kmh < 80.0f) data_.gear = 5;
-    else data_.gear = 6;
+    // 规划器性能统计
+    UpdatePlannerStats(m);
     
-    // 模拟控制输入
-    data_.throttle = 0.5f + 0.3f * sinf(static_cast<float>(d->time));
-    data_.brake = 0.2f + 0.1f * cosf(static_cast<float>(d->time));
-    data_.steering = 0.1f * sinf(2.0f * static_cast<float>(d->time));
+    // 估计器 vs 真值
+    UpdateEstimatorStats(m, d);
     
-    // 模拟自动驾驶状态
-    data_.autopilot = (static_cast<int>(d->time) % 10) < 5;
-    data_.mode = data_.autopilot ? "AUTO" : "MANUAL";
+    // 小地图轨迹和其余车辆
+    if (run(TASK_TRACE)) PushTracePoint();
+    if (run(TASK_MOTION)) UpdateFleetMarkers();
     
-    // 模拟警告（速度过快或温度过高）
-    data_.warning = (data_.speed_kmh > 120.0f) || (data_.temperature > 90.0f);
+    // 代价分项（user 传感器中的残差）
+    if (run(TASK_COST)) {
+        cost_breakdown_.Compute(m, d->sensordata);
+        if (cost_breakdown_.NumTerms() > 0) cost_breakdown_.PushHistory();
+    }
     
-    // 模拟电池电量
-    static double battery = 95.0;
-    battery -= 0.0005f * (1.0f + data_.speed_kmh / 80.0f);
-    if (battery < 20.0f) battery = 95.0f;
-    data_.battery_level = battery;
+    // 更新动画
+    UpdateAnimation(delta_time);
+}
+
+// ============ 小地图轨迹和其余车辆 ============
+void Dashboard::PushTracePoint() {
+    trace_[trace_head_][0] = static_cast<float>(data_.car_x);
+    trace_[trace_head_][1] = static_cast<float>(data_.car_y);
+    trace_head_ = (trace_head_ + 1) % kTraceLength;
+    trace_count_ = std::min(trace_count_ + 1, kTraceLength);
+}
+
+void Dashboard::UpdateFleetMarkers() {
+    fleet_marker_count_ = 0;
+    if (!fleet_) return;
+    const double* fleet_x = fleet_->X();
+    const double* fleet_y = fleet_->Y();
+    for (int i = 0; i < fleet_->NumVehicles() && fleet_marker_count_ < kMaxFleetMarkers; i++) {
+        if (fleet_->BodyId(i) == telemetry_.CarBodyId()) continue;
+        fleet_markers_[fleet_marker_count_][0] = static_cast<float>(fleet_x[i]);
+        fleet_markers_[fleet_marker_count_][1] = static_cast<float>(fleet_y[i]);
+        fleet_marker_count_++;
+    }
+}
+
+// ============ 规划器性能统计 ============
+void Dashboard::UpdatePlannerStats(const mjModel* m) {
+    if (!planner_stats_) return;
+    
+    // 模型变化时重新读取控制周期
+    if (m != planner_model_) {
+        planner_stats_->SetDeadline(GetNumberOrDefault(0.02, m, "agent_timestep"));
+        planner_model_ = m;
+    }
     
-    // 模拟行程距离
-    static double trip = 0.0;
-    trip += data_.speed_ms * delta_time / 1000.0;  // 转换为km
-    data_.trip_distance = trip;
+    // 速率在 0.5 秒窗口内计算，避免逐帧抖动
+    planner_stats_->Read(&planner_now_);
+    double window = planner_now_.wall_time - planner_prev_.wall_time;
+    if (planner_prev_.wall_time <= 0.0) {
+        planner_prev_ = planner_now_;
+    } else if (window >= 0.5) {
+        planner_rollouts_per_sec_ = static_cast<float>(
+            (planner_now_.rollouts - planner_prev_.rollouts) / window);
+        
+        double capacity = window * std::max(planner_now_.num_workers, 1) * 1.0e9;
+        planner_utilization_ = static_cast<float>(
+            (planner_now_.busy_ns - planner_prev_.busy_ns) / capacity);
+        planner_utilization_ = std::max(0.0f, std::min(planner_utilization_, 1.0f));
+        
+        planner_prev_ = planner_now_;
+    }
+}
+
+// ============ 估计器误差统计 ============
+void Dashboard::ResetEstimatorStats() {
+    estimator_valid_ = false;
+    estimator_error_ = 0.0f;
+    estimator_error_rms_ = 0.0f;
+    estimator_error_max_ = 0.0f;
+    estimator_heading_error_ = 0.0f;
+    estimator_consistency_ = 0.0f;
+    for (EstimatorErrorBin& bin : estimator_bins_) bin = EstimatorErrorBin();
+    estimator_bin_ = -1;
+}
+
+void Dashboard::UpdateEstimatorStats(const mjModel* m, const mjData* d) {
+    // 直接读估计器缓冲区中的几个元素，不复制整个状态
+    const int car_body = telemetry_.CarBodyId();
+    estimator_valid_ = ReadEstimatedPose(estimator_view_, m, car_body, &estimated_pose_);
+    if (!estimator_valid_) return;
+    
+    // 真值按同一个 qpos 地址从 d->qpos 读取（data_ 中的位置按 TASK_MOTION 频率刷新）
+    EstimatorView truth_view;
+    truth_view.state = d->qpos;
+    EstimatedPose truth;
+    if (!ReadEstimatedPose(truth_view, m, car_body, &truth)) {
+        estimator_valid_ = false;
+        return;
+    }
     
-    // 模拟时间
-    data_.time_of_day = fmod(d->time / 60.0, 24.0);  // 24小时制
+    double dx = estimated_pose_.x - truth.x;
+    double dy = estimated_pose_.y - truth.y;
+    double error_sq = dx * dx + dy * dy;
+    estimator_error_ = static_cast<float>(sqrt(error_sq));
+    estimator_heading_error_ = static_cast<float>(
+        atan2(sin(estimated_pose_.heading - truth.heading),
+              cos(estimated_pose_.heading - truth.heading)));
+    
+    // 真值是否落在 2-sigma 椭圆内（马氏距离平方 < 4）
+    bool inside = false;
+    if (estimated_pose_.has_covariance) {
+        double a = estimated_pose_.cov_xx, b = estimated_pose_.cov_xy, c = estimated_pose_.cov_yy;
+        double det = a * c - b * b;
+        if (det > 0.0) {
+            double mahalanobis_sq = (c * dx * dx - 2.0 * b * dx * dy + a * dy * dy) / det;
+            inside = mahalanobis_sq < 4.0;
+        }
+    }
     
-    // 更新动画
-    UpdateAnimation(delta_time);
+    // 滑动窗口：进入新箱时清空中间跳过的箱（最多整个窗口）
+    const double bin_duration = kEstimatorErrorWindow / kEstimatorErrorBins;
+    int64_t bin = static_cast<int64_t>(floor(std::max(d->time, 0.0) / bin_duration));
+    if (estimator_bin_ < 0 || bin > estimator_bin_) {
+        int64_t first = estimator_bin_ < 0
+            ? bin : std::max(estimator_bin_ + 1, bin - kEstimatorErrorBins + 1);
+        for (int64_t b = first; b <= bin; b++) {
+            estimator_bins_[b % kEstimatorErrorBins] = EstimatorErrorBin();
+        }
+        estimator_bin_ = bin;
+    }
+    EstimatorErrorBin& current = estimator_bins_[estimator_bin_ % kEstimatorErrorBins];
+    current.error_sq += error_sq;
+    current.samples++;
+    current.inside += inside ? 1 : 0;
+    
+    double window_error_sq = 0.0;
+    int window_samples = 0, window_inside = 0;
+    for (const EstimatorErrorBin& b : estimator_bins_) {
+        window_error_sq += b.error_sq;
+        window_samples += b.samples;
+        window_inside += b.inside;
+    }
+    estimator_error_rms_ = static_cast<float>(sqrt(window_error_sq / window_samples));
+    estimator_consistency_ = static_cast<float>(window_inside) / window_samples;
+    estimator_error_max_ = std::max(estimator_error_max_, estimator_error_);
 }
 
 // ============ 计算跟随位置 ============
@@ -482,6 +1039,24 @@ void Dashboard::CalculateFollowPosition(const mjModel* m, const mjData* d) {
     dash_width_ = 700.0f * scale_;
     dash_height_ = 400.0f * scale_;
     
+    // 3D 跟随：仪表盘底边中点对准小车上方偏移点的投影
+    if (follow_mode_ == FOLLOW_CAR_3D) {
+        float c = cosf(static_cast<float>(data_.car_heading));
+        float s = sinf(static_cast<float>(data_.car_heading));
+        float anchor_x = static_cast<float>(data_.car_x) + offset_x_ * c - offset_y_ * s;
+        float anchor_y = static_cast<float>(data_.car_y) + offset_x_ * s + offset_y_ * c;
+        float anchor_z = static_cast<float>(data_.car_z) + offset_z_;
+        float screen_x, screen_y;
+        if (Project3DTo2D(anchor_x, anchor_y, anchor_z, screen_x, screen_y)) {
+            dash_x_ = screen_x - 0.5f * dash_width_;
+            dash_y_ = screen_y - dash_height_;
+            dash_x_ = std::max(30.0f, std::min(dash_x_, window_width_ - dash_width_ - 30.0f));
+            dash_y_ = std::max(50.0f, std::min(dash_y_, window_height_ - dash_height_ - 30.0f));
+            return;
+        }
+        // 投影点在屏幕外（或摄像机后方）时退回下面的 HUD 位置
+    }
+    
     // 向左移动，避免右边被挡住
     float left_margin = 50.0f * scale_;  // 离左边的距离
     dash_x_ = left_margin+500.0f;
@@ -502,6 +1077,8 @@ void Dashboard::CalculateFollowPosition(const mjModel* m, const mjData* d) {
 
 // ============ 现代化转速表绘制函数（简化版，无刻度点） ============
 void Dashboard::DrawModernTachometer(float x, float y, float radius, float rpm, float max_rpm) {
+    SetWidget(WIDGET_TACHOMETER);
+    
     // 霓虹光环效果
     float glow = 0.5f + 0.3f * sinf(pulse_phase_);
     Color rpm_glow_color(1.0f, 0.3f, 0.1f, 0.7f);  // 橙色/红色辉光
@@ -532,17 +1109,17 @@ void Dashboard::DrawModernTachometer(float x, float y, float radius, float rpm,
     float pointer_angle = DegToRad(-120.0f + rpm_angle);  // 指针角度
     
     // 指针主体 - 红色
-    glColor4f(1.0f, 0.2f, 0.1f, 0.9f);  // 红色指针
-    glLineWidth(3.0f);
+    SetColor(1.0f, 0.2f, 0.1f, 0.9f);  // 红色指针
+    SetLineWidth(3.0f);
     
     float pointer_length = radius * 0.7f;
     float pointer_tip_x = x + pointer_length * cosf(pointer_angle);
     float pointer_tip_y = y + pointer_length * sinf(pointer_angle);
     
-    glBegin(GL_LINES);
-    glVertex2f(x, y);  // 指针中心
-    glVertex2f(pointer_tip_x, pointer_tip_y);  // 指针尖端
-    glEnd();
+    BeginPrimitive(GL_LINES);
+    EmitVertex(x, y);  // 指针中心
+    EmitVertex(pointer_tip_x, pointer_tip_y);  // 指针尖端
+    EndPrimitive();
     
     // 指针尖端装饰
     DrawCircle(pointer_tip_x, pointer_tip_y, 3.0f, Color(1.0f, 0.1f, 0.05f, 1.0f));
@@ -551,7 +1128,7 @@ void Dashboard::DrawModernTachometer(float x, float y, float radius, float rpm,
     DrawCircle(x, y, 5.0f, Color(0.1f, 0.1f, 0.1f, 0.9f));
     DrawCircle(x, y, 3.0f, Color(0.8f, 0.2f, 0.1f, 0.9f));
     
-    glLineWidth(1.0f);
+    SetLineWidth(1.0f);
     
     // ============ 中心显示数字转速 ============
     DrawDigitalNumber(x, y - 15, static_cast<int>(rpm), 12.0f, Color::White());
@@ -580,6 +1157,8 @@ void Dashboard::DrawModernTachometer(float x, float y, float radius, float rpm,
 
 // ============ 现代化速度表组件（带蓝色指针） ============
 void Dashboard::DrawModernSpeedometer(float x, float y, float radius, float speed) {
+    SetWidget(WIDGET_SPEEDOMETER);
+    
     // 霓虹光环
     float glow = 0.5f + 0.3f * sinf(pulse_phase_);
     DrawNeonGlow(x, y, radius * 1.1f, theme_.primary, glow);
@@ -607,17 +1186,17 @@ void Dashboard::DrawModernSpeedometer(float x, float y, float radius, float spee
     float pointer_angle = DegToRad(-120.0f + speed_angle);  // 指针角度
     
     // 指针主体 - 蓝色
-    glColor4f(theme_.primary.r, theme_.primary.g, theme_.primary.b, 0.9f);  // 蓝色指针
-    glLineWidth(3.0f);
+    SetColor(theme_.primary.r, theme_.primary.g, theme_.primary.b, 0.9f);  // 蓝色指针
+    SetLineWidth(3.0f);
     
     float pointer_length = radius * 0.7f;
     float pointer_tip_x = x + pointer_length * cosf(pointer_angle);
     float pointer_tip_y = y + pointer_length * sinf(pointer_angle);
     
-    glBegin(GL_LINES);
-    glVertex2f(x, y);  // 指针中心
-    glVertex2f(pointer_tip_x, pointer_tip_y);  // 指针尖端
-    glEnd();
+    BeginPrimitive(GL_LINES);
+    EmitVertex(x, y);  // 指针中心
+    EmitVertex(pointer_tip_x, pointer_tip_y);  // 指针尖端
+    EndPrimitive();
     
     // 指针尖端装饰
     DrawCircle(pointer_tip_x, pointer_tip_y, 3.0f, Color(theme_.primary.r, theme_.primary.g, theme_.primary.b, 1.0f));
@@ -626,7 +1205,7 @@ void Dashboard::DrawModernSpeedometer(float x, float y, float radius, float spee
     DrawCircle(x, y, 5.0f, Color(0.1f, 0.1f, 0.1f, 0.9f));
     DrawCircle(x, y, 3.0f, Color(theme_.primary.r, theme_.primary.g, theme_.primary.b, 0.9f));
     
-    glLineWidth(1.0f);
+    SetLineWidth(1.0f);
     
     // 中心数字速度显示
     DrawDigitalNumber(x, y - 10, static_cast<int>(speed), 15.0f, Color::White());
@@ -636,6 +1215,8 @@ void Dashboard::DrawModernSpeedometer(float x, float y, float radius, float spee
 }
 
 void Dashboard::DrawDigitalSpeed(float x, float y, float size, float speed) {
+    SetWidget(WIDGET_DIGITAL_SPEED);
+    
     // 数字速度显示（特斯拉风格）
     Color bg_color(0.0f, 0.0f, 0.0f, 0.7f);
     DrawRoundedRect(x - size * 0.8f, y - size * 0.3f, 
@@ -651,6 +1232,8 @@ void Dashboard::DrawDigitalSpeed(float x, float y, float size, float speed) {
 }
 
 void Dashboard::DrawBatteryIndicator(float x, float y, float width, float height, float level) {
+    SetWidget(WIDGET_BATTERY);
+    
     // 电池外框
     Color border_color(0.5f, 0.5f, 0.5f, 0.8f);
     DrawRoundedRect(x, y, width, height, 3.0f, border_color);
@@ -673,12 +1256,14 @@ void Dashboard::DrawBatteryIndicator(float x, float y, float width, float height
     DrawRoundedRect(x + 2, y + 2, fill_width, height - 4, 2.0f, battery_color);
     
     // 电量百分比
-    std::string percent = std::to_string(static_cast<int>(level)) + "%";
+    char percent[16];
     DrawText(x + width * 0.5f - 10.0f, y + height * 0.5f - 4.0f, 
-             percent, 8.0f, Color::White(0.9f));
+             FormatInt(percent, "", static_cast<int>(level), "%"), 8.0f, Color::White(0.9f));
 }
 
 void Dashboard::DrawEnergyFlow(float x, float y, float size, float throttle, float regen) {
+    SetWidget(WIDGET_ENERGY_FLOW);
+    
     // 能量流图示（电动/混合动力汽车）
     float center_x = x;
     float center_y = y;
@@ -714,6 +1299,8 @@ void Dashboard::DrawEnergyFlow(float x, float y, float size, float throttle, flo
 }
 
 void Dashboard::DrawAutopilotIndicator(float x, float y, float size, bool active) {
+    SetWidget(WIDGET_AUTOPILOT);
+    
     // 自动驾驶指示器
     Color bg_color = active ? theme_.success : Color(0.3f, 0.3f, 0.3f, 0.8f);
     
@@ -726,16 +1313,18 @@ void Dashboard::DrawAutopilotIndicator(float x, float y, float size, bool active
     DrawCircle(x, y, size * 0.5f, bg_color);
     
     // 图标
-    std::string icon = active ? "A" : "M";
+    const char* icon = active ? "A" : "M";
     Color icon_color = active ? Color::Black() : Color::White(0.8f);
     DrawText(x - size * 0.15f, y - size * 0.2f, icon, size * 0.4f, icon_color);
     
     // 标签
-    std::string label = active ? "AUTO" : "MANUAL";
+    const char* label = active ? "AUTO" : "MANUAL";
     DrawText(x - size * 0.5f, y + size * 0.6f, label, size * 0.3f, Color::White(0.8f));
 }
 
 void Dashboard::DrawNavigationBar(float x, float y, float width, float height, float heading) {
+    SetWidget(WIDGET_NAVIGATION);
+    
     // 导航方向条
     Color bg_color(0.0f, 0.0f, 0.0f, 0.7f);
     DrawRoundedRect(x, y, width, height, 5.0f, bg_color);
@@ -744,8 +1333,8 @@ void Dashboard::DrawNavigationBar(float x, float y, float width, float height, f
     float center_x = x + width * 0.5f;
     float center_y = y + height * 0.5f;
     
-    glColor4f(1.0f, 1.0f, 1.0f, 0.6f);
-    glLineWidth(1.0f);
+    SetColor(1.0f, 1.0f, 1.0f, 0.6f);
+    SetLineWidth(1.0f);
     
     // 绘制方向刻度
     for (int angle = 0; angle < 360; angle += 30) {
@@ -761,7 +1350,7 @@ void Dashboard::DrawNavigationBar(float x, float y, float width, float height, f
             outer_radius = height * 0.45f;
             
             // 方向标签
-            std::string direction;
+            const char* direction = "";
             switch (angle) {
                 case 0: direction = "N"; break;
                 case 90: direction = "E"; break;
@@ -774,52 +1363,92 @@ void Dashboard::DrawNavigationBar(float x, float y, float width, float height, f
             DrawText(label_x, label_y, direction, 8.0f, Color::White(0.9f));
         }
         
-        glBegin(GL_LINES);
-        glVertex2f(center_x + inner_radius * cos_angle, 
+        BeginPrimitive(GL_LINES);
+        EmitVertex(center_x + inner_radius * cos_angle, 
                    center_y + inner_radius * sin_angle);
-        glVertex2f(center_x + outer_radius * cos_angle,
+        EmitVertex(center_x + outer_radius * cos_angle,
                    center_y + outer_radius * sin_angle);
-        glEnd();
+        EndPrimitive();
     }
     
     // 当前方向指示器
-    glColor4f(theme_.primary.r, theme_.primary.g, theme_.primary.b, 0.8f);
-    glLineWidth(2.0f);
+    SetColor(theme_.primary.r, theme_.primary.g, theme_.primary.b, 0.8f);
+    SetLineWidth(2.0f);
     
-    glBegin(GL_TRIANGLES);
-    glVertex2f(center_x, center_y - height * 0.25f);
-    glVertex2f(center_x - 5.0f, center_y - height * 0.4f);
-    glVertex2f(center_x + 5.0f, center_y - height * 0.4f);
-    glEnd();
+    BeginPrimitive(GL_TRIANGLES);
+    EmitVertex(center_x, center_y - height * 0.25f);
+    EmitVertex(center_x - 5.0f, center_y - height * 0.4f);
+    EmitVertex(center_x + 5.0f, center_y - height * 0.4f);
+    EndPrimitive();
     
-    glLineWidth(1.0f);
+    SetLineWidth(1.0f);
 }
 
 void Dashboard::DrawMinimap(float x, float y, float radius, float car_x, float car_y, float heading) {
+    SetWidget(WIDGET_MINIMAP);
+    
     // 小地图（简化版）
     Color bg_color(0.0f, 0.0f, 0.0f, 0.7f);
     DrawCircle(x, y, radius, bg_color);
     
     // 地图网格
-    glColor4f(1.0f, 1.0f, 1.0f, 0.2f);
-    glLineWidth(1.0f);
+    SetColor(1.0f, 1.0f, 1.0f, 0.2f);
+    SetLineWidth(1.0f);
     
     for (int i = -2; i <= 2; i++) {
         // 水平线
-        glBegin(GL_LINES);
-        glVertex2f(x - radius, y + i * radius * 0.4f);
-        glVertex2f(x + radius, y + i * radius * 0.4f);
-        glEnd();
+        BeginPrimitive(GL_LINES);
+        EmitVertex(x - radius, y + i * radius * 0.4f);
+        EmitVertex(x + radius, y + i * radius * 0.4f);
+        EndPrimitive();
         
         // 垂直线
-        glBegin(GL_LINES);
-        glVertex2f(x + i * radius * 0.4f, y - radius);
-        glVertex2f(x + i * radius * 0.4f, y + radius);
-        glEnd();
+        BeginPrimitive(GL_LINES);
+        EmitVertex(x + i * radius * 0.4f, y - radius);
+        EmitVertex(x + i * radius * 0.4f, y + radius);
+        EndPrimitive();
     }
     
     // 车辆位置（在小地图中）
     float map_scale = radius * 0.05f;
+    
+    // 历史轨迹（由旧到新），超出范围的点收到边缘；降画质时每 trace_stride 个采样取一点，
+    // 保留最新的采样
+    if (trace_count_ >= 2) {
+        Color trace_color = theme_.primary;
+        SetColor(trace_color.r, trace_color.g, trace_color.b, 0.5f);
+        SetLineWidth(1.5f);
+        BeginPrimitive(GL_LINE_STRIP);
+        const int stride = quality_.trace_stride;
+        for (int age = (trace_count_ - 1) / stride * stride; age >= 0; age -= stride) {
+            const float* point = trace_[(trace_head_ - 1 - age + kTraceLength) % kTraceLength];
+            float trace_dx = point[0] * map_scale;
+            float trace_dy = point[1] * map_scale;
+            float trace_dist = sqrtf(trace_dx * trace_dx + trace_dy * trace_dy);
+            if (trace_dist > radius * 0.8f) {
+                trace_dx *= radius * 0.8f / trace_dist;
+                trace_dy *= radius * 0.8f / trace_dist;
+            }
+            EmitVertex(x + trace_dx, y + trace_dy);
+        }
+        EndPrimitive();
+        SetLineWidth(1.0f);
+    }
+    
+    // 其余车辆（范围外的不画）
+    if (fleet_marker_count_ > 0) {
+        SetColor(theme_.secondary.r, theme_.secondary.g, theme_.secondary.b, 0.8f);
+        SetPointSize(3.0f);
+        BeginPrimitive(GL_POINTS);
+        for (int i = 0; i < fleet_marker_count_; i++) {
+            float marker_dx = fleet_markers_[i][0] * map_scale;
+            float marker_dy = fleet_markers_[i][1] * map_scale;
+            if (marker_dx * marker_dx + marker_dy * marker_dy > radius * radius * 0.64f) continue;
+            EmitVertex(x + marker_dx, y + marker_dy);
+        }
+        EndPrimitive();
+        SetPointSize(1.0f);
+    }
     float car_map_x = x + car_x * map_scale;
     float car_map_y = y + car_y * map_scale;
     
@@ -834,39 +1463,565 @@ void Dashboard::DrawMinimap(float x, float y, float radius, float car_x, float c
     }
     
     // 绘制车辆图标
-    glPushMatrix();
-    glTranslatef(car_map_x, car_map_y, 0.0f);
-    glRotatef(RadToDeg(heading), 0.0f, 0.0f, 1.0f);
+    SetLocalTransform(car_map_x, car_map_y, heading);
     
     Color car_color = theme_.primary;
     car_color.a = 0.9f;
     
     // 三角形表示车辆
-    glColor4f(car_color.r, car_color.g, car_color.b, car_color.a);
-    glBegin(GL_TRIANGLES);
-    glVertex2f(0.0f, -radius * 0.1f);
-    glVertex2f(-radius * 0.05f, radius * 0.05f);
-    glVertex2f(radius * 0.05f, radius * 0.05f);
-    glEnd();
-    
-    glPopMatrix();
+    SetColor(car_color.r, car_color.g, car_color.b, car_color.a);
+    BeginPrimitive(GL_TRIANGLES);
+    EmitVertex(0.0f, -radius * 0.1f);
+    EmitVertex(-radius * 0.05f, radius * 0.05f);
+    EmitVertex(radius * 0.05f, radius * 0.05f);
+    EndPrimitive();
+    
+    ClearLocalTransform();
+    
+    // 估计位姿（空心三角形）和 2-sigma 位置椭圆
+    if (estimator_valid_) {
+        float est_map_x = x + static_cast<float>(estimated_pose_.x) * map_scale;
+        float est_map_y = y + static_cast<float>(estimated_pose_.y) * map_scale;
+        float est_dx = est_map_x - x;
+        float est_dy = est_map_y - y;
+        float est_dist = sqrtf(est_dx * est_dx + est_dy * est_dy);
+        if (est_dist > radius * 0.8f) {
+            est_map_x = x + est_dx * radius * 0.8f / est_dist;
+            est_map_y = y + est_dy * radius * 0.8f / est_dist;
+        }
+        
+        Color est_color = theme_.accent;
+        if (estimated_pose_.has_covariance) {
+            double major, minor, angle;
+            CovarianceEllipse(estimated_pose_.cov_xx, estimated_pose_.cov_xy,
+                              estimated_pose_.cov_yy, 2.0, &major, &minor, &angle);
+            float a = std::min(static_cast<float>(major) * map_scale, radius);
+            float b = std::min(static_cast<float>(minor) * map_scale, radius);
+            float ca = cosf(static_cast<float>(angle));
+            float sa = sinf(static_cast<float>(angle));
+            SetColor(est_color.r, est_color.g, est_color.b, 0.6f);
+            BeginPrimitive(GL_LINE_LOOP);
+            const int ellipse_segments = 24;
+            for (int i = 0; i < ellipse_segments; i++) {
+                float t = 2.0f * M_PI * i / ellipse_segments;
+                float ex = a * cosf(t);
+                float ey = b * sinf(t);
+                EmitVertex(est_map_x + ca * ex - sa * ey, est_map_y + sa * ex + ca * ey);
+            }
+            EndPrimitive();
+        }
+        
+        SetLocalTransform(est_map_x, est_map_y, static_cast<float>(estimated_pose_.heading));
+        SetColor(est_color.r, est_color.g, est_color.b, 0.9f);
+        BeginPrimitive(GL_LINE_LOOP);
+        EmitVertex(0.0f, -radius * 0.1f);
+        EmitVertex(-radius * 0.05f, radius * 0.05f);
+        EmitVertex(radius * 0.05f, radius * 0.05f);
+        EndPrimitive();
+        ClearLocalTransform();
+    }
     
     // 小地图边界
-    glColor4f(theme_.primary.r, theme_.primary.g, theme_.primary.b, 0.5f);
-    glLineWidth(2.0f);
+    SetColor(theme_.primary.r, theme_.primary.g, theme_.primary.b, 0.5f);
+    SetLineWidth(2.0f);
     
-    glBegin(GL_LINE_LOOP);
-    const int segments = 32;
+    BeginPrimitive(GL_LINE_LOOP);
+    const int segments = quality_.circle_segments;
     for (int i = 0; i < segments; i++) {
         float angle = 2.0f * M_PI * i / segments;
-        glVertex2f(x + radius * cosf(angle), y + radius * sinf(angle));
+        EmitVertex(x + radius * cosf(angle), y + radius * sinf(angle));
+    }
+    EndPrimitive();
+    SetLineWidth(1.0f);
+}
+
+// ============ 规划器/线程池性能面板 ============
+void Dashboard::DrawPlannerPanel(float x, float y, float width, float height) {
+    if (!planner_stats_) return;
+    SetWidget(WIDGET_PLANNER_PANEL);
+    
+    Color bg_color(0.0f, 0.0f, 0.0f, 0.7f);
+    DrawRoundedRect(x, y, width, height, 8.0f, bg_color);
+    
+    float padding = 10.0f * scale_;
+    float row = 18.0f * scale_;
+    float label_x = x + padding;
+    float value_x = x + width - padding - 40.0f * scale_;
+    float current_y = y + padding;
+    
+    double deadline = planner_stats_->Deadline();
+    bool late = planner_now_.last_plan_time > deadline;
+    
+    // 规划耗时 (us)，超过控制周期时标红
+    DrawText(label_x, current_y, "PLAN us", 8.0f, Color::LightGray(0.9f));
+    DrawDigitalNumber(value_x, current_y, 
+                      static_cast<int>(planner_now_.last_plan_time * 1.0e6),
+                      10.0f, late ? theme_.warning : theme_.primary);
+    current_y += row;
+    
+    // rollout 吞吐
+    DrawText(label_x, current_y, "ROLLOUT/s", 8.0f, Color::LightGray(0.9f));
+    DrawDigitalNumber(value_x, current_y, static_cast<int>(planner_rollouts_per_sec_),
+                      10.0f, Color::White());
+    current_y += row;
+    
+    // 策略更新延迟 (us)
+    DrawText(label_x, current_y, "POLICY us", 8.0f, Color::LightGray(0.9f));
+    DrawDigitalNumber(value_x, current_y,
+                      static_cast<int>(planner_now_.last_policy_latency * 1.0e6),
+                      10.0f, Color::White());
+    current_y += row;
+    
+    // 线程池队列深度
+    DrawText(label_x, current_y, "QUEUE", 8.0f, Color::LightGray(0.9f));
+    DrawDigitalNumber(value_x, current_y, planner_now_.queue_depth, 10.0f, Color::White());
+    current_y += row;
+    
+    // 超时次数
+    DrawText(label_x, current_y, "MISSED", 8.0f, Color::LightGray(0.9f));
+    DrawDigitalNumber(value_x, current_y, static_cast<int>(planner_now_.missed_deadlines),
+                      10.0f, planner_now_.missed_deadlines > 0 ? theme_.warning : Color::White());
+    current_y += row;
+    
+    // 工作线程利用率
+    float bar_width = width - 2.0f * padding;
+    float bar_height = 6.0f * scale_;
+    DrawRoundedRect(label_x, current_y, bar_width, bar_height, 2.0f, Color(0.3f, 0.3f, 0.3f, 0.8f));
+    Color util_color = planner_utilization_ > 0.9f ? theme_.warning : theme_.success;
+    DrawRoundedRect(label_x, current_y, bar_width * planner_utilization_, bar_height, 2.0f, util_color);
+    current_y += bar_height + padding;
+    
+    // ============ 规划耗时直方图（横轴：0 到 2 倍 agent_timestep） ============
+    float hist_height = y + height - padding - current_y;
+    if (hist_height <= 0.0f || deadline <= 0.0) return;
+    
+    int count = planner_stats_->CopyHistory(planner_history_, PlannerStats::kHistoryLength);
+    int bins[kPlannerHistogramBins] = {0};
+    int max_bin = 1;
+    for (int i = 0; i < count; i++) {
+        int bin = static_cast<int>(planner_history_[i] / (2.0 * deadline) * kPlannerHistogramBins);
+        bin = std::max(0, std::min(bin, kPlannerHistogramBins - 1));
+        bins[bin]++;
+        max_bin = std::max(max_bin, bins[bin]);
+    }
+    
+    float bin_width = bar_width / kPlannerHistogramBins;
+    for (int i = 0; i < kPlannerHistogramBins; i++) {
+        if (bins[i] == 0) continue;
+        float h = hist_height * bins[i] / max_bin;
+        // 右半部分超过控制周期
+        Color bin_color = (i >= kPlannerHistogramBins / 2) ? theme_.warning : theme_.primary;
+        SetColor(bin_color.r, bin_color.g, bin_color.b, 0.8f);
+        BeginPrimitive(GL_QUADS);
+        EmitVertex(label_x + i * bin_width + 1.0f, current_y + hist_height);
+        EmitVertex(label_x + (i + 1) * bin_width - 1.0f, current_y + hist_height);
+        EmitVertex(label_x + (i + 1) * bin_width - 1.0f, current_y + hist_height - h);
+        EmitVertex(label_x + i * bin_width + 1.0f, current_y + hist_height - h);
+        EndPrimitive();
+    }
+    
+    // 控制周期标线
+    float deadline_x = label_x + bar_width * 0.5f;
+    SetColor(1.0f, 1.0f, 1.0f, 0.8f);
+    SetLineWidth(1.0f);
+    BeginPrimitive(GL_LINES);
+    EmitVertex(deadline_x, current_y);
+    EmitVertex(deadline_x, current_y + hist_height);
+    EndPrimitive();
+}
+
+// ============ 估计器误差面板 ============
+void Dashboard::DrawEstimatorPanel(float x, float y, float width, float height) {
+    if (!estimator_valid_) return;
+    SetWidget(WIDGET_ESTIMATOR);
+    
+    Color bg_color(0.0f, 0.0f, 0.0f, 0.7f);
+    DrawRoundedRect(x, y, width, height, 8.0f, bg_color);
+    
+    float padding = 10.0f * scale_;
+    float row = 18.0f * scale_;
+    float label_x = x + padding;
+    float value_x = x + width - padding - 40.0f * scale_;
+    float current_y = y + padding;
+    
+    // 2-sigma 半长轴 (mm)
+    int sigma_mm = 0;
+    if (estimated_pose_.has_covariance) {
+        double major, minor, angle;
+        CovarianceEllipse(estimated_pose_.cov_xx, estimated_pose_.cov_xy,
+                          estimated_pose_.cov_yy, 2.0, &major, &minor, &angle);
+        sigma_mm = static_cast<int>(major * 1000.0);
+    }
+    // 误差超出 2-sigma 时标红
+    bool outside = estimated_pose_.has_covariance && estimator_error_ * 1000.0f > sigma_mm;
+    
+    DrawText(label_x, current_y, "ERR mm", 8.0f, Color::LightGray(0.9f));
+    DrawDigitalNumber(value_x, current_y, static_cast<int>(estimator_error_ * 1000.0f),
+                      10.0f, outside ? theme_.warning : theme_.primary);
+    current_y += row;
+    
+    DrawText(label_x, current_y, "RMS mm", 8.0f, Color::LightGray(0.9f));
+    DrawDigitalNumber(value_x, current_y, static_cast<int>(estimator_error_rms_ * 1000.0f),
+                      10.0f, Color::White());
+    current_y += row;
+    
+    DrawText(label_x, current_y, "MAX mm", 8.0f, Color::LightGray(0.9f));
+    DrawDigitalNumber(value_x, current_y, static_cast<int>(estimator_error_max_ * 1000.0f),
+                      10.0f, Color::White());
+    current_y += row;
+    
+    DrawText(label_x, current_y, "YAW mdeg", 8.0f, Color::LightGray(0.9f));
+    DrawDigitalNumber(value_x, current_y,
+                      static_cast<int>(fabsf(RadToDeg(estimator_heading_error_)) * 1000.0f),
+                      10.0f, Color::White());
+    current_y += row;
+    
+    DrawText(label_x, current_y, "2SIG mm", 8.0f, Color::LightGray(0.9f));
+    DrawDigitalNumber(value_x, current_y, sigma_mm, 10.0f, Color::White());
+    current_y += row;
+    
+    // 一致性：真值落在 2-sigma 椭圆内的比例，理想约 86%
+    float bar_width = width - 2.0f * padding;
+    float bar_height = 6.0f * scale_;
+    if (current_y + bar_height > y + height) return;
+    DrawRoundedRect(label_x, current_y, bar_width, bar_height, 2.0f, Color(0.3f, 0.3f, 0.3f, 0.8f));
+    Color consistency_color = estimator_consistency_ < 0.5f ? theme_.warning : theme_.success;
+    DrawRoundedRect(label_x, current_y, bar_width * estimator_consistency_, bar_height, 2.0f,
+                    consistency_color);
+}
+
+// ============ 代价分项面板 ============
+namespace {
+
+Color CostTermColor(int term) {
+    static const Color kPalette[] = {
+        Color(0.0f, 0.8f, 1.0f), Color(1.0f, 0.6f, 0.0f), Color(0.3f, 1.0f, 0.4f),
+        Color(1.0f, 0.3f, 0.6f), Color(0.7f, 0.5f, 1.0f), Color(1.0f, 1.0f, 0.3f)
+    };
+    return kPalette[term % 6];
+}
+
+}  // namespace
+
+void Dashboard::DrawCostPanel(float x, float y, float width, float height) {
+    int num_terms = cost_breakdown_.NumTerms();
+    if (num_terms == 0) return;
+    SetWidget(WIDGET_COST);
+    
+    Color bg_color(0.0f, 0.0f, 0.0f, 0.7f);
+    DrawRoundedRect(x, y, width, height, 8.0f, bg_color);
+    
+    float padding = 10.0f * scale_;
+    float row = 14.0f * scale_;
+    float label_x = x + padding;
+    float bar_x = x + width * 0.5f;
+    float bar_width = x + width - padding - bar_x;
+    float bar_height = 6.0f * scale_;
+    float current_y = y + padding;
+    
+    // 总代价
+    DrawText(label_x, current_y, "COST", 8.0f, Color::LightGray(0.9f));
+    DrawDigitalNumber(x + width - padding - 40.0f * scale_, current_y,
+                      static_cast<int>(cost_breakdown_.TotalCost()), 10.0f, theme_.primary);
+    current_y += row + 4.0f * scale_;
+    
+    // 各项条形，长度按当前最大项归一化
+    double max_cost = 1.0e-9;
+    for (int k = 0; k < num_terms; k++) {
+        max_cost = std::max(max_cost, cost_breakdown_.TermCost(k));
+    }
+    for (int k = 0; k < num_terms; k++) {
+        Color color = CostTermColor(k);
+        DrawText(label_x, current_y, cost_breakdown_.TermName(k), 6.0f, Color::LightGray(0.8f));
+        DrawRoundedRect(bar_x, current_y, bar_width, bar_height, 2.0f, Color(0.3f, 0.3f, 0.3f, 0.8f));
+        float ratio = static_cast<float>(cost_breakdown_.TermCost(k) / max_cost);
+        DrawRoundedRect(bar_x, current_y, std::max(bar_width * ratio, 1.0f), bar_height, 2.0f, color);
+        current_y += row;
+    }
+    
+    // ============ 堆叠历史（最新在右侧，纵轴按历史最大总代价归一化） ============
+    float hist_height = y + height - padding - current_y;
+    int count = cost_breakdown_.HistoryCount();
+    if (hist_height <= 0.0f || count == 0) return;
+    
+    float max_total = 1.0e-9f;
+    for (int age = 0; age < count; age++) {
+        const float* sample = cost_breakdown_.HistoryAt(age);
+        float total = 0.0f;
+        for (int k = 0; k < num_terms; k++) total += sample[k];
+        max_total = std::max(max_total, total);
+    }
+    
+    float hist_width = width - 2.0f * padding;
+    float column_width = hist_width / CostBreakdown::kHistoryLength;
+    float base_y = current_y + hist_height;
+    for (int k = 0; k < num_terms; k++) {
+        Color color = CostTermColor(k);
+        SetColor(color.r, color.g, color.b, 0.8f);
+        BeginPrimitive(GL_QUADS);
+        for (int age = 0; age < count; age++) {
+            const float* sample = cost_breakdown_.HistoryAt(age);
+            float below = 0.0f;
+            for (int j = 0; j < k; j++) below += sample[j];
+            float top = below + sample[k];
+            float x1 = label_x + hist_width - age * column_width;
+            float x0 = x1 - column_width;
+            float y0 = base_y - hist_height * below / max_total;
+            float y1 = base_y - hist_height * top / max_total;
+            EmitVertex(x0, y0);
+            EmitVertex(x1, y0);
+            EmitVertex(x1, y1);
+            EmitVertex(x0, y1);
+        }
+        EndPrimitive();
+    }
+}
+
+// ============ 遥测趋势图 ============
+void Dashboard::UpdateStripCharts() {
+    strip_chart_count_ = 0;
+    if (!recorder_ || !show_strip_charts_) return;
+    
+    const TelemetryPyramid& pyramid = recorder_->Pyramid();
+    double t_first, t_last;
+    if (!pyramid.TimeRange(&t_first, &t_last)) return;
+    
+    // 每个像素列一个桶，查询量与记录时长无关；列数与 Render 中的图宽一致
+    strip_chart_count_ = std::min(static_cast<int>(strip_chart_channels_.size()), kMaxStripCharts);
+    if (strip_chart_count_ == 0) return;
+    float plot_width = (220.0f - 12.0f) * scale_;
+    int columns = std::min(static_cast<int>(plot_width), kStripChartMaxColumns);
+    columns /= quality_.strip_chart_divisor;
+    
+    // 历史预算不足时降低列数（每列覆盖更长时间）
+    size_t available = SIZE_MAX;
+    if (memory_budget_.Limited(MEMORY_HISTORY)) {
+        size_t cap = memory_budget_.cap[MEMORY_HISTORY];
+        available = cap > kFixedHistoryBytes ? cap - kFixedHistoryBytes : 0;
+        size_t affordable = available / (strip_chart_count_ * sizeof(TelemetryPyramid::Column));
+        columns = static_cast<int>(std::min(static_cast<size_t>(columns), affordable));
+    }
+    strip_chart_column_count_ = std::max(2, columns);
+    strip_chart_columns_.resize(static_cast<size_t>(strip_chart_count_) * strip_chart_column_count_);
+    if (strip_chart_columns_.capacity() * sizeof(TelemetryPyramid::Column) > available) {
+        strip_chart_columns_.shrink_to_fit();
+    }
+    
+    for (int i = 0; i < strip_chart_count_; i++) {
+        pyramid.Query(strip_chart_channels_[i], t_last - strip_chart_window_, t_last,
+                      strip_chart_column_count_,
+                      strip_chart_columns_.data() + i * strip_chart_column_count_);
+    }
+}
+
+void Dashboard::DrawStripChart(float x, float y, float width, float height, int chart,
+                               const Color& color) {
+    if (chart < 0 || chart >= strip_chart_count_) return;
+    SetWidget(WIDGET_STRIP_CHART);
+    
+    Color bg_color(0.0f, 0.0f, 0.0f, 0.6f);
+    DrawRoundedRect(x, y, width, height, 6.0f, bg_color);
+    
+    float padding = 6.0f * scale_;
+    DrawText(x + padding, y + padding, TelemetryChannelName(strip_chart_channels_[chart]),
+             6.0f, Color::LightGray(0.9f));
+    
+    float plot_x = x + padding;
+    float plot_y = y + 2.0f * padding + 6.0f;
+    float plot_width = width - 2.0f * padding;
+    float plot_height = y + height - padding - plot_y;
+    int columns = strip_chart_column_count_;
+    if (plot_height <= 0.0f) return;
+    const TelemetryPyramid::Column* chart_columns =
+        strip_chart_columns_.data() + chart * strip_chart_column_count_;
+    
+    // 纵轴范围取可见数据的 min/max
+    float lo = 0.0f, hi = 0.0f;
+    bool any = false;
+    for (int i = 0; i < columns; i++) {
+        const TelemetryPyramid::Column& column = chart_columns[i];
+        if (column.count == 0) continue;
+        lo = any ? std::min(lo, column.min) : column.min;
+        hi = any ? std::max(hi, column.max) : column.max;
+        any = true;
+    }
+    if (!any) return;
+    if (hi - lo < 1.0e-6f) {
+        lo -= 0.5f;
+        hi += 0.5f;
+    }
+    float column_width = plot_width / columns;
+    auto to_y = [&](float value) {
+        return plot_y + plot_height * (1.0f - (value - lo) / (hi - lo));
+    };
+    
+    // min/max 包络（遇到空列断开）
+    SetColor(color.r, color.g, color.b, 0.3f);
+    bool open = false;
+    for (int i = 0; i < columns; i++) {
+        const TelemetryPyramid::Column& column = chart_columns[i];
+        if (column.count == 0) {
+            if (open) EndPrimitive();
+            open = false;
+            continue;
+        }
+        if (!open) BeginPrimitive(GL_QUAD_STRIP);
+        open = true;
+        float cx = plot_x + (i + 0.5f) * column_width;
+        EmitVertex(cx, to_y(column.max));
+        EmitVertex(cx, to_y(column.min));
+    }
+    if (open) EndPrimitive();
+    
+    // 均值线（跨过空列连接）
+    SetColor(color.r, color.g, color.b, 0.9f);
+    SetLineWidth(1.5f);
+    BeginPrimitive(GL_LINE_STRIP);
+    for (int i = 0; i < columns; i++) {
+        const TelemetryPyramid::Column& column = chart_columns[i];
+        if (column.count == 0) continue;
+        EmitVertex(plot_x + (i + 0.5f) * column_width, to_y(column.mean));
+    }
+    EndPrimitive();
+    SetLineWidth(1.0f);
+}
+
+// ============ 重绘热力图 ============
+namespace {
+
+// 重绘层数 -> 颜色（1 层蓝色 ... 8 层及以上白色）
+Color OverdrawColor(int level) {
+    static const Color kRamp[] = {
+        Color(0.0f, 0.0f, 0.6f, 0.7f), Color(0.0f, 0.5f, 1.0f, 0.7f),
+        Color(0.0f, 0.9f, 0.4f, 0.7f), Color(0.7f, 1.0f, 0.0f, 0.7f),
+        Color(1.0f, 0.8f, 0.0f, 0.7f), Color(1.0f, 0.4f, 0.0f, 0.8f),
+        Color(1.0f, 0.0f, 0.0f, 0.8f), Color(1.0f, 1.0f, 1.0f, 0.9f)
+    };
+    return kRamp[std::max(1, std::min(level, 8)) - 1];
+}
+
+}  // namespace
+
+void Dashboard::DrawOverdrawHeatmap(int width, int height) {
+    // 恢复颜色写入，按模板值逐层着色
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+    glEnable(GL_BLEND);
+    SetAlphaBlend();
+    
+    for (int level = 1; level <= kOverdrawLevels; level++) {
+        // 最后一层包含所有更高的重绘次数
+        if (level < kOverdrawLevels) {
+            glStencilFunc(GL_EQUAL, level, 0xFF);
+        } else {
+            glStencilFunc(GL_LEQUAL, level, 0xFF);
+        }
+        Color color = OverdrawColor(level);
+        glColor4f(color.r, color.g, color.b, color.a);
+        glBegin(GL_QUADS);
+        glVertex2f(0.0f, 0.0f);
+        glVertex2f(static_cast<float>(width), 0.0f);
+        glVertex2f(static_cast<float>(width), static_cast<float>(height));
+        glVertex2f(0.0f, static_cast<float>(height));
+        glEnd();
+    }
+    
+    glDisable(GL_STENCIL_TEST);
+}
+
+// ============ 重绘热力图图例 ============
+void Dashboard::DrawOverdrawLegend(float x, float y, float width) {
+    float padding = 10.0f;
+    DrawRoundedRect(x, y, width, 8.0f + 2.0f * padding, 8.0f, Color(0.0f, 0.0f, 0.0f, 0.8f));
+    float swatch = (width - 2.0f * padding) / kOverdrawLevels;
+    for (int level = 1; level <= kOverdrawLevels; level++) {
+        Color color = OverdrawColor(level);
+        color.a = 1.0f;
+        DrawRoundedRect(x + padding + (level - 1) * swatch, y + padding,
+                        swatch - 2.0f, 8.0f, 1.0f, color);
+    }
+}
+
+// ============ 调试叠加层：画质、内存、各组件着色像素 ============
+float Dashboard::DebugOverlayHeight() const {
+    // 内边距 + 画质行 + 内存标题和各子系统；统计着色像素时再加重绘倍数和各组件条形
+    float height = 20.0f + 18.0f + (MEMORY_SUBSYSTEM_COUNT + 1) * 12.0f;
+    if (fill_accounting_) height += 18.0f + WIDGET_COUNT * 10.0f;
+    return height;
+}
+
+void Dashboard::DrawDebugOverlay(float x, float y, float width, float height) {
+    Color bg_color(0.0f, 0.0f, 0.0f, 0.8f);
+    DrawRoundedRect(x, y, width, height, 8.0f, bg_color);
+    
+    float padding = 10.0f;
+    float current_y = y + padding;
+    float label_width = width * 0.45f;
+    float bar_width = width - 2.0f * padding - label_width;
+    
+    // 画质级别（0 为完整画质）和调节器最近一个窗口的帧率；手动设置时帧率为 0
+    DrawText(x + padding, current_y, adaptive_quality_ ? "QUALITY AUTO" : "QUALITY", 8.0f,
+             Color::LightGray(0.9f));
+    DrawDigitalNumber(x + width - padding - 70.0f, current_y, quality_level_, 10.0f,
+                      quality_level_ > 0 ? theme_.warning : theme_.success);
+    DrawDigitalNumber(x + width - padding - 30.0f, current_y,
+                      static_cast<int>(quality_governor_.AverageFps() + 0.5), 10.0f, theme_.primary);
+    current_y += 18.0f;
+    
+    // 各子系统内存 (KB)；有上限时条形为占用/上限，超出为警告色。
+    // 叠加层本身不开启着色像素统计，顶点暂存只在显式开启统计时占用内存
+    const float memory_row = 12.0f;
+    MemoryUsage usage = GetMemoryUsage();
+    DrawText(x + padding, current_y, "MEMORY KB", 8.0f, Color::LightGray(0.9f));
+    DrawDigitalNumber(x + width - padding - 30.0f, current_y,
+                      static_cast<int>(usage.Total() / 1024), 8.0f, theme_.primary);
+    current_y += memory_row;
+    for (int i = 0; i < MEMORY_SUBSYSTEM_COUNT; i++) {
+        DrawText(x + padding, current_y, MemorySubsystemName(i), 6.0f, Color::LightGray(0.8f));
+        float ratio = 0.0f;
+        if (memory_budget_.Limited(i)) {
+            ratio = std::min(static_cast<float>(usage.bytes[i]) / memory_budget_.cap[i], 1.0f);
+            Color bar_color = memory_budget_.Exceeded(usage, i) ? theme_.warning : theme_.success;
+            DrawRoundedRect(x + padding + label_width, current_y,
+                            std::max(bar_width * 0.6f * ratio, 1.0f), memory_row * 0.5f, 1.0f,
+                            bar_color);
+        }
+        DrawDigitalNumber(x + width - padding - 30.0f, current_y,
+                          static_cast<int>(usage.bytes[i] / 1024), 6.0f, theme_.primary);
+        current_y += memory_row;
+    }
+    if (!fill_accounting_) return;
+    
+    // 总着色像素 / 仪表盘面积（平均重绘倍数 ×100）
+    double dash_area = std::max(1.0, static_cast<double>(dash_width_) * dash_height_);
+    DrawText(x + padding, current_y, "OVERDRAW x100", 8.0f, Color::LightGray(0.9f));
+    DrawDigitalNumber(x + width - padding - 30.0f, current_y,
+                      static_cast<int>(frame_stats_.shaded_pixels / dash_area * 100.0),
+                      10.0f, theme_.primary);
+    current_y += 18.0f;
+    
+    // 各组件条形图（相对最大值），占满剩余高度
+    double max_pixels = 1.0;
+    for (int i = 0; i < WIDGET_COUNT; i++) {
+        max_pixels = std::max(max_pixels, frame_stats_.widget_pixels[i]);
+    }
+    float row = (y + height - padding - current_y) / static_cast<float>(WIDGET_COUNT);
+    for (int i = 0; i < WIDGET_COUNT; i++) {
+        float ratio = static_cast<float>(frame_stats_.widget_pixels[i] / max_pixels);
+        DrawText(x + padding, current_y, DashboardWidgetName(static_cast<DashboardWidget>(i)),
+                 6.0f, Color::LightGray(0.8f));
+        Color bar_color = ratio > 0.5f ? theme_.warning : theme_.primary;
+        DrawRoundedRect(x + padding + label_width, current_y, 
+                        std::max(bar_width * ratio, 1.0f), row * 0.6f, 1.0f, bar_color);
+        current_y += row;
     }
-    glEnd();
-    glLineWidth(1.0f);
 }
 
 // ============ 主渲染函数（重新布局，增加间距） ============
 void Dashboard::Render(mjrContext* con, int width, int height) {
+    auto render_start = std::chrono::steady_clock::now();
+    frame_stats_ = DashboardFrameStats();
+    
     // 更新窗口尺寸
     if (width != window_width_ || height != window_height_) {
         window_width_ = width;
@@ -874,27 +2029,11 @@ void Dashboard::Render(mjrContext* con, int width, int height) {
         CalculateFollowPosition(nullptr, nullptr);
     }
     
-    // ============ 保存OpenGL状态 ============
-    glPushAttrib(GL_ALL_ATTRIB_BITS);
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0.0, width, height, 0.0, -1.0, 1.0);
-    
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-    
-    glDisable(GL_DEPTH_TEST);
-    glDisable(GL_LIGHTING);
-    glDisable(GL_TEXTURE_2D);
-    glDisable(GL_CULL_FACE);
-    glShadeModel(GL_SMOOTH);
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-    
-    // 启用混合（透明效果）
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // ============ 记录几何（布局坐标，所有视口共用） ============
+    draw_list_.Clear();
+    draw_state_ = DrawState();
+    SetColor(1.0f, 1.0f, 1.0f, 1.0f);
+    ClearLocalTransform();
     
     // ============ 仪表盘背景 ============
     if (follow_car_) {
@@ -902,6 +2041,7 @@ void Dashboard::Render(mjrContext* con, int width, int height) {
         DrawGlassEffect(dash_x_, dash_y_, dash_width_, dash_height_);
         
         // 背景渐变
+        SetWidget(WIDGET_GRADIENT);
         Color bg_start(0.05f, 0.05f, 0.08f, 0.85f);
         Color bg_end(0.1f, 0.1f, 0.15f, 0.9f);
         DrawGradientRect(dash_x_, dash_y_, dash_width_, dash_height_, bg_start, bg_end);
@@ -911,210 +2051,44 @@ void Dashboard::Render(mjrContext* con, int width, int height) {
         Color border_color = theme_.primary;
         border_color.a = 0.3f * border_glow;
         
-        glLineWidth(2.0f);
-        glColor4f(border_color.r, border_color.g, border_color.b, border_color.a);
-        glBegin(GL_LINE_LOOP);
-        glVertex2f(dash_x_, dash_y_);
-        glVertex2f(dash_x_ + dash_width_, dash_y_);
-        glVertex2f(dash_x_ + dash_width_, dash_y_ + dash_height_);
-        glVertex2f(dash_x_, dash_y_ + dash_height_);
-        glEnd();
-        glLineWidth(1.0f);
+        SetLineWidth(2.0f);
+        SetColor(border_color.r, border_color.g, border_color.b, border_color.a);
+        BeginPrimitive(GL_LINE_LOOP);
+        EmitVertex(dash_x_, dash_y_);
+        EmitVertex(dash_x_ + dash_width_, dash_y_);
+        EmitVertex(dash_x_ + dash_width_, dash_y_ + dash_height_);
+        EmitVertex(dash_x_, dash_y_ + dash_height_);
+        EndPrimitive();
+        SetLineWidth(1.0f);
     } else {
         // 固定位置：更明显的背景
+        SetWidget(WIDGET_PANEL);
         Color bg_color(0.0f, 0.0f, 0.0f, 0.9f);
         DrawRoundedRect(dash_x_, dash_y_, dash_width_, dash_height_, 15.0f, bg_color);
     }
     
-    // ============ 仪表盘布局（重新设计，增加间距） ============
-    float padding = 20.0f * scale_;  // 增加内边距
-    float content_width = dash_width_ - 2 * padding;
-    float content_height = dash_height_ - 2 * padding;
-    
-    float current_x = dash_x_ + padding;
-    float current_y = dash_y_ + padding;
-    
-    if (follow_car_) {
-        // ============ 跟随模式布局（重新布局，增加间距） ============
-        
-        // 第一行：速度表和转速表
-        float top_height = content_height * 0.45f;  // 增加高度
-        
-        // 速度表（左侧）- 增加间距
-        float speed_radius = top_height * 0.35f;
-        float speed_x = current_x + content_width * 0.25f;
-        DrawModernSpeedometer(speed_x, 
-                             current_y + top_height * 0.5f,
-                             speed_radius, animated_speed_);
-        
-        // 转速表（右侧）- 增加间距
-        float tach_x = current_x + content_width * 0.75f;
-        DrawModernTachometer(tach_x,
-                            current_y + top_height * 0.5f,
-                            speed_radius, animated_rpm_, data_.max_rpm);
-        
-        current_y += top_height + 15.0f;  // 增加行间距
-        
-        // 第二行：信息面板
-        float middle_height = content_height * 0.3f;
-        
-        // 电池指示器（左侧）- 增加间距
-        float battery_width = content_width * 0.25f;
-        DrawBatteryIndicator(current_x, 
-                            current_y + 10.0f,
-                            battery_width, middle_height - 20.0f, data_.battery_level);
-        
-        // 自动驾驶指示器（中间）- 增加间距
-        DrawAutopilotIndicator(current_x + content_width * 0.5f,
-                              current_y + middle_height * 0.5f, 
-                              20.0f, data_.autopilot);
-        
-        // 小地图（右侧）- 增加间距
-        DrawMinimap(current_x + content_width - battery_width * 0.5f,
-                   current_y + middle_height * 0.5f,
-                   middle_height * 0.4f, data_.car_x, data_.car_y, data_.car_heading);
-        
-        current_y += middle_height + 15.0f;  // 增加行间距
-        
-        // 第三行：导航和其他信息
-        float bottom_height = content_height * 0.25f;
-        
-        // 导航方向条（左侧）- 增加间距
-        float nav_width = content_width * 0.6f;
-        DrawNavigationBar(current_x, current_y, nav_width, bottom_height, data_.car_heading);
-        
-        // 档位显示（中间右侧）- 增加间距
-        std::string gear_text;
-        if (data_.gear == -1) gear_text = "R";
-        else if (data_.gear == 0) gear_text = "N";
-        else gear_text = std::to_string(data_.gear);
-        
-        Color gear_color = theme_.primary;
-        if (data_.gear == -1) gear_color = theme_.warning;
-        
-        float gear_x = current_x + nav_width + 30.0f;
-        DrawText(gear_x, 
-                current_y + bottom_height * 0.5f - 5.0f,
-                gear_text, 16.0f, gear_color);
-        
-        // 温度显示（最右侧）- 增加间距
-        std::string temp_text = std::to_string(static_cast<int>(data_.temperature)) + "°C";
-        Color temp_color = (data_.temperature > 90.0f) ? theme_.warning : Color::White(0.9f);
-        DrawText(gear_x + 50.0f, current_y + bottom_height * 0.5f - 5.0f,
-                temp_text, 10.0f, temp_color);
-        
-    } else {
-        // ============ 固定位置布局（重新设计，增加间距） ============
-        
-        // 顶部标题行
-        float title_height = 30.0f;
-        DrawText(current_x + content_width * 0.5f - 40.0f,
-                current_y + title_height * 0.5f - 5.0f,
-                "VEHICLE DASHBOARD", 12.0f, theme_.primary);
-        
-        current_y += title_height + 20.0f;  // 增加间距
-        
-        // 第一行：两个主表盘
-        float gauge_height = content_height * 0.55f;
-        
-        // 速度表（左侧）- 增加间距
-        float left_width = content_width * 0.45f;
-        float speedometer_radius = gauge_height * 0.35f;
-        DrawModernSpeedometer(current_x + left_width * 0.5f,
-                             current_y + gauge_height * 0.5f,
-                             speedometer_radius, animated_speed_);
-        
-        // 速度标签
-        DrawText(current_x + left_width * 0.5f - 25.0f,
-                current_y + gauge_height * 0.9f,
-                "SPEED", 10.0f, Color::LightGray(0.9f));
-        
-        // 转速表（右侧）- 增加间距
-        float right_width = content_width * 0.45f;
-        float tachometer_radius = gauge_height * 0.35f;
-        DrawModernTachometer(current_x + content_width - right_width * 0.5f,
-                            current_y + gauge_height * 0.5f,
-                            tachometer_radius, animated_rpm_, data_.max_rpm);
-        
-        // 转速标签
-        DrawText(current_x + content_width - right_width * 0.5f - 20.0f,
-                current_y + gauge_height * 0.9f,
-                "RPM", 10.0f, Color::LightGray(0.9f));
-        
-        current_y += gauge_height + 20.0f;  // 增加间距
-        
-        // 第二行：信息面板
-        float info_height = content_height * 0.45f;
-        
-        // 左侧信息列
-        float col_width = content_width * 0.3f;
-        
-        // 电池指示器
-        DrawBatteryIndicator(current_x,
-                           current_y + 10.0f,
-                           col_width - 10.0f, 35.0f, data_.battery_level);
-        
-        // 自动驾驶状态
-        DrawAutopilotIndicator(current_x + col_width * 0.5f,
-                              current_y + 70.0f,
-                              18.0f, data_.autopilot);
-        
-        // 中间信息列
-        float center_x = current_x + col_width + 20.0f;
-        
-        // 档位显示
-        std::string gear_text;
-        if (data_.gear == -1) gear_text = "REVERSE";
-        else if (data_.gear == 0) gear_text = "NEUTRAL";
-        else gear_text = "GEAR " + std::to_string(data_.gear);
-        
-        Color gear_color = theme_.primary;
-        if (data_.gear == -1) gear_color = theme_.warning;
-        
-        DrawText(center_x + col_width * 0.5f - 35.0f,
-                current_y + 30.0f, gear_text, 12.0f, gear_color);
-        
-        // 温度显示
-        std::string temp_text = "TEMP: " + std::to_string(static_cast<int>(data_.temperature)) + "°C";
-        Color temp_color = (data_.temperature > 90.0f) ? theme_.warning : Color::White(0.9f);
-        DrawText(center_x + col_width * 0.5f - 40.0f,
-                current_y + 60.0f, temp_text, 10.0f, temp_color);
-        
-        // 能量流
-        DrawEnergyFlow(center_x + col_width * 0.5f,
-                      current_y + 90.0f,
-                      25.0f, data_.throttle, data_.brake * 0.5f);
-        
-        // 右侧信息列
-        float right_x = center_x + col_width + 20.0f;
-        
-        // 小地图
-        DrawMinimap(right_x + col_width * 0.5f,
-                   current_y + info_height * 0.5f,
-                   col_width * 0.4f, data_.car_x, data_.car_y, data_.car_heading);
-        
-        // 导航方向
-        DrawNavigationBar(right_x + 5.0f,
-                         current_y + 100.0f,
-                         col_width - 10.0f, 40.0f, data_.car_heading);
-    }
+    // ============ 仪表盘组件（dashboard_widgets.h 中注册） ============
+    WidgetLayout layout = ComputeWidgetLayout(follow_car_, dash_x_, dash_y_, dash_width_,
+                                              dash_height_, scale_);
+    widgets_.Draw(*this, layout, data_);
     
     // ============ 警告指示器 ============
     if (data_.warning) {
+        SetWidget(WIDGET_WARNING);
         float warning_alpha = 0.5f + 0.5f * sinf(warning_blink_);
         Color warning_color = theme_.warning;
         warning_color.a = warning_alpha;
         
         // 警告边框
-        glLineWidth(3.0f);
-        glColor4f(warning_color.r, warning_color.g, warning_color.b, warning_color.a);
-        glBegin(GL_LINE_LOOP);
-        glVertex2f(dash_x_, dash_y_);
-        glVertex2f(dash_x_ + dash_width_, dash_y_);
-        glVertex2f(dash_x_ + dash_width_, dash_y_ + dash_height_);
-        glVertex2f(dash_x_, dash_y_ + dash_height_);
-        glEnd();
-        glLineWidth(1.0f);
+        SetLineWidth(3.0f);
+        SetColor(warning_color.r, warning_color.g, warning_color.b, warning_color.a);
+        BeginPrimitive(GL_LINE_LOOP);
+        EmitVertex(dash_x_, dash_y_);
+        EmitVertex(dash_x_ + dash_width_, dash_y_);
+        EmitVertex(dash_x_ + dash_width_, dash_y_ + dash_height_);
+        EmitVertex(dash_x_, dash_y_ + dash_height_);
+        EndPrimitive();
+        SetLineWidth(1.0f);
         
         // 警告图标
         if (warning_alpha > 0.7f) {
@@ -1124,6 +2098,99 @@ void Dashboard::Render(mjrContext* con, int width, int height) {
         }
     }
     
+    // ============ 左侧面板：规划器性能、估计器误差、遥测趋势图 ============
+    float left_y = 20.0f;
+    if (show_planner_panel_ && planner_stats_) {
+        DrawPlannerPanel(20.0f, left_y, 220.0f * scale_, 200.0f * scale_);
+        left_y += 210.0f * scale_;
+    }
+    
+    if (estimator_valid_) {
+        DrawEstimatorPanel(20.0f, left_y, 220.0f * scale_, 118.0f * scale_);
+        left_y += 128.0f * scale_;
+    }
+    
+    if (show_cost_panel_ && cost_breakdown_.NumTerms() > 0) {
+        float cost_height = (90.0f + 14.0f * cost_breakdown_.NumTerms()) * scale_;
+        DrawCostPanel(20.0f, left_y, 220.0f * scale_, cost_height);
+        left_y += cost_height + 10.0f * scale_;
+    }
+    
+    if (show_strip_charts_ && strip_chart_count_ > 0) {
+        float chart_y = left_y;
+        float chart_height = 60.0f * scale_;
+        static const Color kChartColors[] = {
+            Color(0.0f, 0.8f, 1.0f), Color(1.0f, 0.6f, 0.0f), Color(0.3f, 1.0f, 0.4f),
+            Color(1.0f, 0.3f, 0.6f)
+        };
+        for (int i = 0; i < strip_chart_count_; i++) {
+            DrawStripChart(20.0f, chart_y, 220.0f * scale_, chart_height, i, kChartColors[i]);
+            chart_y += chart_height + 8.0f * scale_;
+        }
+    }
+    
+    // ============ 保存OpenGL状态 ============
+    glPushAttrib(GL_ALL_ATTRIB_BITS);
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+    
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_TEXTURE_2D);
+    glDisable(GL_CULL_FACE);
+    glShadeModel(GL_SMOOTH);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    glEnable(GL_SCISSOR_TEST);
+    
+    // 混合开关随图元记录，混合函数整帧不变
+    SetAlphaBlend();
+    
+    // ============ 重绘调试：只写模板缓冲，每个片元 +1 ============
+    if (debug_overdraw_) {
+        glClearStencil(0);
+        glClear(GL_STENCIL_BUFFER_BIT);
+        glEnable(GL_STENCIL_TEST);
+        glStencilFunc(GL_ALWAYS, 0, 0xFF);
+        glStencilOp(GL_KEEP, GL_INCR, GL_INCR);
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    }
+    
+    // ============ 按视口回放 ============
+    DashboardViewport window;
+    window.width = width;
+    window.height = height;
+    if (viewports_.empty()) {
+        ApplyViewport(window, width, height);
+        draw_list_.Replay(&frame_stats_.draw_calls, &frame_stats_.vertices);
+    }
+    for (const DashboardViewport& viewport : viewports_) {
+        if (viewport.width <= 0 || viewport.height <= 0) continue;
+        ApplyViewport(viewport, width, height);
+        draw_list_.Replay(&frame_stats_.draw_calls, &frame_stats_.vertices);
+    }
+    
+    // ============ 重绘热力图与调试叠加层（整个窗口，两者相互独立） ============
+    if (debug_overdraw_ || debug_overlay_) {
+        ApplyViewport(window, width, height);
+        if (debug_overdraw_) DrawOverdrawHeatmap(width, height);
+        draw_list_.Clear();
+        draw_state_ = DrawState();
+        SetWidget(WIDGET_DEBUG);
+        float overlay_y = 20.0f;
+        if (debug_overdraw_) {
+            DrawOverdrawLegend(width - 270.0f, overlay_y, 250.0f);
+            overlay_y += 36.0f;
+        }
+        if (debug_overlay_) {
+            DrawDebugOverlay(width - 270.0f, overlay_y, 250.0f, DebugOverlayHeight());
+        }
+        draw_list_.Replay(&frame_stats_.draw_calls, &frame_stats_.vertices);
+    }
+    
     // ============ 恢复OpenGL状态 ============
     glDisable(GL_BLEND);
     glPopMatrix();
@@ -1131,6 +2198,18 @@ void Dashboard::Render(mjrContext* con, int width, int height) {
     glPopMatrix();
     glMatrixMode(GL_MODELVIEW);
     glPopAttrib();
+    
+    frame_stats_.cpu_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - render_start).count();
+    
+    // 自适应画质：本帧工作时间 = 仪表盘 CPU 耗时 + 调用方报告的场景耗时。
+    // 不用相邻两次 Render 的间隔：开启垂直同步时间隔总是刷新周期，永远达不到升级条件。
+    if (adaptive_quality_) {
+        if (quality_governor_.AddFrame(frame_stats_.cpu_ms + scene_ms_)) {
+            ApplyQualityLevel(quality_governor_.Level());
+        }
+        scene_ms_ = 0.0;
+    }
 }
 // ============ 终端输出函数 ============
 void Dashboard::PrintDataToConsole() const {
@@ -1154,9 +2233,11 @@ void Dashboard::PrintDataToConsole() const {
     else printf("%d档\n", data_.gear);
     
     printf("   燃油量: %5.1f%%\n", data_.fuel);
+    bool overheat = data_.alert_rules &&
+                    (data_.alerts & data_.alert_rules->Bit(AlertRuleSet::kOverheat));
     printf("   温度: %5.1f°C %s\n", 
            data_.temperature,
-           data_.temperature > 90.0f ? "⚠️" : "");
+           overheat ? "⚠️" : "");
     
     // 3. 控制输入
     printf("🎮 控制输入:\n");
@@ -1172,10 +2253,25 @@ void Dashboard::PrintDataToConsole() const {
     // 4. 驾驶模式
     printf("🤖 驾驶模式:\n");
     printf("   模式: %s %s\n", 
-           data_.mode.c_str(),
+           data_.mode,
            data_.autopilot ? "🟢" : "🔴");
-    printf("   警告状态: %s\n", 
-           data_.warning ? "⚠️ 有警告" : "✅ 正常");
+    printf("   警告状态: %s", data_.warning ? "⚠️ 有警告" : "✅ 正常");
+    if (data_.alert_rules) {
+        for (int i = 0; i < data_.alert_rules->NumRules(); i++) {
+            if (data_.alerts >> i & 1u) printf(" [%s]", data_.alert_rules->Name(i));
+        }
+    }
+    printf("\n");
+    // 上次输出以来的警报事件
+    const AlertLog& events = telemetry_.AlertEvents();
+    int first = events.Size() - static_cast<int>(std::min<uint64_t>(
+                                    events.Total() - printed_alert_events_, events.Size()));
+    for (int i = first; i < events.Size(); i++) {
+        const AlertEvent& event = events.At(i);
+        printf("   %8.2fs %s %s (%.1f)\n", event.time, event.raised ? "触发" : "解除",
+               telemetry_.AlertRules().Name(event.rule), event.value);
+    }
+    printed_alert_events_ = events.Total();
     
     // 5. 能源系统
     printf("🔋 能源系统:\n");
@@ -1195,7 +2291,37 @@ void Dashboard::PrintDataToConsole() const {
     int minute = static_cast<int>((data_.time_of_day - hour) * 60.0);
     printf("   当前时间: %02d:%02d\n", hour, minute);
     
-    // 8. 仪表盘状态
+    // 8. 规划器性能
+    if (planner_stats_) {
+        printf("⏱️ 规划性能:\n");
+        printf("   规划耗时: %7.2f ms (周期 %.0f ms) %s\n",
+               planner_now_.last_plan_time * 1.0e3, planner_stats_->Deadline() * 1.0e3,
+               planner_now_.last_plan_time > planner_stats_->Deadline() ? "⚠️" : "");
+        printf("   Rollout: %8.0f /s | 策略更新延迟: %7.2f ms\n",
+               planner_rollouts_per_sec_, planner_now_.last_policy_latency * 1.0e3);
+        printf("   线程池: 队列 %d | 忙碌 %d/%d | 利用率 %5.1f%%\n",
+               planner_now_.queue_depth, planner_now_.busy_workers,
+               planner_now_.num_workers, planner_utilization_ * 100.0f);
+        printf("   超时次数: %llu / %llu\n",
+               static_cast<unsigned long long>(planner_now_.missed_deadlines),
+               static_cast<unsigned long long>(planner_now_.plan_iterations));
+    }
+    
+    // 9. 填充率统计（上一帧）
+    if (fill_accounting_) {
+        printf("🔥 着色像素估算:\n");
+        printf("   总计: %.0f px (仪表盘面积 %.0f px)\n",
+               frame_stats_.shaded_pixels, dash_width_ * dash_height_);
+        for (int i = 0; i < WIDGET_COUNT; i++) {
+            if (frame_stats_.widget_pixels[i] <= 0.0) continue;
+            printf("   %-14s %9.0f px  %5.1f%%\n",
+                   DashboardWidgetName(static_cast<DashboardWidget>(i)),
+                   frame_stats_.widget_pixels[i],
+                   100.0 * frame_stats_.widget_pixels[i] / std::max(frame_stats_.shaded_pixels, 1.0));
+        }
+    }
+    
+    // 10. 仪表盘状态
     printf("📱 仪表盘状态:\n");
     printf("   位置: (%.0f, %.0f) | 尺寸: %.0f×%.0f\n",
            dash_x_, dash_y_, dash_width_, dash_height_);
@@ -2,12 +2,28 @@
 #define MJPC_DASHBOARD_H_
 
 #include <mujoco/mujoco.h>
+#include <chrono>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <cstring>
 
 // 包含现有的 dashboard_data.h 文件
 #include "dashboard_data.h"
+#include "mjpc/console_view.h"
+#include "mjpc/cost_breakdown.h"
+#include "mjpc/draw_list.h"
+#include "mjpc/dashboard_telemetry.h"
+#include "mjpc/dashboard_widgets.h"
+#include "mjpc/estimator_view.h"
+#include "mjpc/fleet_telemetry.h"
+#include "mjpc/memory_budget.h"
+#include "mjpc/planner_stats.h"
+#include "mjpc/quality_governor.h"
+#include "mjpc/rate_scheduler.h"
+#include "mjpc/telemetry_recorder.h"
+#include "mjpc/telemetry_broadcast.h"
+#include "mjpc/telemetry_shm.h"
 
 namespace mjpc {
 
@@ -33,6 +49,77 @@ struct Color {
     static Color LightGray(float alpha = 1.0f) { return Color(0.8f, 0.8f, 0.8f, alpha); }
 };
 
+// 仪表盘组件（用于填充率统计）
+enum DashboardWidget {
+    WIDGET_GLASS,            // 玻璃效果
+    WIDGET_GRADIENT,         // 背景渐变与发光边框
+    WIDGET_PANEL,            // 固定模式的圆角背景
+    WIDGET_GLOW,             // 霓虹辉光
+    WIDGET_SPEEDOMETER,
+    WIDGET_TACHOMETER,
+    WIDGET_DIGITAL_SPEED,
+    WIDGET_BATTERY,
+    WIDGET_ENERGY_FLOW,
+    WIDGET_AUTOPILOT,
+    WIDGET_NAVIGATION,
+    WIDGET_MINIMAP,
+    WIDGET_LABELS,           // 标题、档位、温度等文字
+    WIDGET_WARNING,          // 警告边框
+    WIDGET_PLANNER_PANEL,
+    WIDGET_STRIP_CHART,      // 遥测趋势图
+    WIDGET_ESTIMATOR,        // 估计器误差面板
+    WIDGET_COST,             // 代价分项面板
+    WIDGET_DEBUG,            // 调试叠加层本身
+    WIDGET_COUNT
+};
+
+const char* DashboardWidgetName(DashboardWidget widget);
+
+// Update 中的周期任务，各自按仿真时间的频率执行（频率 0 为每次 Update）
+enum DashboardTask {
+    TASK_MOTION,             // 位置、速度、转速、档位（每次 Update）
+    TASK_STATUS,             // 控制输入、自动驾驶、警告、行程（每次 Update）
+    TASK_TEMPERATURE,        // 温度（2 Hz）
+    TASK_FUEL,               // 油量和电量（2 Hz）
+    TASK_TRACE,              // 小地图轨迹采样（10 Hz）
+    TASK_RECORDER,           // 遥测记录（每次仿真时间推进，即物理频率）
+    TASK_STRIP_CHARTS,       // 趋势图查询（10 Hz）
+    TASK_COST,               // 代价分项与历史（10 Hz）
+    TASK_CONSOLE,            // 终端输出（0.5 Hz）
+    TASK_PUBLISH,            // 共享内存快照和遥测广播（每次仿真时间推进）
+    TASK_COUNT
+};
+
+const char* DashboardTaskName(DashboardTask task);
+
+// glBlendFuncSeparate（GL 1.4，需由调用方通过 glfwGetProcAddress 等方式获取）
+using BlendFuncSeparateProc = void (*)(unsigned int, unsigned int, unsigned int, unsigned int);
+
+// 视口：窗口中的像素矩形（左下角为原点，与 glViewport/mjrRect 一致），显示
+// 布局坐标（Render 的 width x height，左上角为原点）中的源矩形。源矩形宽高为 0
+// 时显示整个布局；源矩形与视口大小不同即为缩放，可以用来单独放大某个面板。
+struct DashboardViewport {
+    int left = 0;
+    int bottom = 0;
+    int width = 0;
+    int height = 0;
+    float source_x = 0.0f;
+    float source_y = 0.0f;
+    float source_width = 0.0f;
+    float source_height = 0.0f;
+};
+
+// 单帧渲染统计（性能回归测试使用）
+struct DashboardFrameStats {
+    double cpu_ms = 0.0;     // Render() 的 CPU 耗时 (ms)
+    int draw_calls = 0;      // 图元批次数（glDrawArrays 次数，所有视口合计）
+    int vertices = 0;        // 提交的顶点数（所有视口合计）
+    
+    // 估算的着色像素数（仅在开启填充率统计时计算）
+    double shaded_pixels = 0.0;
+    double widget_pixels[WIDGET_COUNT] = {};
+};
+
 class Dashboard {
 public:
     Dashboard();
@@ -40,7 +127,13 @@ public:
     
     // ============ 初始化函数 ============
     void Initialize(int width, int height);
+    // 单个视口，显示整个布局（坐标含义见 DashboardViewport）
     void SetViewport(int x, int y, int width, int height);
+    // 多个视口（分屏），每帧只生成一次几何，按各视口的变换分别回放；
+    // 为空时画满整个窗口
+    void SetViewports(const std::vector<DashboardViewport>& viewports) { viewports_ = viewports; }
+    void ClearViewports() { viewports_.clear(); }
+    const std::vector<DashboardViewport>& GetViewports() const { return viewports_; }
     
     // ============ 更新函数 ============
     // 新的更新函数
@@ -55,6 +148,7 @@ public:
         }
     }
     
+    // delta_time 为仿真时间增量 (s)
     void UpdateAnimation(float delta_time);
     
     // ============ 渲染函数 ============
@@ -77,17 +171,137 @@ public:
     void DrawAutopilotIndicator(float x, float y, float size, bool active);
     void DrawNavigationBar(float x, float y, float width, float height, float heading);
     void DrawMinimap(float x, float y, float radius, float car_x, float car_y, float heading);
+    void DrawPlannerPanel(float x, float y, float width, float height);
+    // 第 chart 个遥测趋势图：最近 window 秒的 min/max 包络和均值线
+    // （数据在 Update 中从记录器的金字塔查询，绘制时不访问记录器）
+    void DrawStripChart(float x, float y, float width, float height, int chart, const Color& color);
+    void DrawEstimatorPanel(float x, float y, float width, float height);
+    // 各残差项的加权代价（条形）和堆叠历史
+    void DrawCostPanel(float x, float y, float width, float height);
+    // 组件标签，颜色按当前主题取（填充率统计计入 WIDGET_LABELS）
+    void DrawLabel(float x, float y, const char* text, float size, WidgetLabelStyle style);
     
     // ============ 设置函数 ============
     void SetFollowCar(bool follow) { follow_car_ = follow; }
     void SetDashboardPosition(float x, float y) { dash_x_ = x; dash_y_ = y; }
     void SetScale(float scale) { scale_ = scale; }
     
+    // 规划器/线程池性能面板（stats 为空时不显示）
+    void SetPlannerStats(PlannerStats* stats) { planner_stats_ = stats; }
+    void SetShowPlannerPanel(bool show) { show_planner_panel_ = show; }
+    
+    // 遥测记录（不持有所有权），每次仿真时间推进时写入一个样本；
+    // 设置后左侧显示趋势图
+    void SetTelemetryRecorder(TelemetryRecorder* recorder) { recorder_ = recorder; }
+    void SetStripChartChannels(const std::vector<int>& channels) { strip_chart_channels_ = channels; }
+    void SetStripChartWindow(double seconds) { strip_chart_window_ = seconds; }
+    void SetShowStripCharts(bool show) { show_strip_charts_ = show; }
+    
+    // 共享内存发布（不持有所有权），每次仿真时间推进时写入一个快照
+    void SetTelemetryShmPublisher(TelemetryShmPublisher* publisher) { publisher_ = publisher; }
+    // 遥测广播（不持有所有权），每次仿真时间推进时发布一帧，由各订阅者自行下采样
+    void SetTelemetryBroadcaster(TelemetryBroadcaster* broadcaster) { broadcaster_ = broadcaster; }
+    // 终端界面（不持有所有权），每次仿真时间推进时写入一个快照，由其后台线程
+    // 差量刷新；设置后不再周期性调用 PrintDataToConsole
+    void SetConsoleView(ConsoleView* view) {
+        console_view_ = view;
+        if (view) view->SetAlertRules(telemetry_.AlertRules());
+    }
+    
+    // 估计器视图（只保存指针，不复制状态）；设置后小地图叠加估计位姿和
+    // 2-sigma 位置椭圆，并显示估计误差面板。传入空视图即可关闭。
+    void SetEstimatorView(const EstimatorView& view) { estimator_view_ = view; ResetEstimatorStats(); }
+    
+    // 多车场景（不持有所有权）；调用方在 Update 之前 Extract，小地图
+    // 以圆点显示其余车辆（最多 kMaxFleetMarkers 辆）。传入空指针即可关闭。
+    void SetFleetTelemetry(const FleetTelemetry* fleet) { fleet_ = fleet; fleet_marker_count_ = 0; }
+    
+    // 组件注册表（编译期确定，见 dashboard_widgets.h）
+    DashboardWidgets& GetWidgets() { return widgets_; }
+    
+    // 代价分项面板（模型没有 user 传感器时不显示）
+    void SetShowCostPanel(bool show) { show_cost_panel_ = show; }
+    
+    // 周期任务频率 (Hz，仿真时间)，0 为每次 Update；画质降级时轨迹、趋势图和代价
+    // 任务实际按 update_rate_scale 倍执行，这里返回设置的频率
+    void SetUpdateRate(DashboardTask task, double rate_hz);
+    double GetUpdateRate(DashboardTask task) const { return update_rates_[task]; }
+    // 按 "temperature=1,trace=20" 形式批量设置（名称见 DashboardTaskName），
+    // 任一项无法解析时返回 false 且不做任何修改
+    bool SetUpdateRates(const std::string& spec);
+
+    // 警报规则（格式见 alert_rules.h，默认为 AlertRuleSet::kDefaultRules），
+    // 编译失败时返回 false 且保留原规则
+    bool SetAlertRules(const std::string& rules, std::string* error = nullptr) {
+        if (!telemetry_.SetAlertRules(rules, error)) return false;
+        if (console_view_) console_view_->SetAlertRules(telemetry_.AlertRules());
+        return true;
+    }
+    const AlertLog& GetAlertEvents() const { return telemetry_.AlertEvents(); }
+    
     // 获取数据（用于向后兼容）
     const DashboardData& GetData() const { return data_; }
     
+    // 用外部数据驱动仪表盘（回放、性能测试），跳过仿真读取
+    void SetData(const DashboardData& data) { data_ = data; }
+    
+    // 主题切换（true 为深色）
+    void SetTheme(bool dark) { dark_theme_ = dark; if (dark) SetDarkTheme(); else SetLightTheme(); }
+    void ToggleTheme() { SetTheme(!dark_theme_); }
+    bool IsDarkTheme() const { return dark_theme_; }
+    
+    // 上一次 Render() 的统计
+    const DashboardFrameStats& GetFrameStats() const { return frame_stats_; }
+    
+    // 各子系统内存占用（不含异步渲染的离屏目标，见 AsyncDashboardRenderer::MemoryBytes）
+    MemoryUsage GetMemoryUsage() const;
+    // 超出上限的子系统不再增长：
+    //   顶点暂存 -> 缩减容量，超出部分的顶点不参与面积估算
+    //   历史     -> 降低趋势图列数
+    //   纹理     -> 降低辉光纹理分辨率
+    //   记录器   -> 每次记录后淘汰金字塔细层级的旧桶
+    void SetMemoryBudget(const MemoryBudget& budget);
+    const MemoryBudget& GetMemoryBudget() const { return memory_budget_; }
+    
+    // 自适应画质：按每帧的工作时间升降画质级别，保持 options.target_fps
+    // （级别含义见 QualitySettings）。工作时间为 Render 本身的 CPU 耗时加上
+    // ReportSceneTime 报告的场景耗时，不含等待垂直同步和交换缓冲的时间。
+    void SetAdaptiveQuality(const QualityGovernorOptions& options);
+    // 本帧场景渲染（mjr_render 等）的耗时 (ms)，在 Render 之前调用；不调用时只计仪表盘
+    void ReportSceneTime(double scene_ms) { scene_ms_ = scene_ms; }
+    // 关闭自适应并回到完整画质
+    void DisableAdaptiveQuality();
+    bool IsAdaptiveQuality() const { return adaptive_quality_; }
+    // 手动设置画质级别（自适应开启时由调节器接管）
+    void SetQualityLevel(int level);
+    int GetQualityLevel() const { return quality_level_; }
+    const QualityGovernor& GetQualityGovernor() const { return quality_governor_; }
+    
+    // 调试：片元重绘热力图（模板缓冲计数，屏蔽颜色写入）+ 各组件着色像素估算
+    void SetOverdrawDebug(bool enable) { debug_overdraw_ = enable; fill_accounting_ = enable; }
+    // 调试叠加层：在正常画面之上显示画质级别、帧率和各子系统内存，不启用热力图
+    // （自适应画质看到的是正常画面的耗时）。叠加层不开启着色像素统计，
+    // 以免统计用的顶点暂存计入内存；需要各组件着色像素时另外 SetFillAccounting(true)
+    void SetDebugOverlay(bool enable) { debug_overlay_ = enable; }
+    // 只统计着色像素，不改变画面
+    void SetFillAccounting(bool enable) { fill_accounting_ = enable || debug_overdraw_; }
+    void DrawDebugOverlay(float x, float y, float width, float height);
+    float DebugOverlayHeight() const;
+    void DrawOverdrawLegend(float x, float y, float width);
+    
     // 调试输出函数
     void PrintDataToConsole() const; 
+    
+    // 释放 GL 资源（辉光纹理）；需在 GL 上下文销毁前、上下文为当前时调用
+    void ReleaseGLResources();
+    
+    // 复制 Render 需要的显示状态（不含遥测积分器、记录器等更新侧状态），
+    // 保留本对象的 GL 资源（辉光纹理）和混合函数；预热后不分配内存。
+    // 异步渲染线程用自己的副本绘制，主线程继续 Update 原对象。
+    void CopyStateFrom(const Dashboard& other);
+    
+    // 渲染到透明的离屏纹理时设置，使 alpha 通道正确累积（结果为预乘 alpha）
+    void SetOffscreenBlend(BlendFuncSeparateProc proc) { blend_func_separate_ = proc; }
 
     // 设置跟随模式
     enum FollowMode {
@@ -95,7 +309,11 @@ public:
         FOLLOW_CAR_3D      // 跟随小车3D位置
     };
     
-    void SetFollowMode(FollowMode mode) { follow_mode_ = mode; }
+    // FOLLOW_CAR_3D 同时打开跟随布局（SetFollowCar(true)）
+    void SetFollowMode(FollowMode mode) {
+        follow_mode_ = mode;
+        if (mode == FOLLOW_CAR_3D) follow_car_ = true;
+    }
     void SetOffsetFromCar(float x, float y, float z) { offset_x_ = x; offset_y_ = y; offset_z_ = z; }
     
     // 更新摄像机信息（用于3D投影）
@@ -103,21 +321,35 @@ public:
 private:
     // 数据 - 使用 dashboard_data.h 中的定义
     DashboardData data_;
-    float last_update_time_;
+    TelemetryIntegrator telemetry_;
+    mutable uint64_t printed_alert_events_ = 0;   // 终端已输出的警报事件数（PrintDataToConsole）
+    AlertRuleSet render_alert_rules_;             // CopyStateFrom 得到的副本所显示的警报名称
+    double last_update_time_;         // 上次更新的仿真时间
+    RateScheduler scheduler_;         // 周期任务（DashboardTask）
+    double update_rates_[TASK_COUNT] = {};   // 设置的频率（未按画质缩放）
+    
+    // 画质（自适应时由调节器决定级别）
+    QualityGovernor quality_governor_;
+    bool adaptive_quality_ = false;
+    int quality_level_ = 0;
+    QualitySettings quality_ = GetQualitySettings(0);
+    double scene_ms_ = 0.0;           // ReportSceneTime 报告的本帧场景耗时，Render 后清零
+    float animation_pending_ = 0.0f;  // 降低动画频率时累积的时间 (s)
+    void ApplyQualityLevel(int level);
+    void ApplyUpdateRate(int task);
     
     // 动画参数
     float pulse_phase_;
     float glow_intensity_;
     float warning_blink_;
     
-    // 平滑动画值
-    float animated_speed_;
-    float animated_rpm_;
+    // 表盘等组件（各自保存动画状态）
+    DashboardWidgets widgets_;
     
     // 窗口尺寸
     int window_width_;
     int window_height_;
-    int viewport_x_, viewport_y_, viewport_width_, viewport_height_;
+    std::vector<DashboardViewport> viewports_;
     
     // 仪表盘位置和大小
     float dash_x_, dash_y_, dash_width_, dash_height_;
@@ -127,6 +359,40 @@ private:
     // 跟随模式
     FollowMode follow_mode_ = FIXED_SCREEN;
     
+    bool dark_theme_ = true;
+    DashboardFrameStats frame_stats_;
+    
+    // 辉光：原实现为三层同心圆，这里保留各层参数用于生成纹理和计算峰值
+    static constexpr int kGlowLayers = 3;
+    static constexpr float kGlowLayerGrowth[kGlowLayers] = {0.9f, 0.6f, 0.3f};  // 半径增量/强度
+    static constexpr float kGlowLayerAlpha[kGlowLayers] = {0.2f, 0.4f / 3.0f, 0.2f / 3.0f};
+    static constexpr float kGlowNominalIntensity = 0.5f;
+    static constexpr int kGlowTextureSize = 64;      // 最大边长
+    static constexpr int kGlowTextureMinSize = 8;
+    unsigned int glow_texture_ = 0;
+    int glow_texture_size_ = kGlowTextureSize;       // 预算允许的边长
+    int glow_texture_built_size_ = 0;                // 当前纹理的边长
+    BlendFuncSeparateProc blend_func_separate_ = nullptr;
+    
+    // 重绘调试
+    static constexpr int kOverdrawLevels = 8;
+    bool debug_overdraw_ = false;
+    bool debug_overlay_ = false;
+    bool fill_accounting_ = false;
+    DashboardWidget current_widget_ = WIDGET_PANEL;
+    
+    // 本帧的图元（Render 中先记录，再按视口回放）和当前绘制状态
+    DrawList draw_list_;
+    DrawState draw_state_;
+    float draw_color_[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    // 局部坐标系（小地图车辆图标），在 EmitVertex 中变换到布局坐标
+    bool local_transform_ = false;
+    float local_origin_[2] = {0.0f, 0.0f};
+    float local_rotation_[2] = {1.0f, 0.0f};   // cos, sin
+    unsigned int primitive_mode_ = 0;
+    std::vector<float> primitive_vertices_;   // 当前图元的顶点 (x, y)，用于面积估算
+    size_t primitive_vertex_limit_ = SIZE_MAX;  // 顶点暂存的 float 数上限
+    
     // 相对于小车的偏移量
     float offset_x_ = 0.0f;    // 小车前方的偏移
     float offset_y_ = 0.0f;    // 左右偏移
@@ -138,6 +404,76 @@ private:
     float cam_up_[3] = {0, 1, 0};
     float cam_right_[3] = {1, 0, 0};
     
+    // 规划器性能面板
+    static constexpr int kPlannerHistogramBins = 16;
+    PlannerStats* planner_stats_ = nullptr;
+    bool show_planner_panel_ = true;
+    const mjModel* planner_model_ = nullptr;      // 上次读取 agent_timestep 的模型
+    PlannerStats::Snapshot planner_now_;
+    PlannerStats::Snapshot planner_prev_;
+    float planner_rollouts_per_sec_ = 0.0f;
+    float planner_utilization_ = 0.0f;            // 0-1
+    float planner_history_[PlannerStats::kHistoryLength] = {};
+    
+    // 遥测趋势图
+    static constexpr int kMaxStripCharts = 4;
+    static constexpr int kStripChartMaxColumns = 512;
+    TelemetryRecorder* recorder_ = nullptr;
+    TelemetryShmPublisher* publisher_ = nullptr;
+    TelemetryBroadcaster* broadcaster_ = nullptr;
+    ConsoleView* console_view_ = nullptr;
+    bool show_strip_charts_ = true;
+    double strip_chart_window_ = 30.0;            // 显示最近多少秒 (仿真时间)
+    std::vector<int> strip_chart_channels_ = {CHANNEL_SPEED, CHANNEL_RPM, CHANNEL_THROTTLE};
+    int strip_chart_count_ = 0;
+    int strip_chart_column_count_ = 0;
+    std::vector<TelemetryPyramid::Column> strip_chart_columns_;   // [图][列]
+    
+    // 估计器 vs 真值
+    // 滑动窗口按仿真时间分成定长的箱，每箱累计误差平方和与样本数，
+    // 窗口统计为最近 kEstimatorErrorBins 个箱之和（不分配内存）
+    static constexpr double kEstimatorErrorWindow = 5.0;   // 滑动窗口 (s，仿真时间)
+    static constexpr int kEstimatorErrorBins = 50;
+    struct EstimatorErrorBin {
+        double error_sq = 0.0;
+        int samples = 0;
+        int inside = 0;                        // 真值落在 2-sigma 椭圆内的样本数
+    };
+    EstimatorView estimator_view_;
+    EstimatedPose estimated_pose_;
+    bool estimator_valid_ = false;
+    float estimator_error_ = 0.0f;             // 当前位置误差 (m)
+    float estimator_error_rms_ = 0.0f;         // 位置误差均方根（最近 5 s）
+    float estimator_error_max_ = 0.0f;
+    float estimator_heading_error_ = 0.0f;     // 偏航误差 (rad)
+    float estimator_consistency_ = 0.0f;       // 真值落在 2-sigma 椭圆内的比例（最近 5 s）
+    EstimatorErrorBin estimator_bins_[kEstimatorErrorBins];
+    int64_t estimator_bin_ = -1;               // 最近写入的箱序号（仿真时间 / 箱宽），-1 为空
+    
+    // 代价分项（每次 TASK_COST 计算并压入历史）
+    CostBreakdown cost_breakdown_;
+    bool show_cost_panel_ = true;
+    
+    // 小地图轨迹（TASK_TRACE 采样的位置环形缓冲）
+    static constexpr int kTraceLength = 256;
+    float trace_[kTraceLength][2] = {};
+    int trace_head_ = 0;
+    int trace_count_ = 0;
+    
+    // 其余车辆位置（TASK_MOTION 时从 fleet_ 复制，渲染只读这份拷贝）
+    static constexpr int kMaxFleetMarkers = 256;
+    const FleetTelemetry* fleet_ = nullptr;
+    float fleet_markers_[kMaxFleetMarkers][2] = {};
+    int fleet_marker_count_ = 0;
+    void UpdateFleetMarkers();
+    
+    // 内存预算；规划器耗时、代价历史和轨迹为定长数组，历史预算的其余部分给趋势图
+    static constexpr size_t kFixedHistoryBytes =
+        sizeof(float) * (PlannerStats::kHistoryLength +
+                         CostBreakdown::kHistoryLength * CostBreakdown::kMaxTerms +
+                         kTraceLength * 2);
+    MemoryBudget memory_budget_;
+    
     // 3D投影相关
     bool Project3DTo2D(float x, float y, float z, float& screen_x, float& screen_y);
     
@@ -155,6 +491,29 @@ private:
     void SetDarkTheme();
     void SetLightTheme();
     
+    void SetAlphaBlend();
+    
+    // 图元提交（所有绘制都经过这里，记录到 draw_list_）
+    void BeginPrimitive(unsigned int mode);
+    void EmitVertex(float x, float y);
+    void EmitVertex(float x, float y, float u, float v);   // 带纹理坐标
+    void EndPrimitive();
+    // 绘制状态，对应 glColor4f / glLineWidth / glPointSize / GL_BLEND / 纹理绑定
+    void SetColor(float r, float g, float b, float a) {
+        draw_color_[0] = r; draw_color_[1] = g; draw_color_[2] = b; draw_color_[3] = a;
+    }
+    void SetLineWidth(float width) { draw_state_.line_width = width; }
+    void SetPointSize(float size) { draw_state_.point_size = size; }
+    void SetBlend(bool enable) { draw_state_.blend = enable; }
+    void SetTexture(unsigned int texture) { draw_state_.texture = texture; }
+    // 之后的顶点先旋转 angle（弧度）再平移到 (x, y)，代替 glTranslatef/glRotatef
+    void SetLocalTransform(float x, float y, float angle);
+    void ClearLocalTransform() { local_transform_ = false; }
+    void RecordPrimitiveVertex(float x, float y);
+    void SetWidget(DashboardWidget widget) { current_widget_ = widget; }
+    double PrimitiveArea() const;
+    void DrawOverdrawHeatmap(int width, int height);
+    
     void DrawGradientRect(float x, float y, float width, float height,
                          const Color& c1, const Color& c2, bool horizontal = true);
     void DrawRoundedRect(float x, float y, float width, float height,
@@ -166,16 +525,22 @@ private:
                  float thickness, const Color& color); 
     void DrawGlassEffect(float x, float y, float width, float height);
     void DrawNeonGlow(float x, float y, float radius, const Color& color, float intensity);
+    void CreateGlowTexture();
     void DrawDigitSevenSegment(float x, float y, int digit, float size, const Color& color);
     void DrawDigitalNumber(float x, float y, int number, float size, const Color& color);
-    void DrawText(float x, float y, const std::string& text, float size, const Color& color);
+    void DrawText(float x, float y, const char* text, float size, const Color& color);
     void DrawProgressBar(float value, int width) const;
     void DrawSteeringBar(float value, int width) const; 
-    // 数据平滑函数
-    float SmoothValue(float current, float target, float smoothing);
     
     // 计算跟随位置
     void CalculateFollowPosition(const mjModel* m, const mjData* d);
+    
+    // 刷新规划器统计（速率按两次快照之差计算）
+    void UpdatePlannerStats(const mjModel* m);
+    void UpdateEstimatorStats(const mjModel* m, const mjData* d);
+    void UpdateStripCharts();
+    void PushTracePoint();
+    void ResetEstimatorStats();
 };
 
 // 向前兼容的辅助函数
@@ -0,0 +1,334 @@
+#include "mjpc/dashboard_async.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include <GLFW/glfw3.h>
+
+namespace mjpc {
+
+namespace {
+
+// ============ GL 3.x 入口（通过 GLFW 获取，不依赖 glext.h） ============
+constexpr unsigned int kFramebuffer = 0x8D40;
+constexpr unsigned int kRenderbuffer = 0x8D41;
+constexpr unsigned int kColorAttachment0 = 0x8CE0;
+constexpr unsigned int kDepthStencilAttachment = 0x821A;
+constexpr unsigned int kDepth24Stencil8 = 0x88F0;
+constexpr unsigned int kFramebufferComplete = 0x8CD5;
+constexpr unsigned int kRgba8 = 0x8058;
+constexpr unsigned int kClampToEdge = 0x812F;
+constexpr unsigned int kSyncGpuCommandsComplete = 0x9117;
+constexpr uint64_t kTimeoutIgnored = 0xFFFFFFFFFFFFFFFFull;
+
+struct GLFunctions {
+    void (APIENTRY *GenFramebuffers)(int, unsigned int*) = nullptr;
+    void (APIENTRY *DeleteFramebuffers)(int, const unsigned int*) = nullptr;
+    void (APIENTRY *BindFramebuffer)(unsigned int, unsigned int) = nullptr;
+    void (APIENTRY *FramebufferTexture2D)(unsigned int, unsigned int, unsigned int,
+                                          unsigned int, int) = nullptr;
+    void (APIENTRY *GenRenderbuffers)(int, unsigned int*) = nullptr;
+    void (APIENTRY *DeleteRenderbuffers)(int, const unsigned int*) = nullptr;
+    void (APIENTRY *BindRenderbuffer)(unsigned int, unsigned int) = nullptr;
+    void (APIENTRY *RenderbufferStorage)(unsigned int, unsigned int, int, int) = nullptr;
+    void (APIENTRY *FramebufferRenderbuffer)(unsigned int, unsigned int, unsigned int,
+                                             unsigned int) = nullptr;
+    unsigned int (APIENTRY *CheckFramebufferStatus)(unsigned int) = nullptr;
+    void* (APIENTRY *FenceSync)(unsigned int, unsigned int) = nullptr;
+    void (APIENTRY *WaitSync)(void*, unsigned int, uint64_t) = nullptr;
+    void (APIENTRY *DeleteSync)(void*) = nullptr;
+    void (APIENTRY *BlendFuncSeparate)(unsigned int, unsigned int, unsigned int,
+                                       unsigned int) = nullptr;
+};
+
+GLFunctions gl;
+
+template <typename T>
+bool Load(T* function, const char* name) {
+    *function = reinterpret_cast<T>(glfwGetProcAddress(name));
+    return *function != nullptr;
+}
+
+bool LoadFunctions() {
+    return Load(&gl.GenFramebuffers, "glGenFramebuffers") &&
+           Load(&gl.DeleteFramebuffers, "glDeleteFramebuffers") &&
+           Load(&gl.BindFramebuffer, "glBindFramebuffer") &&
+           Load(&gl.FramebufferTexture2D, "glFramebufferTexture2D") &&
+           Load(&gl.GenRenderbuffers, "glGenRenderbuffers") &&
+           Load(&gl.DeleteRenderbuffers, "glDeleteRenderbuffers") &&
+           Load(&gl.BindRenderbuffer, "glBindRenderbuffer") &&
+           Load(&gl.RenderbufferStorage, "glRenderbufferStorage") &&
+           Load(&gl.FramebufferRenderbuffer, "glFramebufferRenderbuffer") &&
+           Load(&gl.CheckFramebufferStatus, "glCheckFramebufferStatus") &&
+           Load(&gl.FenceSync, "glFenceSync") &&
+           Load(&gl.WaitSync, "glWaitSync") &&
+           Load(&gl.DeleteSync, "glDeleteSync") &&
+           Load(&gl.BlendFuncSeparate, "glBlendFuncSeparate");
+}
+
+void BlendFuncSeparate(unsigned int src_rgb, unsigned int dst_rgb,
+                       unsigned int src_alpha, unsigned int dst_alpha) {
+    gl.BlendFuncSeparate(src_rgb, dst_rgb, src_alpha, dst_alpha);
+}
+
+}  // namespace
+
+// ============ 启动/停止 ============
+bool AsyncDashboardRenderer::Start(GLFWwindow* share) {
+    if (IsRunning() || !share) return false;
+    if (!LoadFunctions()) {
+        fprintf(stderr, "AsyncDashboardRenderer: FBO/sync functions unavailable\n");
+        return false;
+    }
+
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    context_ = glfwCreateWindow(1, 1, "dashboard", nullptr, share);
+    glfwDefaultWindowHints();
+    if (!context_) return false;
+
+    stop_ = false;
+    pending_ = false;
+    front_ = -1;
+    in_use_ = -1;
+    dashboard_.SetOffscreenBlend(BlendFuncSeparate);
+    worker_ = std::thread(&AsyncDashboardRenderer::WorkerMain, this);
+    return true;
+}
+
+void AsyncDashboardRenderer::Stop() {
+    if (!IsRunning()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    condition_.notify_all();
+    worker_.join();
+
+    // 合成端的 fence 在主线程上下文中创建，这里删除
+    for (int i = 0; i < kTargets; i++) {
+        if (consumed_fence_[i]) gl.DeleteSync(consumed_fence_[i]);
+        consumed_fence_[i] = nullptr;
+    }
+    glfwDestroyWindow(context_);
+    context_ = nullptr;
+}
+
+// ============ 主线程 ============
+void AsyncDashboardRenderer::Submit(const Dashboard& dashboard, int width, int height) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_) frames_dropped_.fetch_add(1, std::memory_order_relaxed);
+        staging_.CopyStateFrom(dashboard);
+        staging_width_ = width;
+        staging_height_ = height;
+        pending_ = true;
+    }
+    condition_.notify_all();
+}
+
+bool AsyncDashboardRenderer::Composite(int width, int height) {
+    int target;
+    void* ready;
+    unsigned int texture;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (front_ < 0) return false;
+        target = front_;
+        in_use_ = target;
+        ready = ready_fence_[target];
+        texture = texture_[target];
+    }
+
+    // GPU 端等待渲染线程的命令完成，不阻塞 CPU
+    if (ready) gl.WaitSync(ready, 0, kTimeoutIgnored);
+
+    glPushAttrib(GL_ALL_ATTRIB_BITS);
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0.0, width, height, 0.0, -1.0, 1.0);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_CULL_FACE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);   // 离屏结果为预乘 alpha
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+
+    // 离屏渲染使用相同的 y 向下投影，纹理上方 (t = 1) 对应屏幕顶部
+    glBegin(GL_QUADS);
+    glTexCoord2f(0.0f, 1.0f); glVertex2f(0.0f, 0.0f);
+    glTexCoord2f(1.0f, 1.0f); glVertex2f(static_cast<float>(width), 0.0f);
+    glTexCoord2f(1.0f, 0.0f); glVertex2f(static_cast<float>(width), static_cast<float>(height));
+    glTexCoord2f(0.0f, 0.0f); glVertex2f(0.0f, static_cast<float>(height));
+    glEnd();
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopAttrib();
+
+    void* consumed = gl.FenceSync(kSyncGpuCommandsComplete, 0);
+    glFlush();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (consumed_fence_[target]) gl.DeleteSync(consumed_fence_[target]);
+        consumed_fence_[target] = consumed;
+        in_use_ = -1;
+    }
+    condition_.notify_all();
+    return true;
+}
+
+DashboardFrameStats AsyncDashboardRenderer::LastFrameStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_stats_;
+}
+
+// ============ 渲染线程 ============
+void AsyncDashboardRenderer::WorkerMain() {
+    glfwMakeContextCurrent(context_);
+
+    while (true) {
+        int target;
+        int width, height;
+        void* consumed = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this] { return stop_ || pending_; });
+            if (stop_) break;
+
+            // 写入不是最近完成的那个纹理；主线程仍在合成它时等待
+            target = front_ == 0 ? 1 : 0;
+            condition_.wait(lock, [this, target] { return stop_ || in_use_ != target; });
+            if (stop_) break;
+
+            dashboard_.CopyStateFrom(staging_);
+            width = staging_width_;
+            height = staging_height_;
+            pending_ = false;
+
+            consumed = consumed_fence_[target];
+            consumed_fence_[target] = nullptr;
+            if (ready_fence_[target]) gl.DeleteSync(ready_fence_[target]);
+            ready_fence_[target] = nullptr;
+        }
+
+        // 主线程对该纹理的采样完成后再覆盖
+        if (consumed) {
+            gl.WaitSync(consumed, 0, kTimeoutIgnored);
+            gl.DeleteSync(consumed);
+        }
+        if (width <= 0 || height <= 0) continue;
+
+        // 显存超出上限时按面积比例缩小离屏目标；投影仍按窗口尺寸，画面整体缩放
+        int render_width = width, render_height = height;
+        size_t cap = memory_cap_.load(std::memory_order_relaxed);
+        double full = static_cast<double>(kTargets) * kBytesPerPixel * width * height;
+        if (cap > 0 && full > cap) {
+            double scale = sqrt(cap / full);
+            render_width = std::max(1, static_cast<int>(width * scale));
+            render_height = std::max(1, static_cast<int>(height * scale));
+        }
+        if (!PrepareTarget(target, render_width, render_height)) continue;
+
+        gl.BindFramebuffer(kFramebuffer, framebuffer_[target]);
+        glViewport(0, 0, render_width, render_height);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClearStencil(0);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+        dashboard_.Render(nullptr, width, height);
+        gl.BindFramebuffer(kFramebuffer, 0);
+
+        void* ready = gl.FenceSync(kSyncGpuCommandsComplete, 0);
+        glFlush();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ready_fence_[target] = ready;
+            front_ = target;
+            last_stats_ = dashboard_.GetFrameStats();
+        }
+        frames_rendered_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 释放渲染线程上下文中的资源
+    for (int i = 0; i < kTargets; i++) {
+        if (ready_fence_[i]) gl.DeleteSync(ready_fence_[i]);
+        ready_fence_[i] = nullptr;
+    }
+    ReleaseTargets();
+    dashboard_.ReleaseGLResources();
+    glFinish();
+    glfwMakeContextCurrent(nullptr);
+}
+
+bool AsyncDashboardRenderer::PrepareTarget(int target, int width, int height) {
+    if (framebuffer_[target] != 0 && target_width_[target] == width &&
+        target_height_[target] == height) {
+        return true;
+    }
+
+    if (framebuffer_[target] == 0) {
+        unsigned int texture;
+        glGenTextures(1, &texture);
+        gl.GenFramebuffers(1, &framebuffer_[target]);
+        gl.GenRenderbuffers(1, &depth_stencil_[target]);
+        std::lock_guard<std::mutex> lock(mutex_);
+        texture_[target] = texture;
+    }
+
+    // 颜色附件（纹理，与主上下文共享）+ 深度/模板（重绘调试需要模板）
+    glBindTexture(GL_TEXTURE_2D, texture_[target]);
+    glTexImage2D(GL_TEXTURE_2D, 0, kRgba8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    // 1:1 合成时线性过滤等同于逐像素复制；降分辨率时平滑放大
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, kClampToEdge);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, kClampToEdge);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    gl.BindRenderbuffer(kRenderbuffer, depth_stencil_[target]);
+    gl.RenderbufferStorage(kRenderbuffer, kDepth24Stencil8, width, height);
+    gl.BindRenderbuffer(kRenderbuffer, 0);
+
+    gl.BindFramebuffer(kFramebuffer, framebuffer_[target]);
+    gl.FramebufferTexture2D(kFramebuffer, kColorAttachment0, GL_TEXTURE_2D, texture_[target], 0);
+    gl.FramebufferRenderbuffer(kFramebuffer, kDepthStencilAttachment, kRenderbuffer,
+                               depth_stencil_[target]);
+    bool complete = gl.CheckFramebufferStatus(kFramebuffer) == kFramebufferComplete;
+    gl.BindFramebuffer(kFramebuffer, 0);
+    if (!complete) {
+        fprintf(stderr, "AsyncDashboardRenderer: incomplete framebuffer %dx%d\n", width, height);
+        return false;
+    }
+
+    target_width_[target] = width;
+    target_height_[target] = height;
+    size_t bytes = 0;
+    for (int i = 0; i < kTargets; i++) {
+        bytes += static_cast<size_t>(target_width_[i]) * target_height_[i] * kBytesPerPixel;
+    }
+    memory_bytes_.store(bytes, std::memory_order_relaxed);
+    return true;
+}
+
+void AsyncDashboardRenderer::ReleaseTargets() {
+    for (int i = 0; i < kTargets; i++) {
+        if (framebuffer_[i]) gl.DeleteFramebuffers(1, &framebuffer_[i]);
+        if (depth_stencil_[i]) gl.DeleteRenderbuffers(1, &depth_stencil_[i]);
+        if (texture_[i]) glDeleteTextures(1, &texture_[i]);
+        framebuffer_[i] = depth_stencil_[i] = texture_[i] = 0;
+        target_width_[i] = target_height_[i] = 0;
+    }
+    memory_bytes_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace mjpc
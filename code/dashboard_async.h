@@ -0,0 +1,96 @@
+#ifndef MJPC_DASHBOARD_ASYNC_H_
+#define MJPC_DASHBOARD_ASYNC_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "mjpc/dashboard.h"
+
+struct GLFWwindow;
+
+namespace mjpc {
+
+// ============ 异步仪表盘渲染 ============
+// 仪表盘在独立线程上绘制到离屏纹理（与主窗口共享对象的隐藏 GLFW 上下文），
+// 两个纹理轮换：渲染线程写一个，主线程合成另一个。主线程每帧只需
+//   dashboard.Update(m, d);
+//   async.Submit(dashboard, width, height);   // 复制状态，不等待
+//   ... mjr_render 场景 ...
+//   async.Composite(width, height);           // 一个贴图四边形
+// 仪表盘绘制与场景渲染并行，主线程开销与仪表盘复杂度无关。
+//
+// 同步：渲染线程完成一帧后插入 fence，主线程合成前在 GPU 端等待；
+// 主线程合成后插入 fence，渲染线程重用该纹理前等待，避免读写冲突。
+// 显示比仿真状态最多晚一帧。
+class AsyncDashboardRenderer {
+public:
+    AsyncDashboardRenderer() = default;
+    ~AsyncDashboardRenderer() { Stop(); }
+    AsyncDashboardRenderer(const AsyncDashboardRenderer&) = delete;
+    AsyncDashboardRenderer& operator=(const AsyncDashboardRenderer&) = delete;
+
+    // 主线程调用（GLFW 要求在主线程创建窗口），share 的上下文需为当前上下文。
+    // 驱动不支持 FBO 或 sync 对象时返回 false，调用方应回退到同步渲染。
+    bool Start(GLFWwindow* share);
+    // 停止渲染线程并释放离屏资源；主窗口上下文需为当前上下文
+    void Stop();
+    bool IsRunning() const { return worker_.joinable(); }
+
+    // 提交最新状态；渲染线程尚未取走的上一次提交会被覆盖（计入 FramesDropped）
+    void Submit(const Dashboard& dashboard, int width, int height);
+    // 把最近完成的一帧叠加到当前帧缓冲，还没有完成的帧时返回 false
+    bool Composite(int width, int height);
+
+    uint64_t FramesRendered() const { return frames_rendered_.load(std::memory_order_relaxed); }
+    uint64_t FramesDropped() const { return frames_dropped_.load(std::memory_order_relaxed); }
+    // 渲染线程最近一帧的统计
+    DashboardFrameStats LastFrameStats();
+
+    // 离屏目标占用的显存（颜色 RGBA8 + 深度/模板 D24S8，两个目标）
+    size_t MemoryBytes() const { return memory_bytes_.load(std::memory_order_relaxed); }
+    // 显存上限（0 为不限制）；超出时按比例降低离屏分辨率，合成时放大
+    void SetMemoryCap(size_t bytes) { memory_cap_.store(bytes, std::memory_order_relaxed); }
+
+private:
+    static constexpr int kTargets = 2;
+    static constexpr int kBytesPerPixel = 8;   // RGBA8 + D24S8
+
+    void WorkerMain();
+    bool PrepareTarget(int target, int width, int height);
+    void ReleaseTargets();
+
+    GLFWwindow* context_ = nullptr;    // 渲染线程的隐藏窗口
+    std::thread worker_;
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stop_ = false;
+    bool pending_ = false;
+    Dashboard staging_;                // 主线程提交的状态
+    int staging_width_ = 0, staging_height_ = 0;
+    int front_ = -1;                   // 最近完成的纹理
+    int in_use_ = -1;                  // 主线程正在合成的纹理
+    void* ready_fence_[kTargets] = {nullptr, nullptr};      // 渲染完成
+    void* consumed_fence_[kTargets] = {nullptr, nullptr};   // 合成完成
+    unsigned int texture_[kTargets] = {0, 0};                // 颜色附件，主线程合成时读取
+    DashboardFrameStats last_stats_;
+
+    // 渲染线程独占
+    Dashboard dashboard_;
+    unsigned int framebuffer_[kTargets] = {0, 0};
+    unsigned int depth_stencil_[kTargets] = {0, 0};
+    int target_width_[kTargets] = {0, 0};
+    int target_height_[kTargets] = {0, 0};
+
+    std::atomic<uint64_t> frames_rendered_{0};
+    std::atomic<uint64_t> frames_dropped_{0};
+    std::atomic<size_t> memory_bytes_{0};
+    std::atomic<size_t> memory_cap_{0};
+};
+
+}  // namespace mjpc
+
+#endif  // MJPC_DASHBOARD_ASYNC_H_
@@ -0,0 +1,223 @@
+#include "mjpc/dashboard_batch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+#include "mjpc/dashboard_data.h"
+#include "mjpc/dashboard_telemetry.h"
+#include "mjpc/fleet_telemetry.h"
+#include "mjpc/telemetry_recorder.h"
+#include "mjpc/threadpool.h"
+
+namespace mjpc {
+
+namespace {
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// 把角度包裹到 [-pi, pi]
+double WrapAngle(double angle) {
+    return atan2(sin(angle), cos(angle));
+}
+
+// 单回合：独立的 mjData、遥测积分器和随机数发生器
+EpisodeMetrics RunEpisode(const mjModel* m, int index, const BatchOptions& options,
+                          const EpisodeController& controller) {
+    EpisodeMetrics metrics;
+    metrics.episode = index;
+    metrics.seed = options.seed + static_cast<uint64_t>(index);
+
+    std::mt19937_64 rng(metrics.seed);
+    std::uniform_real_distribution<double> goal_dist(-options.goal_range, options.goal_range);
+    std::uniform_real_distribution<double> yaw_dist(-M_PI, M_PI);
+    double goal[2] = {goal_dist(rng), goal_dist(rng)};
+    double initial_yaw = yaw_dist(rng);
+    metrics.goal_x = goal[0];
+    metrics.goal_y = goal[1];
+
+    mjData* d = mj_makeData(m);
+    int key = mj_name2id(m, mjOBJ_KEY, "home");
+    if (key >= 0) {
+        mj_resetDataKeyframe(m, d, key);
+    } else {
+        mj_resetData(m, d);
+    }
+
+    // 目标点（mocap body "goal"）
+    int goal_body = mj_name2id(m, mjOBJ_BODY, "goal");
+    if (goal_body >= 0 && m->body_mocapid[goal_body] >= 0) {
+        double* mocap = d->mocap_pos + 3 * m->body_mocapid[goal_body];
+        mocap[0] = goal[0];
+        mocap[1] = goal[1];
+    }
+
+    // 随机初始朝向（车身自由关节）
+    TelemetryIntegrator telemetry;
+    DashboardData data;
+    telemetry.Step(m, d, &data);
+    int car_body = telemetry.CarBodyId();
+    int car_joint = m->body_jntadr[car_body];
+    if (car_joint >= 0 && m->jnt_type[car_joint] == mjJNT_FREE) {
+        double* q = d->qpos + m->jnt_qposadr[car_joint] + 3;
+        q[0] = cos(0.5 * initial_yaw);
+        q[1] = 0.0;
+        q[2] = 0.0;
+        q[3] = sin(0.5 * initial_yaw);
+    }
+    mj_forward(m, d);
+    telemetry.Reset();
+    telemetry.Step(m, d, &data);
+
+    TelemetryRecorder recorder;
+    if (!options.telemetry_dir.empty()) {
+        char path[1024];
+        snprintf(path, sizeof(path), "%s/episode_%d.mjtl", options.telemetry_dir.c_str(), index);
+        if (recorder.Open(path)) {
+            recorder.Record(d->time, data);
+        } else {
+            fprintf(stderr, "dashboard_batch: could not open %s\n", path);
+        }
+    }
+
+    FleetTelemetry fleet;
+    if (options.fleet_telemetry) fleet.Bind(m);
+
+    // ============ 仿真循环 ============
+    double speed_sum = 0.0;
+    bool warning_active = data.warning;
+    double timestep = m->opt.timestep;
+    while (d->time < options.max_time) {
+        controller(m, d, goal);
+        mj_step(m, d);
+        telemetry.Step(m, d, &data);
+        if (options.fleet_telemetry) fleet.Extract(d);
+        recorder.Record(d->time, data);
+        metrics.steps++;
+
+        speed_sum += data.speed_ms;
+        metrics.max_speed = std::max(metrics.max_speed, data.speed_ms);
+        for (int i = 0; i < m->nu; i++) {
+            metrics.energy += fabs(d->actuator_force[i] * d->actuator_velocity[i]) * timestep;
+        }
+        if (data.warning && !warning_active) metrics.warnings++;
+        warning_active = data.warning;
+
+        double dx = goal[0] - data.car_x;
+        double dy = goal[1] - data.car_y;
+        if (dx * dx + dy * dy < options.goal_radius * options.goal_radius) {
+            metrics.reached = true;
+            break;
+        }
+    }
+
+    metrics.sim_time = d->time;
+    metrics.time_to_goal = d->time;
+    metrics.mean_speed = metrics.steps > 0 ? speed_sum / metrics.steps : 0.0;
+
+    mj_deleteData(d);
+    return metrics;
+}
+
+}  // namespace
+
+// ============ 默认控制器 ============
+GoalPursuitController::GoalPursuitController(const mjModel* m) {
+    if (!m) return;
+    car_ = mj_name2id(m, mjOBJ_BODY, "car");
+    forward_ = mj_name2id(m, mjOBJ_ACTUATOR, "forward");
+    turn_ = mj_name2id(m, mjOBJ_ACTUATOR, "turn");
+}
+
+void GoalPursuitController::operator()(const mjModel* m, mjData* d, const double goal[2]) const {
+    if (!Valid()) return;
+
+    const double* pos = d->xpos + 3 * car_;
+    const double* quat = d->xquat + 4 * car_;
+    double yaw = atan2(2.0 * (quat[0] * quat[3] + quat[1] * quat[2]),
+                       1.0 - 2.0 * (quat[2] * quat[2] + quat[3] * quat[3]));
+
+    double dx = goal[0] - pos[0];
+    double dy = goal[1] - pos[1];
+    double distance = sqrt(dx * dx + dy * dy);
+    double heading_error = WrapAngle(atan2(dy, dx) - yaw);
+
+    // 先转向，再前进；距离越近油门越小
+    d->ctrl[forward_] = std::clamp(2.0 * distance * cos(heading_error), -1.0, 1.0);
+    d->ctrl[turn_] = std::clamp(1.5 * heading_error, -1.0, 1.0);
+}
+
+// ============ 批量运行 ============
+int RunDashboardBatch(const BatchOptions& options, BatchResult* result,
+                      std::string* error, const EpisodeController& controller) {
+    if (!result) return 1;
+
+    char load_error[1024] = "";
+    mjModel* m = mj_loadXML(options.model_path.c_str(), nullptr, load_error,
+                            sizeof(load_error));
+    if (!m) {
+        if (error) *error = load_error;
+        return 1;
+    }
+
+    int num_threads = options.num_threads;
+    if (num_threads <= 0) {
+        num_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    int num_episodes = std::max(options.num_episodes, 0);
+    const EpisodeController& control =
+        controller ? controller : EpisodeController(GoalPursuitController(m));
+
+    result->episodes.assign(num_episodes, EpisodeMetrics());
+    result->num_threads = num_threads;
+
+    // 每个回合写入各自的结果槽位，线程间无共享可变状态
+    auto start = std::chrono::steady_clock::now();
+    {
+        ThreadPool pool(num_threads);
+        for (int i = 0; i < num_episodes; i++) {
+            pool.Schedule([m, i, &options, &control, result]() {
+                result->episodes[i] = RunEpisode(m, i, options, control);
+            });
+        }
+        pool.WaitCount(num_episodes);
+        pool.ResetCount();
+    }
+    result->wall_seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double total_sim_time = 0.0;
+    for (const EpisodeMetrics& episode : result->episodes) {
+        total_sim_time += episode.sim_time;
+    }
+    if (result->wall_seconds > 0.0) {
+        result->episodes_per_second = num_episodes / result->wall_seconds;
+        result->sim_seconds_per_wall_second = total_sim_time / result->wall_seconds;
+    }
+
+    mj_deleteModel(m);
+    return 0;
+}
+
+// ============ CSV 输出 ============
+bool WriteBatchCsv(const std::string& path, const BatchResult& result) {
+    FILE* file = fopen(path.c_str(), "w");
+    if (!file) return false;
+
+    fprintf(file, "episode,seed,goal_x,goal_y,reached,time_to_goal,mean_speed,"
+                  "max_speed,energy,warnings,sim_time,steps\n");
+    for (const EpisodeMetrics& e : result.episodes) {
+        fprintf(file, "%d,%llu,%.4f,%.4f,%d,%.4f,%.4f,%.4f,%.6f,%d,%.4f,%d\n",
+                e.episode, static_cast<unsigned long long>(e.seed), e.goal_x, e.goal_y,
+                e.reached ? 1 : 0, e.time_to_goal, e.mean_speed, e.max_speed,
+                e.energy, e.warnings, e.sim_time, e.steps);
+    }
+    return fclose(file) == 0;
+}
+
+}  // namespace mjpc
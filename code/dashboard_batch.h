@@ -0,0 +1,85 @@
+#ifndef MJPC_DASHBOARD_BATCH_H_
+#define MJPC_DASHBOARD_BATCH_H_
+
+#include <mujoco/mujoco.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace mjpc {
+
+// ============ 无头批量回合评估 ============
+// 在线程池上并行运行 N 个相互独立的 mjData（共享同一个只读 mjModel），
+// 每个回合随机目标点和种子，逐物理步计算仪表盘遥测，汇总为每回合指标。
+
+// 批量运行参数
+struct BatchOptions {
+    std::string model_path;           // 场景文件（如 tasks/simple_car/task.xml）
+    int num_episodes = 64;            // 回合数
+    int num_threads = 0;              // 工作线程数，0 表示使用全部核心
+    double max_time = 20.0;           // 每回合最长仿真时间 (s)
+    double goal_radius = 0.1;         // 到达目标的判定半径 (m)
+    double goal_range = 2.5;          // 目标点在 [-range, range]^2 内均匀采样
+    uint64_t seed = 0;                // 基础种子，回合 i 使用 seed + i
+    std::string telemetry_dir;        // 非空时逐物理步记录遥测到 <dir>/episode_<i>.mjtl
+    bool fleet_telemetry = false;     // 逐物理步提取所有车辆的遥测（多车压力场景）
+};
+
+// 单回合指标
+struct EpisodeMetrics {
+    int episode = 0;
+    uint64_t seed = 0;
+    double goal_x = 0.0, goal_y = 0.0;
+    bool reached = false;             // 是否到达目标
+    double time_to_goal = 0.0;        // 到达时间，未到达时为回合总时长 (s)
+    double mean_speed = 0.0;          // 平均速度 (m/s)
+    double max_speed = 0.0;           // 最大速度 (m/s)
+    double energy = 0.0;              // 执行器机械功 sum |f * v| dt (J)
+    int warnings = 0;                 // 警告触发次数（上升沿）
+    double sim_time = 0.0;            // 实际仿真时间 (s)
+    int steps = 0;                    // 物理步数
+};
+
+// 批量结果
+struct BatchResult {
+    std::vector<EpisodeMetrics> episodes;
+    int num_threads = 0;
+    double wall_seconds = 0.0;
+    double episodes_per_second = 0.0;
+    double sim_seconds_per_wall_second = 0.0;
+};
+
+// 控制器：每个物理步之前写入 d->ctrl。goal 为当前回合目标 (x, y)。
+using EpisodeController =
+    std::function<void(const mjModel* m, mjData* d, const double goal[2])>;
+
+// 默认控制器：朝目标点的比例追踪（forward/turn 两个执行器）。
+// 构造时按名称查好车身和执行器编号，每步不再调用 mj_name2id；
+// 只能用于构造时的模型（或结构相同的模型）。
+class GoalPursuitController {
+public:
+    explicit GoalPursuitController(const mjModel* m);
+
+    bool Valid() const { return car_ >= 0 && forward_ >= 0 && turn_ >= 0; }
+    void operator()(const mjModel* m, mjData* d, const double goal[2]) const;
+
+private:
+    int car_ = -1;
+    int forward_ = -1;
+    int turn_ = -1;
+};
+
+// 运行批量评估；controller 为空时使用绑定到所加载模型的 GoalPursuitController。
+// 成功返回 0，模型加载失败返回 1（错误信息写入 error）。
+int RunDashboardBatch(const BatchOptions& options, BatchResult* result,
+                      std::string* error = nullptr,
+                      const EpisodeController& controller = nullptr);
+
+// 写出每回合汇总 CSV，成功返回 true
+bool WriteBatchCsv(const std::string& path, const BatchResult& result);
+
+}  // namespace mjpc
+
+#endif  // MJPC_DASHBOARD_BATCH_H_
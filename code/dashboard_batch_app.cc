@@ -0,0 +1,160 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <absl/flags/flag.h>
+#include <absl/flags/parse.h>
+
+#include "mjpc/dashboard_batch.h"
+#include "mjpc/stress_scene.h"
+
+ABSL_FLAG(std::string, mjcf, "mjpc/tasks/simple_car/task.xml",
+          "Scene to evaluate (SimpleCar task by default).");
+ABSL_FLAG(int, episodes, 64, "Number of independent episodes.");
+ABSL_FLAG(int, threads, 0, "Worker threads, 0 uses all cores.");
+ABSL_FLAG(double, max_time, 20.0, "Maximum simulated seconds per episode.");
+ABSL_FLAG(uint64_t, seed, 0, "Base seed; episode i uses seed + i.");
+ABSL_FLAG(std::string, csv, "dashboard_batch.csv", "Per-episode summary CSV.");
+ABSL_FLAG(std::string, telemetry_dir, "",
+          "If set, record per-step telemetry to <dir>/episode_<i>.mjtl.");
+ABSL_FLAG(std::vector<std::string>, cars, {},
+          "Scaling sweep: comma-separated vehicle counts (e.g. 1,10,100,1000). "
+          "Each count runs on a generated stress scene instead of --mjcf.");
+ABSL_FLAG(std::string, scene_dir, ".", "Directory for generated stress scenes.");
+ABSL_FLAG(std::string, scaling_csv, "dashboard_scaling.csv", "Scaling sweep summary CSV.");
+
+namespace {
+
+// ============ 车辆数扩展性扫描 ============
+// 每个车辆数生成一个压力场景，所有车辆朝各自目标追踪，逐步提取全部车辆遥测
+int RunScalingSweep(const mjpc::BatchOptions& base, const std::vector<std::string>& counts) {
+    FILE* csv = nullptr;
+    std::string csv_path = absl::GetFlag(FLAGS_scaling_csv);
+    if (!csv_path.empty()) {
+        csv = fopen(csv_path.c_str(), "w");
+        if (!csv) {
+            fprintf(stderr, "Failed to write %s\n", csv_path.c_str());
+            return 1;
+        }
+        fprintf(csv, "cars,episodes,wall_seconds,episodes_per_second,"
+                     "sim_seconds_per_wall_second,car_steps_per_second\n");
+    }
+
+    printf("%6s %10s %12s %14s %16s\n", "cars", "wall s", "episodes/s", "sim-s/wall-s",
+           "car-steps/s");
+    int status = 0;
+    for (const std::string& count : counts) {
+        char* end = nullptr;
+        long num_cars = std::strtol(count.c_str(), &end, 10);
+        if (end == count.c_str() || *end != '\0' || num_cars < 1) {
+            fprintf(stderr, "Invalid vehicle count '%s'\n", count.c_str());
+            status = 1;
+            break;
+        }
+
+        mjpc::StressSceneOptions scene;
+        scene.num_cars = static_cast<int>(num_cars);
+        mjpc::BatchOptions options = base;
+        options.model_path =
+            absl::GetFlag(FLAGS_scene_dir) + "/stress_" + std::to_string(num_cars) + ".xml";
+        options.fleet_telemetry = true;
+        if (!mjpc::WriteStressScene(options.model_path, scene)) {
+            fprintf(stderr, "Failed to write %s\n", options.model_path.c_str());
+            status = 1;
+            break;
+        }
+
+        // 控制器使用的对象编号与模型实例无关，先加载一次求出
+        char load_error[1024] = "";
+        mjModel* m = mj_loadXML(options.model_path.c_str(), nullptr, load_error,
+                                sizeof(load_error));
+        if (!m) {
+            fprintf(stderr, "Failed to load %s: %s\n", options.model_path.c_str(), load_error);
+            status = 1;
+            break;
+        }
+        mjpc::StressSceneIndex index;
+        index.Bind(m);
+        double timestep = m->opt.timestep;
+        mj_deleteModel(m);
+
+        mjpc::BatchResult result;
+        std::string error;
+        auto controller = [&index](const mjModel* model, mjData* d, const double*) {
+            mjpc::StressPursuitControl(d, index);
+        };
+        if (mjpc::RunDashboardBatch(options, &result, &error, controller) != 0) {
+            fprintf(stderr, "Failed to load %s: %s\n", options.model_path.c_str(), error.c_str());
+            status = 1;
+            break;
+        }
+
+        double car_steps = result.sim_seconds_per_wall_second / timestep * num_cars;
+        printf("%6ld %10.3f %12.2f %14.1f %16.0f\n", num_cars, result.wall_seconds,
+               result.episodes_per_second, result.sim_seconds_per_wall_second, car_steps);
+        if (csv) {
+            fprintf(csv, "%ld,%d,%.4f,%.4f,%.4f,%.1f\n", num_cars,
+                    static_cast<int>(result.episodes.size()), result.wall_seconds,
+                    result.episodes_per_second, result.sim_seconds_per_wall_second, car_steps);
+        }
+    }
+
+    if (csv && fclose(csv) != 0) status = 1;
+    if (csv && status == 0) printf("Scaling summary written to %s\n", csv_path.c_str());
+    return status;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    absl::ParseCommandLine(argc, argv);
+
+    mjpc::BatchOptions options;
+    options.model_path = absl::GetFlag(FLAGS_mjcf);
+    options.num_episodes = absl::GetFlag(FLAGS_episodes);
+    options.num_threads = absl::GetFlag(FLAGS_threads);
+    options.max_time = absl::GetFlag(FLAGS_max_time);
+    options.seed = absl::GetFlag(FLAGS_seed);
+    options.telemetry_dir = absl::GetFlag(FLAGS_telemetry_dir);
+
+    std::vector<std::string> cars = absl::GetFlag(FLAGS_cars);
+    if (!cars.empty()) return RunScalingSweep(options, cars);
+
+    mjpc::BatchResult result;
+    std::string error;
+    if (mjpc::RunDashboardBatch(options, &result, &error) != 0) {
+        fprintf(stderr, "Failed to load %s: %s\n", options.model_path.c_str(), error.c_str());
+        return 1;
+    }
+
+    int reached = 0;
+    double time_to_goal = 0.0;
+    for (const mjpc::EpisodeMetrics& episode : result.episodes) {
+        if (episode.reached) {
+            reached++;
+            time_to_goal += episode.time_to_goal;
+        }
+    }
+
+    printf("Episodes:            %d (%d threads)\n",
+           static_cast<int>(result.episodes.size()), result.num_threads);
+    printf("Reached goal:        %d\n", reached);
+    if (reached > 0) {
+        printf("Mean time to goal:   %.3f s\n", time_to_goal / reached);
+    }
+    printf("Wall time:           %.3f s\n", result.wall_seconds);
+    printf("Throughput:          %.2f episodes/s\n", result.episodes_per_second);
+    printf("Sim speed:           %.1f sim-s/wall-s\n", result.sim_seconds_per_wall_second);
+
+    std::string csv = absl::GetFlag(FLAGS_csv);
+    if (!csv.empty()) {
+        if (!mjpc::WriteBatchCsv(csv, result)) {
+            fprintf(stderr, "Failed to write %s\n", csv.c_str());
+            return 1;
+        }
+        printf("Summary written to %s\n", csv.c_str());
+    }
+    return 0;
+}
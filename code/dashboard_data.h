@@ -1,10 +1,14 @@
 #ifndef MJPC_DASHBOARD_DATA_H_
 #define MJPC_DASHBOARD_DATA_H_
 
-#include <string>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 namespace mjpc {
 
+class AlertRuleSet;
+
 struct DashboardData {
     // 车辆数据
     double speed_ms = 0.0;           // 速度 (m/s)
@@ -24,18 +28,81 @@ struct DashboardData {
     
     // 驾驶状态
     bool autopilot = false;           // 自动驾驶状态
-    bool warning = false;             // 警告状态
+    bool warning = false;             // 警告状态（有任一活动警报）
+    uint32_t alerts = 0;              // 活动警报位掩码，第 i 位对应 alert_rules 的第 i 条规则
+    const AlertRuleSet* alert_rules = nullptr;  // 警报名称（规则表由 TelemetryIntegrator 持有）
     
     // 其他（保持与旧代码兼容）
     double battery_level = 100.0;     // 电池电量 (%)
     double trip_distance = 0.0;       // 行程距离 (km) - 旧代码中的 distance
     double time_of_day = 0.0;         // 时间（模拟）- 旧代码中的 time
-    std::string mode = "MANUAL";      // 驾驶模式 - 旧代码中的 mode
+    const char* mode = "MANUAL";      // 驾驶模式 - 旧代码中的 mode（静态字符串）
     double max_rpm = 8000.0;          // 最大转速
     // 构造函数 - 可选，因为 C++11 的成员初始化已经足够
     DashboardData() = default;
 };
 
+// ============ 遥测快照（跨进程） ============
+// DashboardData 的定长 POD 版本，可以按字节复制到共享内存或网络缓冲。
+// 字段只追加不重排；布局变化时增加 kVersion。
+struct TelemetrySnapshot {
+    static constexpr uint32_t kVersion = 2;
+    static constexpr int kModeLength = 16;
+
+    uint64_t frame = 0;               // 发布序号（从 1 开始）
+    double time = 0.0;                // 仿真时间 (s)
+    double speed_ms = 0.0;
+    double speed_kmh = 0.0;
+    double rpm = 0.0;
+    double max_rpm = 0.0;
+    double fuel = 0.0;
+    double temperature = 0.0;
+    double throttle = 0.0;
+    double brake = 0.0;
+    double steering = 0.0;
+    double acceleration = 0.0;
+    double car_x = 0.0, car_y = 0.0, car_z = 0.0;
+    double car_heading = 0.0;
+    double battery_level = 0.0;
+    double trip_distance = 0.0;
+    int32_t gear = 0;
+    uint8_t autopilot = 0;
+    uint8_t warning = 0;
+    uint8_t reserved[2] = {};
+    char mode[kModeLength] = {};      // 以 0 结尾
+    uint32_t alerts = 0;              // 活动警报位掩码（位的含义见发布方的 AlertRuleSet）
+};
+static_assert(std::is_trivially_copyable<TelemetrySnapshot>::value,
+              "TelemetrySnapshot must stay trivially copyable");
+
+inline void FillTelemetrySnapshot(const DashboardData& data, double time, uint64_t frame,
+                                  TelemetrySnapshot* snapshot) {
+    snapshot->frame = frame;
+    snapshot->time = time;
+    snapshot->speed_ms = data.speed_ms;
+    snapshot->speed_kmh = data.speed_kmh;
+    snapshot->rpm = data.rpm;
+    snapshot->max_rpm = data.max_rpm;
+    snapshot->fuel = data.fuel;
+    snapshot->temperature = data.temperature;
+    snapshot->throttle = data.throttle;
+    snapshot->brake = data.brake;
+    snapshot->steering = data.steering;
+    snapshot->acceleration = data.acceleration;
+    snapshot->car_x = data.car_x;
+    snapshot->car_y = data.car_y;
+    snapshot->car_z = data.car_z;
+    snapshot->car_heading = data.car_heading;
+    snapshot->battery_level = data.battery_level;
+    snapshot->trip_distance = data.trip_distance;
+    snapshot->gear = data.gear;
+    snapshot->autopilot = data.autopilot ? 1 : 0;
+    snapshot->warning = data.warning ? 1 : 0;
+    snapshot->alerts = data.alerts;
+    std::strncpy(snapshot->mode, data.mode ? data.mode : "", TelemetrySnapshot::kModeLength - 1);
+    snapshot->mode[TelemetrySnapshot::kModeLength - 1] = '\0';
+}
+
 }  // namespace mjpc
 
 #endif  // MJPC_DASHBOARD_DATA_H_
@@ -0,0 +1,359 @@
+#include "mjpc/dashboard_perf.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+#include <nlohmann/json.hpp>
+
+#include "mjpc/alert_rules.h"
+#include "mjpc/drivetrain.h"
+#include "mjpc/fleet_telemetry.h"
+#include "mjpc/stress_scene.h"
+
+// ============ 分配计数 ============
+// 替换全局 operator new（普通和数组、含 nothrow 版本），统计堆分配次数；
+// 测量帧前后的差值即为热路径上的分配。对齐版本的 new 不经过这里。
+namespace {
+std::atomic<uint64_t> allocation_count{0};
+
+void* CountedAllocate(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+}  // namespace
+
+void* operator new(std::size_t size) {
+    void* p = CountedAllocate(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void* operator new[](std::size_t size) {
+    void* p = CountedAllocate(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return CountedAllocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return CountedAllocate(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+namespace mjpc {
+
+uint64_t PerfAllocationCount() {
+    return allocation_count.load(std::memory_order_relaxed);
+}
+
+namespace {
+
+// 场景数据：固定值，保证每次运行的几何完全一致
+DashboardData ScenarioData(const PerfScenario& scenario) {
+    DashboardData data;
+    data.speed_kmh = scenario.warning ? 135.0 : 72.0;
+    data.speed_ms = data.speed_kmh / 3.6;
+    data.rpm = scenario.warning ? 7400.0 : 5120.0;
+    data.fuel = 64.0;
+    data.temperature = scenario.warning ? 96.0 : 84.0;
+    data.gear = scenario.warning ? 6 : 4;
+    data.throttle = 0.6;
+    data.brake = 0.1;
+    data.steering = 0.2;
+    data.car_x = 1.2;
+    data.car_y = -0.8;
+    data.car_heading = 0.7;
+    data.autopilot = true;
+    data.mode = "AUTO";
+    data.warning = scenario.warning;
+    data.battery_level = 58.0;
+    return data;
+}
+
+}  // namespace
+
+std::vector<PerfScenario> DefaultPerfScenarios() {
+    std::vector<PerfScenario> scenarios(6);
+    scenarios[0].name = "fixed_dark";
+    scenarios[1].name = "follow_dark";
+    scenarios[1].follow_mode = Dashboard::FOLLOW_CAR_3D;
+    scenarios[2].name = "fixed_warning";
+    scenarios[2].warning = true;
+    scenarios[3].name = "fixed_light";
+    scenarios[3].dark_theme = false;
+    scenarios[4].name = "follow_light";
+    scenarios[4].follow_mode = Dashboard::FOLLOW_CAR_3D;
+    scenarios[4].dark_theme = false;
+    scenarios[5].name = "split_dark";
+    scenarios[5].viewports = 3;
+    return scenarios;
+}
+
+// ============ 测量 ============
+PerfMeasurement MeasureScenario(Dashboard* dashboard, const PerfScenario& scenario,
+                                int width, int height, int warmup, int frames) {
+    PerfMeasurement measurement;
+    measurement.scenario = scenario.name;
+    if (!dashboard || frames <= 0) return measurement;
+
+    // 先设置布局和数据，Initialize 据此计算跟随位置
+    dashboard->SetFollowCar(false);
+    dashboard->SetFollowMode(scenario.follow_mode);
+    dashboard->SetTheme(scenario.dark_theme);
+    dashboard->SetData(ScenarioData(scenario));
+    dashboard->Initialize(width, height);
+    std::vector<DashboardViewport> viewports;
+    for (int i = 0; i < scenario.viewports && scenario.viewports > 1; i++) {
+        DashboardViewport viewport;
+        viewport.left = width * i / scenario.viewports;
+        viewport.width = width * (i + 1) / scenario.viewports - viewport.left;
+        viewport.height = height;
+        viewports.push_back(viewport);
+    }
+    dashboard->SetViewports(viewports);
+
+    // 固定 60 fps 的动画步长，闪烁相位逐帧确定
+    const float frame_time = 1.0f / 60.0f;
+    std::vector<double> cpu_ms(frames);
+    uint64_t allocations_before = 0;
+    for (int i = 0; i < warmup + frames; i++) {
+        if (i == warmup) allocations_before = PerfAllocationCount();
+        dashboard->UpdateAnimation(frame_time);
+        dashboard->Render(nullptr, width, height);
+        if (i < warmup) continue;
+
+        const DashboardFrameStats& stats = dashboard->GetFrameStats();
+        cpu_ms[i - warmup] = stats.cpu_ms;
+        measurement.draw_calls = std::max(measurement.draw_calls, stats.draw_calls);
+        measurement.vertices = std::max(measurement.vertices, stats.vertices);
+    }
+
+    measurement.allocations = static_cast<int>(PerfAllocationCount() - allocations_before);
+
+    std::sort(cpu_ms.begin(), cpu_ms.end());
+    measurement.cpu_ms_median = cpu_ms[frames / 2];
+    measurement.cpu_ms_p95 = cpu_ms[std::min(frames - 1, frames * 95 / 100)];
+    return measurement;
+}
+
+// ============ 车辆数扩展性 ============
+FleetScalingMeasurement MeasureFleetScaling(Dashboard* dashboard, const std::string& scene_path,
+                                            int width, int height, int warmup, int frames,
+                                            int steps_per_frame) {
+    FleetScalingMeasurement measurement;
+    if (!dashboard || frames <= 0) return measurement;
+
+    char load_error[1024] = "";
+    mjModel* m = mj_loadXML(scene_path.c_str(), nullptr, load_error, sizeof(load_error));
+    if (!m) {
+        fprintf(stderr, "dashboard_perf: failed to load %s: %s\n", scene_path.c_str(), load_error);
+        return measurement;
+    }
+    mjData* d = mj_makeData(m);
+    int key = mj_name2id(m, mjOBJ_KEY, "home");
+    if (key >= 0) mj_resetDataKeyframe(m, d, key);
+    mj_forward(m, d);
+
+    StressSceneIndex index;
+    FleetTelemetry fleet;
+    index.Bind(m);
+    fleet.Bind(m, "car");
+    measurement.num_cars = fleet.NumVehicles();
+
+    // 每辆车一份传动系统状态，共享同一组查表
+    const DrivetrainTables drivetrain;
+    const int num_wheels = index.NumCars();
+    std::vector<DrivetrainInput> drivetrain_inputs(num_wheels);
+    std::vector<DrivetrainState> drivetrain_states(num_wheels, drivetrain.InitialState());
+    // 每辆车一份警报状态，共享默认规则表
+    const AlertRuleSet alert_rules;
+    std::vector<AlertSignals> alert_signals(num_wheels);
+    std::vector<AlertState> alert_states(num_wheels);
+    const double tank = drivetrain.Spec().tank_liters;
+
+    dashboard->Initialize(width, height);
+    dashboard->SetFleetTelemetry(&fleet);
+
+    using Clock = std::chrono::steady_clock;
+    auto ms = [](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+    std::vector<double> physics_ms(frames), drivetrain_ms(frames), alerts_ms(frames),
+        extract_ms(frames), update_ms(frames), render_ms(frames), frame_ms(frames);
+    for (int i = 0; i < warmup + frames; i++) {
+        auto t0 = Clock::now();
+        double frame_drivetrain_ms = 0.0, frame_alerts_ms = 0.0;
+        for (int step = 0; step < steps_per_frame; step++) {
+            StressPursuitControl(d, index);
+            mj_step(m, d);
+            auto s0 = Clock::now();
+            for (int car = 0; car < num_wheels; car++) {
+                ReadWheels(index.wheels[car], d, &drivetrain_inputs[car]);
+            }
+            drivetrain.Step(drivetrain_inputs.data(), num_wheels, m->opt.timestep,
+                            drivetrain_states.data());
+            auto s1 = Clock::now();
+            for (int car = 0; car < num_wheels; car++) {
+                const DrivetrainState& state = drivetrain_states[car];
+                const double* v = d->qvel + m->body_dofadr[index.car_body[car]];
+                double* signal = alert_signals[car].value;
+                signal[ALERT_SPEED_MS] = std::sqrt(v[0] * v[0] + v[1] * v[1]);
+                signal[ALERT_SPEED_KMH] = signal[ALERT_SPEED_MS] * 3.6;
+                signal[ALERT_RPM] = state.rpm;
+                signal[ALERT_FUEL] = 100.0 * state.fuel_liters / tank;
+                signal[ALERT_TEMPERATURE] = state.temperature;
+                signal[ALERT_THROTTLE] = state.throttle;
+                signal[ALERT_BRAKE] = state.brake;
+            }
+            alert_rules.Evaluate(alert_signals.data(), num_wheels, m->opt.timestep,
+                                 alert_states.data());
+            auto s2 = Clock::now();
+            frame_drivetrain_ms += ms(s0, s1);
+            frame_alerts_ms += ms(s1, s2);
+        }
+        uint64_t allocations_before = PerfAllocationCount();
+        auto t1 = Clock::now();
+        fleet.Extract(d);
+        auto t2 = Clock::now();
+        dashboard->Update(m, d);
+        auto t3 = Clock::now();
+        dashboard->Render(nullptr, width, height);
+        auto t4 = Clock::now();
+        if (i < warmup) continue;
+        measurement.allocations += static_cast<int>(PerfAllocationCount() - allocations_before);
+
+        int frame = i - warmup;
+        physics_ms[frame] = ms(t0, t1) - frame_drivetrain_ms - frame_alerts_ms;
+        drivetrain_ms[frame] = frame_drivetrain_ms;
+        alerts_ms[frame] = frame_alerts_ms;
+        extract_ms[frame] = ms(t1, t2);
+        update_ms[frame] = ms(t2, t3);
+        render_ms[frame] = ms(t3, t4);
+        frame_ms[frame] = ms(t0, t4);
+    }
+    dashboard->SetFleetTelemetry(nullptr);
+
+    auto median = [](std::vector<double>& values) {
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    };
+    measurement.physics_ms = median(physics_ms);
+    measurement.drivetrain_ns_per_car =
+        median(drivetrain_ms) * 1e6 / std::max(num_wheels * steps_per_frame, 1);
+    measurement.alerts_ns_per_car =
+        median(alerts_ms) * 1e6 / std::max(num_wheels * steps_per_frame, 1);
+    measurement.extract_ns_per_car =
+        median(extract_ms) * 1e6 / std::max(measurement.num_cars, 1);
+    measurement.update_ms = median(update_ms);
+    measurement.render_ms = median(render_ms);
+    measurement.frame_ms_median = median(frame_ms);
+    measurement.frame_ms_p95 = frame_ms[std::min(frames - 1, frames * 95 / 100)];
+
+    mj_deleteData(d);
+    mj_deleteModel(m);
+    return measurement;
+}
+
+// ============ 预算和基线检查 ============
+bool CheckPerf(const PerfMeasurement& measurement, const PerfBudget& budget,
+               const PerfMeasurement* baseline, const PerfTolerance& tolerance,
+               std::vector<std::string>* failures) {
+    bool ok = true;
+    char message[256];
+    auto fail = [&]() {
+        ok = false;
+        if (failures) failures->push_back(message);
+    };
+    const char* name = measurement.scenario.c_str();
+
+    // 绝对预算
+    if (measurement.cpu_ms_p95 > budget.cpu_ms) {
+        snprintf(message, sizeof(message), "%s: p95 CPU %.3f ms > budget %.3f ms",
+                 name, measurement.cpu_ms_p95, budget.cpu_ms);
+        fail();
+    }
+    if (measurement.draw_calls > budget.draw_calls) {
+        snprintf(message, sizeof(message), "%s: %d draw calls > budget %d",
+                 name, measurement.draw_calls, budget.draw_calls);
+        fail();
+    }
+    if (measurement.vertices > budget.vertices) {
+        snprintf(message, sizeof(message), "%s: %d vertices > budget %d",
+                 name, measurement.vertices, budget.vertices);
+        fail();
+    }
+    if (measurement.allocations > budget.allocations) {
+        snprintf(message, sizeof(message), "%s: %d heap allocations after warm-up > budget %d",
+                 name, measurement.allocations, budget.allocations);
+        fail();
+    }
+    if (!baseline) return ok;
+
+    // 相对基线
+    if (baseline->cpu_ms_median > 0.0 &&
+        measurement.cpu_ms_median > baseline->cpu_ms_median * (1.0 + tolerance.cpu)) {
+        snprintf(message, sizeof(message), "%s: median CPU %.3f ms regressed from baseline %.3f ms",
+                 name, measurement.cpu_ms_median, baseline->cpu_ms_median);
+        fail();
+    }
+    if (measurement.draw_calls > baseline->draw_calls * (1.0 + tolerance.counts)) {
+        snprintf(message, sizeof(message), "%s: %d draw calls regressed from baseline %d",
+                 name, measurement.draw_calls, baseline->draw_calls);
+        fail();
+    }
+    if (measurement.vertices > baseline->vertices * (1.0 + tolerance.counts)) {
+        snprintf(message, sizeof(message), "%s: %d vertices regressed from baseline %d",
+                 name, measurement.vertices, baseline->vertices);
+        fail();
+    }
+    return ok;
+}
+
+// ============ 基线文件 ============
+bool LoadPerfBaseline(const std::string& path,
+                      std::map<std::string, PerfMeasurement>* baseline) {
+    std::ifstream file(path);
+    if (!file || !baseline) return false;
+
+    nlohmann::json json = nlohmann::json::parse(file, nullptr, false);
+    if (json.is_discarded() || !json.contains("scenarios")) return false;
+
+    for (const auto& entry : json["scenarios"]) {
+        PerfMeasurement measurement;
+        measurement.scenario = entry.value("name", "");
+        measurement.cpu_ms_median = entry.value("cpu_ms_median", 0.0);
+        measurement.cpu_ms_p95 = entry.value("cpu_ms_p95", 0.0);
+        measurement.draw_calls = entry.value("draw_calls", 0);
+        measurement.vertices = entry.value("vertices", 0);
+        (*baseline)[measurement.scenario] = measurement;
+    }
+    return true;
+}
+
+bool SavePerfBaseline(const std::string& path,
+                      const std::vector<PerfMeasurement>& measurements) {
+    nlohmann::json scenarios = nlohmann::json::array();
+    for (const PerfMeasurement& measurement : measurements) {
+        scenarios.push_back({
+            {"name", measurement.scenario},
+            {"cpu_ms_median", measurement.cpu_ms_median},
+            {"cpu_ms_p95", measurement.cpu_ms_p95},
+            {"draw_calls", measurement.draw_calls},
+            {"vertices", measurement.vertices},
+        });
+    }
+
+    std::ofstream file(path);
+    if (!file) return false;
+    file << nlohmann::json{{"scenarios", scenarios}}.dump(2) << "\n";
+    return static_cast<bool>(file);
+}
+
+}  // namespace mjpc
@@ -0,0 +1,96 @@
+#ifndef MJPC_DASHBOARD_PERF_H_
+#define MJPC_DASHBOARD_PERF_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "mjpc/dashboard.h"
+
+namespace mjpc {
+
+// ============ 仪表盘性能回归 ============
+// 在固定场景下离屏渲染仪表盘，统计每帧 CPU 耗时、批次数和顶点数，
+// 与预算以及保存的基线（带容差）比较。调用方负责提供当前 GL 上下文。
+
+// 固定测试场景
+struct PerfScenario {
+    std::string name;
+    Dashboard::FollowMode follow_mode = Dashboard::FIXED_SCREEN;
+    bool warning = false;      // 激活警告（超速 + 红区）
+    bool dark_theme = true;
+    int viewports = 1;         // 大于 1 时横向等分窗口，每个视口显示整个布局
+};
+
+// 每帧预算
+struct PerfBudget {
+    double cpu_ms = 4.0;
+    int draw_calls = 400;
+    int vertices = 6000;
+    int allocations = 0;       // 预热之后测量帧内的堆分配次数
+};
+
+// 基线比较容差（相对值）
+struct PerfTolerance {
+    double cpu = 0.25;         // CPU 耗时允许比基线慢 25%
+    double counts = 0.05;      // 批次/顶点允许比基线多 5%
+};
+
+// 一个场景的测量结果
+struct PerfMeasurement {
+    std::string scenario;
+    double cpu_ms_median = 0.0;
+    double cpu_ms_p95 = 0.0;
+    int draw_calls = 0;        // 所有测量帧中的最大值
+    int vertices = 0;          // 所有测量帧中的最大值
+    int allocations = 0;       // 测量帧内的堆分配总次数（不写入基线）
+};
+
+// 本进程累计的 operator new 次数（dashboard_perf 替换了全局 operator new）
+uint64_t PerfAllocationCount();
+
+// 默认场景：固定/跟随布局、警告、明/暗主题、三分屏
+std::vector<PerfScenario> DefaultPerfScenarios();
+
+// 渲染 warmup + frames 帧，统计后 frames 帧
+PerfMeasurement MeasureScenario(Dashboard* dashboard, const PerfScenario& scenario,
+                                int width, int height, int warmup, int frames);
+
+// ============ 车辆数扩展性 ============
+// 每帧推进 steps_per_frame 个物理步（所有车辆朝各自目标追踪，每步之后推进
+// 所有车辆的传动系统模型并求值警报规则），然后提取车队遥测、更新并渲染仪表盘；各阶段分别
+// 计时（中位数）。
+struct FleetScalingMeasurement {
+    int num_cars = 0;                 // 0 表示场景加载失败
+    double physics_ms = 0.0;          // 每帧物理步（不含传动系统）
+    double drivetrain_ns_per_car = 0.0;  // 每个物理步每辆车的 ReadWheels + 传动系统 Step
+    double alerts_ns_per_car = 0.0;   // 每个物理步每辆车的警报信号填充 + 求值
+    double extract_ns_per_car = 0.0;  // FleetTelemetry::Extract 每辆车
+    double update_ms = 0.0;           // Dashboard::Update
+    double render_ms = 0.0;           // Dashboard::Render
+    double frame_ms_median = 0.0;     // 以上合计
+    double frame_ms_p95 = 0.0;
+    int allocations = 0;              // 测量帧内提取、更新和渲染的堆分配次数
+};
+
+// scene_path 为 StressSceneXml 生成的场景
+FleetScalingMeasurement MeasureFleetScaling(Dashboard* dashboard, const std::string& scene_path,
+                                            int width, int height, int warmup, int frames,
+                                            int steps_per_frame);
+
+// 检查预算和基线（baseline 可为空），失败原因追加到 failures，返回是否通过。
+// 基线中 cpu_ms_median <= 0 表示该机器上没有记录 CPU 基线，只比较计数。
+bool CheckPerf(const PerfMeasurement& measurement, const PerfBudget& budget,
+               const PerfMeasurement* baseline, const PerfTolerance& tolerance,
+               std::vector<std::string>* failures);
+
+// 基线文件（JSON，按场景名索引）
+bool LoadPerfBaseline(const std::string& path,
+                      std::map<std::string, PerfMeasurement>* baseline);
+bool SavePerfBaseline(const std::string& path,
+                      const std::vector<PerfMeasurement>& measurements);
+
+}  // namespace mjpc
+
+#endif  // MJPC_DASHBOARD_PERF_H_
@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <absl/flags/flag.h>
+#include <absl/flags/parse.h>
+#include <GLFW/glfw3.h>
+
+#include "mjpc/dashboard.h"
+#include "mjpc/dashboard_async.h"
+#include "mjpc/dashboard_perf.h"
+#include "mjpc/frame_capture.h"
+#include "mjpc/stress_scene.h"
+
+ABSL_FLAG(std::string, baseline, "", "Baseline JSON to compare against.");
+ABSL_FLAG(bool, update_baseline, false, "Write the measurements to --baseline.");
+ABSL_FLAG(int, width, 1280, "Offscreen framebuffer width.");
+ABSL_FLAG(int, height, 720, "Offscreen framebuffer height.");
+ABSL_FLAG(int, warmup, 30, "Frames rendered before measuring.");
+ABSL_FLAG(int, frames, 300, "Frames measured per scenario.");
+ABSL_FLAG(bool, async, false, "Also report main-thread cost with the async renderer.");
+ABSL_FLAG(std::string, capture_dir, "",
+          "Also report main-thread cost of capturing every frame to PNGs in this directory.");
+ABSL_FLAG(std::vector<std::string>, fleet_sweep, {},
+          "Comma-separated vehicle counts (e.g. 1,10,100,1000): report frame time "
+          "on generated stress scenes.");
+ABSL_FLAG(std::string, scene_dir, ".", "Directory for generated stress scenes.");
+ABSL_FLAG(int, steps_per_frame, 8, "Physics steps per frame in the fleet sweep.");
+
+// CTest 将此返回值视为跳过（没有可用的 GL 上下文）
+constexpr int kSkipReturnCode = 77;
+
+int main(int argc, char** argv) {
+    absl::ParseCommandLine(argc, argv);
+    int width = absl::GetFlag(FLAGS_width);
+    int height = absl::GetFlag(FLAGS_height);
+
+    // ============ 离屏 GL 上下文（隐藏窗口） ============
+    if (!glfwInit()) {
+        fprintf(stderr, "dashboard_perf: could not initialize GLFW, skipping\n");
+        return kSkipReturnCode;
+    }
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* window = glfwCreateWindow(width, height, "dashboard_perf", nullptr, nullptr);
+    if (!window) {
+        fprintf(stderr, "dashboard_perf: could not create a GL context, skipping\n");
+        glfwTerminate();
+        return kSkipReturnCode;
+    }
+    glfwMakeContextCurrent(window);
+    glViewport(0, 0, width, height);
+
+    // ============ 测量 ============
+    std::string baseline_path = absl::GetFlag(FLAGS_baseline);
+    std::map<std::string, mjpc::PerfMeasurement> baseline;
+    bool have_baseline = !baseline_path.empty() && !absl::GetFlag(FLAGS_update_baseline) &&
+                         mjpc::LoadPerfBaseline(baseline_path, &baseline);
+
+    mjpc::PerfBudget budget;
+    mjpc::PerfTolerance tolerance;
+    std::vector<mjpc::PerfMeasurement> measurements;
+    std::vector<std::string> failures;
+
+    printf("%-16s %10s %10s %8s %8s %8s %8s\n", "scenario", "median ms", "p95 ms", "draws", "verts",
+           "mem KB", "allocs");
+    for (const mjpc::PerfScenario& scenario : mjpc::DefaultPerfScenarios()) {
+        mjpc::Dashboard dashboard;
+        mjpc::PerfMeasurement measurement = mjpc::MeasureScenario(
+            &dashboard, scenario, width, height,
+            absl::GetFlag(FLAGS_warmup), absl::GetFlag(FLAGS_frames));
+        glFinish();
+        glfwSwapBuffers(window);
+
+        printf("%-16s %10.3f %10.3f %8d %8d %8zu %8d\n", measurement.scenario.c_str(),
+               measurement.cpu_ms_median, measurement.cpu_ms_p95,
+               measurement.draw_calls, measurement.vertices,
+               dashboard.GetMemoryUsage().Total() / 1024, measurement.allocations);
+
+        auto it = baseline.find(measurement.scenario);
+        const mjpc::PerfMeasurement* reference =
+            (have_baseline && it != baseline.end()) ? &it->second : nullptr;
+        mjpc::CheckPerf(measurement, budget, reference, tolerance, &failures);
+        measurements.push_back(measurement);
+    }
+
+    // ============ 异步渲染：主线程只提交状态并合成一个四边形 ============
+    if (absl::GetFlag(FLAGS_async)) {
+        mjpc::Dashboard dashboard;
+        mjpc::PerfScenario scenario = mjpc::DefaultPerfScenarios().front();
+        mjpc::MeasureScenario(&dashboard, scenario, width, height, 0, 1);
+        
+        mjpc::AsyncDashboardRenderer async;
+        if (async.Start(window)) {
+            int frames = absl::GetFlag(FLAGS_frames);
+            std::vector<double> main_ms;
+            for (int i = 0; i < absl::GetFlag(FLAGS_warmup) + frames; i++) {
+                auto start = std::chrono::steady_clock::now();
+                dashboard.UpdateAnimation(1.0f / 60.0f);
+                async.Submit(dashboard, width, height);
+                async.Composite(width, height);
+                glFinish();
+                if (i >= absl::GetFlag(FLAGS_warmup)) {
+                    main_ms.push_back(std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - start).count());
+                }
+            }
+            async.Stop();
+            if (!main_ms.empty()) {
+                std::sort(main_ms.begin(), main_ms.end());
+                printf("%-16s %10.3f %10.3f  (main thread; %llu rendered, %llu dropped)\n",
+                       "async", main_ms[main_ms.size() / 2],
+                       main_ms[std::min(main_ms.size() - 1, main_ms.size() * 95 / 100)],
+                       static_cast<unsigned long long>(async.FramesRendered()),
+                       static_cast<unsigned long long>(async.FramesDropped()));
+            }
+        } else {
+            fprintf(stderr, "dashboard_perf: async renderer unavailable\n");
+        }
+    }
+
+    // ============ 帧捕获：主线程只发起读回，编码在线程池中 ============
+    std::string capture_dir = absl::GetFlag(FLAGS_capture_dir);
+    if (!capture_dir.empty()) {
+        mjpc::Dashboard dashboard;
+        mjpc::PerfScenario scenario = mjpc::DefaultPerfScenarios().front();
+        mjpc::MeasureScenario(&dashboard, scenario, width, height, 0, 1);
+
+        mjpc::FrameCapture capture;
+        mjpc::FrameCaptureOptions options;
+        options.directory = capture_dir;
+        if (capture.Start(options)) {
+            int frames = absl::GetFlag(FLAGS_frames);
+            std::vector<double> main_ms;
+            for (int i = 0; i < absl::GetFlag(FLAGS_warmup) + frames; i++) {
+                auto start = std::chrono::steady_clock::now();
+                dashboard.UpdateAnimation(1.0f / 60.0f);
+                dashboard.Render(nullptr, width, height);
+                capture.Capture(0, 0, width, height);
+                // 只计主线程发起渲染和读回的耗时；glFinish 等待 GPU，放在计时之外
+                auto end = std::chrono::steady_clock::now();
+                glFinish();
+                if (i >= absl::GetFlag(FLAGS_warmup)) {
+                    main_ms.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+                }
+            }
+            capture.Stop();
+            if (!main_ms.empty()) {
+                std::sort(main_ms.begin(), main_ms.end());
+                printf("%-16s %10.3f %10.3f  (main thread; %llu captured, %llu written, %llu dropped)\n",
+                       "capture", main_ms[main_ms.size() / 2],
+                       main_ms[std::min(main_ms.size() - 1, main_ms.size() * 95 / 100)],
+                       static_cast<unsigned long long>(capture.FramesCaptured()),
+                       static_cast<unsigned long long>(capture.FramesWritten()),
+                       static_cast<unsigned long long>(capture.FramesDropped()));
+            }
+            if (capture.WriteErrors() > 0) {
+                failures.push_back("capture: " + std::to_string(capture.WriteErrors()) +
+                                   " frames could not be written to " + capture_dir);
+            }
+        } else {
+            fprintf(stderr, "dashboard_perf: frame capture unavailable\n");
+        }
+    }
+
+    // ============ 车辆数扩展性：生成的多车场景上的帧时间 ============
+    std::vector<std::string> fleet_sweep = absl::GetFlag(FLAGS_fleet_sweep);
+    if (!fleet_sweep.empty()) {
+        printf("\n%6s %10s %12s %13s %14s %10s %10s %10s %10s %8s\n", "cars", "physics",
+               "drive ns/car", "alert ns/car", "extract ns/car", "update", "render", "frame ms",
+               "p95 ms", "allocs");
+    }
+    for (const std::string& count : fleet_sweep) {
+        char* end = nullptr;
+        long num_cars = std::strtol(count.c_str(), &end, 10);
+        if (end == count.c_str() || *end != '\0' || num_cars < 1) {
+            failures.push_back("invalid vehicle count '" + count + "'");
+            break;
+        }
+        mjpc::StressSceneOptions scene;
+        scene.num_cars = static_cast<int>(num_cars);
+        std::string path =
+            absl::GetFlag(FLAGS_scene_dir) + "/stress_" + std::to_string(num_cars) + ".xml";
+        if (!mjpc::WriteStressScene(path, scene)) {
+            failures.push_back("could not write " + path);
+            break;
+        }
+
+        mjpc::Dashboard dashboard;
+        mjpc::FleetScalingMeasurement measurement = mjpc::MeasureFleetScaling(
+            &dashboard, path, width, height, absl::GetFlag(FLAGS_warmup),
+            absl::GetFlag(FLAGS_frames), absl::GetFlag(FLAGS_steps_per_frame));
+        glFinish();
+        glfwSwapBuffers(window);
+        if (measurement.num_cars == 0) {
+            failures.push_back("could not load " + path);
+            break;
+        }
+        printf("%6d %10.3f %12.1f %13.1f %14.1f %10.3f %10.3f %10.3f %10.3f %8d\n",
+               measurement.num_cars, measurement.physics_ms, measurement.drivetrain_ns_per_car,
+               measurement.alerts_ns_per_car, measurement.extract_ns_per_car, measurement.update_ms,
+               measurement.render_ms, measurement.frame_ms_median, measurement.frame_ms_p95,
+               measurement.allocations);
+        // 更新和渲染路径在预热之后不应分配内存
+        if (measurement.allocations > budget.allocations) {
+            failures.push_back("fleet_" + count + ": " + std::to_string(measurement.allocations) +
+                               " heap allocations after warm-up in update/render");
+        }
+    }
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+
+    if (absl::GetFlag(FLAGS_update_baseline)) {
+        if (!mjpc::SavePerfBaseline(baseline_path, measurements)) {
+            fprintf(stderr, "dashboard_perf: failed to write %s\n", baseline_path.c_str());
+            return 1;
+        }
+        printf("Baseline written to %s\n", baseline_path.c_str());
+    }
+
+    for (const std::string& failure : failures) {
+        fprintf(stderr, "FAIL %s\n", failure.c_str());
+    }
+    return failures.empty() ? 0 : 1;
+}
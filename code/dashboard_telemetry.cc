@@ -0,0 +1,177 @@
+#include "mjpc/dashboard_telemetry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace mjpc {
+
+namespace {
+
+// 消耗速率（按仿真秒计）。原实现按每帧扣减，这里换算为 60 fps 下的等效值。
+constexpr double kBatteryPerSecond = 0.03;  // % / s（静止时）
+
+}  // namespace
+
+void TelemetryIntegrator::Reset() {
+    has_time_ = false;
+    last_time_ = 0.0;
+    last_speed_ = 0.0;
+    last_motion_time_ = -1.0;
+    drivetrain_state_ = drivetrain_.InitialState();
+    alert_state_ = AlertState();
+    battery_ = 95.0;
+    trip_km_ = 0.0;
+}
+
+void TelemetryIntegrator::BindModel(const mjModel* m) {
+    model_ = m;
+    car_body_id_ = 0;
+    if (m->nbody > 1) {
+        // 查找名为"car"或"chassis"的body
+        for (int i = 0; i < m->nbody; i++) {
+            const char* name = mj_id2name(m, mjOBJ_BODY, i);
+            if (name && (strstr(name, "car") || strstr(name, "chassis") || strstr(name, "body"))) {
+                car_body_id_ = i;
+                break;
+            }
+        }
+    }
+    wheels_ = BindWheels(m);
+    Reset();
+}
+
+void TelemetryIntegrator::SetDrivetrain(const DrivetrainSpec& spec) {
+    drivetrain_ = DrivetrainTables(spec);
+    drivetrain_state_ = drivetrain_.InitialState();
+}
+
+bool TelemetryIntegrator::SetAlertRules(const std::string& rules, std::string* error) {
+    if (!alert_rules_.Compile(rules, error)) return false;
+    // 位的含义变了，旧状态作废
+    alert_state_ = AlertState();
+    return true;
+}
+
+double TelemetryIntegrator::Step(const mjModel* m, const mjData* d, DashboardData* data,
+                                 uint32_t groups) {
+    if (!m || !d || !data) return 0.0;
+    if (m != model_) BindModel(m);
+
+    // ============ 仿真时间增量 ============
+    double delta_time = 0.0;
+    if (has_time_) {
+        delta_time = d->time - last_time_;
+        if (delta_time < 0.0) {
+            // 仿真被重置
+            Reset();
+            delta_time = 0.0;
+        }
+    }
+    has_time_ = true;
+    last_time_ = d->time;
+
+    // ============ 传动系统（每次推进） ============
+    DrivetrainInput wheels;
+    double steer = 0.0;
+    ReadWheels(wheels_, d, &wheels, &steer);
+    drivetrain_.Step(wheels, delta_time, &drivetrain_state_);
+
+    // ============ 车速（每次推进） ============
+    AlertSignals signals;
+    double* signal = signals.value;
+    int car_dof = m->body_dofadr[car_body_id_];
+    if (car_dof >= 0 && car_dof + 2 < m->nv) {
+        signal[ALERT_SPEED_MS] = sqrt(d->qvel[car_dof] * d->qvel[car_dof] +
+                                      d->qvel[car_dof + 1] * d->qvel[car_dof + 1]);
+    }
+    signal[ALERT_SPEED_KMH] = signal[ALERT_SPEED_MS] * 3.6;
+
+    // ============ 积分量（按本步车速，与运动字段的刷新频率无关） ============
+    battery_ -= kBatteryPerSecond * (1.0 + signal[ALERT_SPEED_KMH] / 80.0) * delta_time;
+    if (battery_ < 20.0) battery_ = 95.0;
+    trip_km_ += signal[ALERT_SPEED_MS] * delta_time / 1000.0;
+
+    // ============ 警报（每次推进，与字段刷新频率无关） ============
+    signal[ALERT_RPM] = drivetrain_state_.rpm;
+    signal[ALERT_FUEL] = 100.0 * drivetrain_state_.fuel_liters /
+                         std::max(drivetrain_.Spec().tank_liters, 1e-6);
+    signal[ALERT_TEMPERATURE] = drivetrain_state_.temperature;
+    signal[ALERT_BATTERY] = battery_;
+    signal[ALERT_THROTTLE] = drivetrain_state_.throttle;
+    signal[ALERT_BRAKE] = drivetrain_state_.brake;
+    signal[ALERT_STEERING] = steer;
+    alert_rules_.Evaluate(signals, delta_time, &alert_state_);
+    if (alert_state_.raised | alert_state_.cleared) {
+        alert_log_.Record(alert_rules_, signals, alert_state_, d->time);
+    }
+
+    // ============ 运动：位置、速度、转速、档位 ============
+    if (groups & TELEMETRY_MOTION) {
+        // 位置用车身第一个关节的 qpos 地址（自由关节 qpos 为 7 维、qvel 为 6 维，两者不同）
+        int car_joint = m->body_jntadr[car_body_id_];
+        int qpos_adr = car_joint >= 0 ? m->jnt_qposadr[car_joint] : -1;
+        if (qpos_adr >= 0 && qpos_adr + 2 < m->nq) {
+            data->car_x = d->qpos[qpos_adr];
+            data->car_y = d->qpos[qpos_adr + 1];
+            data->car_z = d->qpos[qpos_adr + 2];
+        }
+        if (qpos_adr >= 0 && qpos_adr + 6 < m->nq) {
+            // 自由关节四元数 (w, x, y, z) -> 偏航角
+            const double* q = d->qpos + qpos_adr + 3;
+            data->car_heading = atan2(2.0 * (q[0] * q[3] + q[1] * q[2]),
+                                      1.0 - 2.0 * (q[2] * q[2] + q[3] * q[3]));
+        }
+        
+        data->speed_ms = signal[ALERT_SPEED_MS];
+        data->speed_kmh = signal[ALERT_SPEED_KMH];
+        // 加速度按两次运动刷新之间的时间计算（刷新频率可低于调用频率）
+        double motion_dt = d->time - last_motion_time_;
+        if (last_motion_time_ >= 0.0 && motion_dt > 0.0) {
+            data->acceleration = (data->speed_ms - last_speed_) / motion_dt;
+        }
+        last_speed_ = data->speed_ms;
+        last_motion_time_ = d->time;
+
+        data->rpm = drivetrain_state_.rpm;
+        data->gear = drivetrain_state_.gear;
+    }
+
+    // ============ 油量和电量 ============
+    if (groups & TELEMETRY_ENERGY) {
+        data->fuel = signal[ALERT_FUEL];
+        data->battery_level = battery_;
+    }
+
+    // ============ 温度 ============
+    if (groups & TELEMETRY_TEMPERATURE) {
+        data->temperature = drivetrain_state_.temperature;
+    }
+
+    // ============ 状态 ============
+    if (groups & TELEMETRY_STATUS) {
+        // 控制输入（由轮端力矩推算）
+        data->throttle = drivetrain_state_.throttle;
+        data->brake = drivetrain_state_.brake;
+        data->steering = steer;
+
+        // 模拟自动驾驶状态
+        data->autopilot = (static_cast<int>(d->time) % 10) < 5;
+        data->mode = data->autopilot ? "AUTO" : "MANUAL";
+
+        // 警报
+        data->alerts = alert_state_.active;
+        data->alert_rules = &alert_rules_;
+        data->warning = alert_state_.active != 0;
+
+        // 行程距离（km）
+        data->trip_distance = trip_km_;
+
+        // 模拟时间
+        data->time_of_day = fmod(d->time / 60.0, 24.0);  // 24小时制
+    }
+
+    return delta_time;
+}
+
+}  // namespace mjpc
@@ -0,0 +1,87 @@
+#ifndef MJPC_DASHBOARD_TELEMETRY_H_
+#define MJPC_DASHBOARD_TELEMETRY_H_
+
+#include <mujoco/mujoco.h>
+
+#include <cstdint>
+#include <string>
+
+#include "mjpc/alert_rules.h"
+#include "mjpc/dashboard_data.h"
+#include "mjpc/drivetrain.h"
+
+namespace mjpc {
+
+// 可按不同频率刷新的字段组（Step 的 groups 参数）
+enum TelemetryGroup : uint32_t {
+    TELEMETRY_MOTION = 1u << 0,        // 位置、朝向、速度、加速度、转速、档位
+    TELEMETRY_STATUS = 1u << 1,        // 控制输入、自动驾驶、警告、行程、时间
+    TELEMETRY_TEMPERATURE = 1u << 2,   // 温度
+    TELEMETRY_ENERGY = 1u << 3,        // 油量、电量
+    TELEMETRY_ALL = 0xFu
+};
+
+// ============ 仿真时间驱动的遥测积分器 ============
+// 只依赖 mjModel/mjData，不依赖 GLFW 或窗口，可以在无头批量运行
+// （如 testspeed）中以满速仿真使用。所有积分量（行程、油耗、电量）
+// 都按 mjData::time 的增量推进，因此同一条轨迹的结果与渲染帧率、
+// 墙钟时间无关，多次运行结果一致。
+//
+// 转速、档位、油门/刹车、转向、温度和油量来自传动系统模型（drivetrain.h）：
+// 输入为 left/right 车轮关节的角速度和 jointactuatorfrc 传感器读到的轮端力矩。
+// 模型中没有这两个关节时这些字段保持怠速值。
+//
+// 警告由编译好的警报规则（alert_rules.h）每次 Step 求值：data->alerts 为活动
+// 位掩码，data->warning 为是否有任一警报，触发和解除事件记入 AlertEvents()。
+class TelemetryIntegrator {
+public:
+    TelemetryIntegrator() = default;
+
+    // 清空积分状态（仿真重置时调用）
+    void Reset();
+
+    // 用当前仿真状态更新 data，返回本次推进的仿真时间 (s)。
+    // 如果 d->time 回退（仿真被重置），积分状态自动清零，返回 0。
+    // groups 之外的字段保持上一次的值；油耗、电量、行程的积分每次都推进，
+    // 只是写入 data 的频率不同，因此累计值与刷新频率无关。
+    double Step(const mjModel* m, const mjData* d, DashboardData* data,
+                uint32_t groups = TELEMETRY_ALL);
+
+    // 替换传动系统参数（重建查表并回到初始状态）
+    void SetDrivetrain(const DrivetrainSpec& spec);
+    const DrivetrainTables& Drivetrain() const { return drivetrain_; }
+    const DrivetrainState& DrivetrainStatus() const { return drivetrain_state_; }
+
+    // 替换警报规则（格式见 AlertRuleSet），失败时保留原规则并返回 false
+    bool SetAlertRules(const std::string& rules, std::string* error = nullptr);
+    const AlertRuleSet& AlertRules() const { return alert_rules_; }
+    const AlertLog& AlertEvents() const { return alert_log_; }
+
+    // 车身 body（按名称查找，结果按模型缓存）
+    int CarBodyId() const { return car_body_id_; }
+    const WheelBinding& Wheels() const { return wheels_; }
+
+private:
+    void BindModel(const mjModel* m);
+
+    const mjModel* model_ = nullptr;
+    int car_body_id_ = 0;
+    WheelBinding wheels_;
+    DrivetrainTables drivetrain_;
+    AlertRuleSet alert_rules_;
+    AlertLog alert_log_;
+
+    // 积分状态
+    bool has_time_ = false;
+    double last_time_ = 0.0;
+    double last_speed_ = 0.0;
+    double last_motion_time_ = -1.0;  // 上次运动刷新的仿真时间（-1 为尚未刷新）
+    DrivetrainState drivetrain_state_ = drivetrain_.InitialState();
+    AlertState alert_state_;
+    double battery_ = 95.0;
+    double trip_km_ = 0.0;
+};
+
+}  // namespace mjpc
+
+#endif  // MJPC_DASHBOARD_TELEMETRY_H_
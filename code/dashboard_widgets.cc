@@ -0,0 +1,36 @@
+#include "mjpc/dashboard_widgets.h"
+
+namespace mjpc {
+
+WidgetLayout ComputeWidgetLayout(bool follow, float x, float y, float width, float height,
+                                 float scale) {
+    WidgetLayout layout;
+    layout.follow = follow;
+    float padding = 20.0f * scale;
+    layout.x = x + padding;
+    layout.y = y + padding;
+    layout.width = width - 2 * padding;
+    layout.height = height - 2 * padding;
+
+    if (follow) {
+        // 表盘 45%、信息 30%、导航 25%，行间距 15
+        layout.gauge_y = layout.y;
+        layout.gauge_height = layout.height * 0.45f;
+        layout.info_y = layout.gauge_y + layout.gauge_height + 15.0f;
+        layout.info_height = layout.height * 0.3f;
+        layout.bottom_y = layout.info_y + layout.info_height + 15.0f;
+        layout.bottom_height = layout.height * 0.25f;
+    } else {
+        // 标题 30（下方留 20）、表盘 55%、信息 45%（三列，各占 30%）
+        const float title_height = 30.0f;
+        layout.title_y = layout.y + title_height * 0.5f - 5.0f;
+        layout.gauge_y = layout.y + title_height + 20.0f;
+        layout.gauge_height = layout.height * 0.55f;
+        layout.info_y = layout.gauge_y + layout.gauge_height + 20.0f;
+        layout.info_height = layout.height * 0.45f;
+        layout.column_width = layout.width * 0.3f;
+    }
+    return layout;
+}
+
+}  // namespace mjpc
@@ -0,0 +1,377 @@
+#ifndef MJPC_DASHBOARD_WIDGETS_H_
+#define MJPC_DASHBOARD_WIDGETS_H_
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "mjpc/alert_rules.h"
+#include "mjpc/dashboard_data.h"
+
+// ============ 组件编译开关 ============
+// 精简构建可以把不需要的组件定义为 0（CMake: MJPC_DASHBOARD_DISABLED_WIDGETS），
+// 该组件不进入注册表，其更新和绘制代码不会被实例化。
+#ifndef MJPC_DASHBOARD_WIDGET_TITLE
+#define MJPC_DASHBOARD_WIDGET_TITLE 1
+#endif
+#ifndef MJPC_DASHBOARD_WIDGET_SPEEDOMETER
+#define MJPC_DASHBOARD_WIDGET_SPEEDOMETER 1
+#endif
+#ifndef MJPC_DASHBOARD_WIDGET_TACHOMETER
+#define MJPC_DASHBOARD_WIDGET_TACHOMETER 1
+#endif
+#ifndef MJPC_DASHBOARD_WIDGET_BATTERY
+#define MJPC_DASHBOARD_WIDGET_BATTERY 1
+#endif
+#ifndef MJPC_DASHBOARD_WIDGET_AUTOPILOT
+#define MJPC_DASHBOARD_WIDGET_AUTOPILOT 1
+#endif
+#ifndef MJPC_DASHBOARD_WIDGET_GEAR
+#define MJPC_DASHBOARD_WIDGET_GEAR 1
+#endif
+#ifndef MJPC_DASHBOARD_WIDGET_TEMPERATURE
+#define MJPC_DASHBOARD_WIDGET_TEMPERATURE 1
+#endif
+#ifndef MJPC_DASHBOARD_WIDGET_ENERGY_FLOW
+#define MJPC_DASHBOARD_WIDGET_ENERGY_FLOW 1
+#endif
+#ifndef MJPC_DASHBOARD_WIDGET_MINIMAP
+#define MJPC_DASHBOARD_WIDGET_MINIMAP 1
+#endif
+#ifndef MJPC_DASHBOARD_WIDGET_NAVIGATION
+#define MJPC_DASHBOARD_WIDGET_NAVIGATION 1
+#endif
+#ifndef MJPC_DASHBOARD_WIDGET_ALERTS
+#define MJPC_DASHBOARD_WIDGET_ALERTS 1
+#endif
+
+namespace mjpc {
+
+// 辅助函数：把 prefix + value + suffix 写入定长缓冲（超长截断），不分配内存
+template <size_t N>
+const char* FormatInt(char (&buffer)[N], const char* prefix, int value, const char* suffix = "") {
+    char* end = buffer + N - 1;
+    char* out = buffer;
+    while (*prefix && out < end) *out++ = *prefix++;
+    out = std::to_chars(out, end, value).ptr;   // 空间不足时 ptr == end
+    while (*suffix && out < end) *out++ = *suffix++;
+    *out = '\0';
+    return buffer;
+}
+
+// ============ 组件布局 ============
+// 仪表盘内容区和各行的位置，每帧按当前模式计算一次，组件据此确定自己的位置
+struct WidgetLayout {
+    bool follow = false;           // 跟随模式布局（否则为固定屏幕布局）
+    float x = 0.0f, y = 0.0f;      // 内容区（已去掉内边距）
+    float width = 0.0f, height = 0.0f;
+    float title_y = 0.0f;          // 标题行（仅固定模式）
+    float gauge_y = 0.0f, gauge_height = 0.0f;     // 表盘行
+    float info_y = 0.0f, info_height = 0.0f;       // 信息行
+    float bottom_y = 0.0f, bottom_height = 0.0f;   // 导航行（仅跟随模式）
+    float column_width = 0.0f;     // 信息行的列宽（固定模式）
+};
+
+WidgetLayout ComputeWidgetLayout(bool follow, float x, float y, float width, float height,
+                                 float scale);
+
+// 标签颜色（按当前主题取色）
+enum WidgetLabelStyle {
+    LABEL_PRIMARY,
+    LABEL_WARNING,
+    LABEL_VALUE,     // 数值（白色）
+    LABEL_CAPTION    // 说明文字（浅灰）
+};
+
+// ============ 组件基类（CRTP，静态分发） ============
+// 组件实现 OnDraw(canvas, layout, data)，有状态的组件再实现 OnUpdate(data, dt)。
+// Canvas 为 Dashboard，组件只使用它的公开绘制函数和 DrawLabel。
+template <typename Derived>
+class DashboardWidgetBase {
+public:
+    // delta_time 为动画时间增量 (s)
+    void Update(const DashboardData& data, float delta_time) {
+        derived().OnUpdate(data, delta_time);
+    }
+    template <typename Canvas>
+    void Draw(Canvas& canvas, const WidgetLayout& layout, const DashboardData& data) {
+        derived().OnDraw(canvas, layout, data);
+    }
+
+    void OnUpdate(const DashboardData&, float) {}   // 默认无状态
+
+protected:
+    // 指数平滑，时间常数与帧率无关（60 fps 时约等于每帧 0.1）
+    static float Smooth(float current, float target, float delta_time) {
+        return current + (target - current) * (1.0f - expf(-6.0f * delta_time));
+    }
+
+private:
+    Derived& derived() { return static_cast<Derived&>(*this); }
+};
+
+// ============ 组件 ============
+struct TitleWidget : DashboardWidgetBase<TitleWidget> {
+    static constexpr bool kEnabled = MJPC_DASHBOARD_WIDGET_TITLE;
+
+    template <typename Canvas>
+    void OnDraw(Canvas& canvas, const WidgetLayout& layout, const DashboardData&) {
+        if (layout.follow) return;
+        canvas.DrawLabel(layout.x + layout.width * 0.5f - 40.0f, layout.title_y,
+                         "VEHICLE DASHBOARD", 12.0f, LABEL_PRIMARY);
+    }
+};
+
+struct SpeedometerWidget : DashboardWidgetBase<SpeedometerWidget> {
+    static constexpr bool kEnabled = MJPC_DASHBOARD_WIDGET_SPEEDOMETER;
+    float speed = 0.0f;   // 平滑后的速度 (km/h)
+
+    void OnUpdate(const DashboardData& data, float delta_time) {
+        speed = Smooth(speed, data.speed_kmh, delta_time);
+    }
+    template <typename Canvas>
+    void OnDraw(Canvas& canvas, const WidgetLayout& layout, const DashboardData&) {
+        if (layout.follow) {
+            canvas.DrawModernSpeedometer(layout.x + layout.width * 0.25f,
+                                         layout.gauge_y + layout.gauge_height * 0.5f,
+                                         layout.gauge_height * 0.35f, speed);
+            return;
+        }
+        float center_x = layout.x + layout.width * 0.45f * 0.5f;
+        canvas.DrawModernSpeedometer(center_x, layout.gauge_y + layout.gauge_height * 0.5f,
+                                     layout.gauge_height * 0.35f, speed);
+        canvas.DrawLabel(center_x - 25.0f, layout.gauge_y + layout.gauge_height * 0.9f,
+                         "SPEED", 10.0f, LABEL_CAPTION);
+    }
+};
+
+struct TachometerWidget : DashboardWidgetBase<TachometerWidget> {
+    static constexpr bool kEnabled = MJPC_DASHBOARD_WIDGET_TACHOMETER;
+    float rpm = 0.0f;     // 平滑后的转速
+
+    void OnUpdate(const DashboardData& data, float delta_time) {
+        rpm = Smooth(rpm, data.rpm, delta_time);
+    }
+    template <typename Canvas>
+    void OnDraw(Canvas& canvas, const WidgetLayout& layout, const DashboardData& data) {
+        if (layout.follow) {
+            canvas.DrawModernTachometer(layout.x + layout.width * 0.75f,
+                                        layout.gauge_y + layout.gauge_height * 0.5f,
+                                        layout.gauge_height * 0.35f, rpm, data.max_rpm);
+            return;
+        }
+        float center_x = layout.x + layout.width - layout.width * 0.45f * 0.5f;
+        canvas.DrawModernTachometer(center_x, layout.gauge_y + layout.gauge_height * 0.5f,
+                                    layout.gauge_height * 0.35f, rpm, data.max_rpm);
+        canvas.DrawLabel(center_x - 20.0f, layout.gauge_y + layout.gauge_height * 0.9f,
+                         "RPM", 10.0f, LABEL_CAPTION);
+    }
+};
+
+struct BatteryWidget : DashboardWidgetBase<BatteryWidget> {
+    static constexpr bool kEnabled = MJPC_DASHBOARD_WIDGET_BATTERY;
+
+    template <typename Canvas>
+    void OnDraw(Canvas& canvas, const WidgetLayout& layout, const DashboardData& data) {
+        if (layout.follow) {
+            canvas.DrawBatteryIndicator(layout.x, layout.info_y + 10.0f, layout.width * 0.25f,
+                                        layout.info_height - 20.0f, data.battery_level);
+        } else {
+            canvas.DrawBatteryIndicator(layout.x, layout.info_y + 10.0f,
+                                        layout.column_width - 10.0f, 35.0f, data.battery_level);
+        }
+    }
+};
+
+struct AutopilotWidget : DashboardWidgetBase<AutopilotWidget> {
+    static constexpr bool kEnabled = MJPC_DASHBOARD_WIDGET_AUTOPILOT;
+
+    template <typename Canvas>
+    void OnDraw(Canvas& canvas, const WidgetLayout& layout, const DashboardData& data) {
+        if (layout.follow) {
+            canvas.DrawAutopilotIndicator(layout.x + layout.width * 0.5f,
+                                          layout.info_y + layout.info_height * 0.5f, 20.0f,
+                                          data.autopilot);
+        } else {
+            canvas.DrawAutopilotIndicator(layout.x + layout.column_width * 0.5f,
+                                          layout.info_y + 70.0f, 18.0f, data.autopilot);
+        }
+    }
+};
+
+struct GearWidget : DashboardWidgetBase<GearWidget> {
+    static constexpr bool kEnabled = MJPC_DASHBOARD_WIDGET_GEAR;
+
+    template <typename Canvas>
+    void OnDraw(Canvas& canvas, const WidgetLayout& layout, const DashboardData& data) {
+        char buffer[24];
+        WidgetLabelStyle style = data.gear == -1 ? LABEL_WARNING : LABEL_PRIMARY;
+        if (layout.follow) {
+            const char* text = data.gear == -1 ? "R"
+                             : data.gear == 0  ? "N"
+                                               : FormatInt(buffer, "", data.gear);
+            canvas.DrawLabel(layout.x + layout.width * 0.6f + 30.0f,
+                             layout.bottom_y + layout.bottom_height * 0.5f - 5.0f, text, 16.0f,
+                             style);
+        } else {
+            const char* text = data.gear == -1 ? "REVERSE"
+                             : data.gear == 0  ? "NEUTRAL"
+                                               : FormatInt(buffer, "GEAR ", data.gear);
+            canvas.DrawLabel(layout.x + layout.column_width * 1.5f + 20.0f - 35.0f,
+                             layout.info_y + 30.0f, text, 12.0f, style);
+        }
+    }
+};
+
+struct TemperatureWidget : DashboardWidgetBase<TemperatureWidget> {
+    static constexpr bool kEnabled = MJPC_DASHBOARD_WIDGET_TEMPERATURE;
+
+    template <typename Canvas>
+    void OnDraw(Canvas& canvas, const WidgetLayout& layout, const DashboardData& data) {
+        char buffer[32];
+        int temperature = static_cast<int>(data.temperature);
+        // 过热按警报规则的活动位判断（规则可配置，阈值不写死在这里）
+        bool overheat = data.alert_rules &&
+                        (data.alerts & data.alert_rules->Bit(AlertRuleSet::kOverheat));
+        WidgetLabelStyle style = overheat ? LABEL_WARNING : LABEL_VALUE;
+        if (layout.follow) {
+            canvas.DrawLabel(layout.x + layout.width * 0.6f + 80.0f,
+                             layout.bottom_y + layout.bottom_height * 0.5f - 5.0f,
+                             FormatInt(buffer, "", temperature, "°C"), 10.0f, style);
+        } else {
+            canvas.DrawLabel(layout.x + layout.column_width * 1.5f + 20.0f - 40.0f,
+                             layout.info_y + 60.0f, FormatInt(buffer, "TEMP: ", temperature, "°C"),
+                             10.0f, style);
+        }
+    }
+};
+
+struct EnergyFlowWidget : DashboardWidgetBase<EnergyFlowWidget> {
+    static constexpr bool kEnabled = MJPC_DASHBOARD_WIDGET_ENERGY_FLOW;
+
+    template <typename Canvas>
+    void OnDraw(Canvas& canvas, const WidgetLayout& layout, const DashboardData& data) {
+        if (layout.follow) return;
+        canvas.DrawEnergyFlow(layout.x + layout.column_width * 1.5f + 20.0f, layout.info_y + 90.0f,
+                              25.0f, data.throttle, data.brake * 0.5f);
+    }
+};
+
+struct MinimapWidget : DashboardWidgetBase<MinimapWidget> {
+    static constexpr bool kEnabled = MJPC_DASHBOARD_WIDGET_MINIMAP;
+
+    template <typename Canvas>
+    void OnDraw(Canvas& canvas, const WidgetLayout& layout, const DashboardData& data) {
+        if (layout.follow) {
+            canvas.DrawMinimap(layout.x + layout.width - layout.width * 0.25f * 0.5f,
+                               layout.info_y + layout.info_height * 0.5f, layout.info_height * 0.4f,
+                               data.car_x, data.car_y, data.car_heading);
+        } else {
+            canvas.DrawMinimap(layout.x + layout.column_width * 2.5f + 40.0f,
+                               layout.info_y + layout.info_height * 0.5f, layout.column_width * 0.4f,
+                               data.car_x, data.car_y, data.car_heading);
+        }
+    }
+};
+
+struct NavigationWidget : DashboardWidgetBase<NavigationWidget> {
+    static constexpr bool kEnabled = MJPC_DASHBOARD_WIDGET_NAVIGATION;
+
+    template <typename Canvas>
+    void OnDraw(Canvas& canvas, const WidgetLayout& layout, const DashboardData& data) {
+        if (layout.follow) {
+            canvas.DrawNavigationBar(layout.x, layout.bottom_y, layout.width * 0.6f,
+                                     layout.bottom_height, data.car_heading);
+        } else {
+            canvas.DrawNavigationBar(layout.x + layout.column_width * 2.0f + 45.0f,
+                                     layout.info_y + 100.0f, layout.column_width - 10.0f, 40.0f,
+                                     data.car_heading);
+        }
+    }
+};
+
+// ============ 注册表 ============
+// 组件按列表顺序更新和绘制；编译开关为 0 的组件在编译期被滤掉。
+template <typename... Widgets>
+class WidgetRegistry {
+public:
+    using Tuple = decltype(std::tuple_cat(
+        std::declval<std::conditional_t<Widgets::kEnabled, std::tuple<Widgets>, std::tuple<>>>()...));
+    static constexpr size_t kSize = std::tuple_size<Tuple>::value;
+
+    // 组件是否编译进来
+    template <typename Widget>
+    static constexpr bool Contains() {
+        return ContainsIn<Widget>(static_cast<Tuple*>(nullptr));
+    }
+
+    void Update(const DashboardData& data, float delta_time) {
+        std::apply([&](auto&... widget) { (widget.Update(data, delta_time), ...); }, widgets_);
+    }
+
+    template <typename Canvas>
+    void Draw(Canvas& canvas, const WidgetLayout& layout, const DashboardData& data) {
+        std::apply([&](auto&... widget) { (widget.Draw(canvas, layout, data), ...); }, widgets_);
+    }
+
+    // 编译掉的组件返回空指针
+    template <typename Widget>
+    Widget* Find() {
+        if constexpr (Contains<Widget>()) {
+            return &std::get<Widget>(widgets_);
+        } else {
+            return nullptr;
+        }
+    }
+
+private:
+    template <typename Widget, typename... Enabled>
+    static constexpr bool ContainsIn(std::tuple<Enabled...>*) {
+        return (std::is_same<Widget, Enabled>::value || ...);
+    }
+
+    Tuple widgets_;
+};
+
+// 每个活动警报一个标签：固定模式在标题行左侧，跟随模式在内容区上方，放不下时显示 +N
+struct AlertsWidget : DashboardWidgetBase<AlertsWidget> {
+    static constexpr bool kEnabled = MJPC_DASHBOARD_WIDGET_ALERTS;
+    static constexpr float kSlotWidth = 72.0f;
+
+    template <typename Canvas>
+    void OnDraw(Canvas& canvas, const WidgetLayout& layout, const DashboardData& data) {
+        if (!data.alerts || !data.alert_rules) return;
+        float y = layout.follow ? layout.y - 14.0f : layout.title_y;
+        float width = layout.follow ? layout.width : layout.width * 0.5f - 50.0f;
+        int slots = std::max(static_cast<int>(width / kSlotWidth), 1);
+        int active = 0;
+        for (int i = 0; i < data.alert_rules->NumRules(); i++) active += data.alerts >> i & 1u;
+        // 放不下时最后一格留给 +N
+        int shown = active <= slots ? active : slots - 1;
+        int slot = 0;
+        for (int i = 0; i < data.alert_rules->NumRules() && slot < shown; i++) {
+            if (!(data.alerts >> i & 1u)) continue;
+            canvas.DrawLabel(layout.x + slot++ * kSlotWidth, y, data.alert_rules->Name(i), 9.0f,
+                             LABEL_WARNING);
+        }
+        if (shown < active) {
+            char buffer[8];
+            canvas.DrawLabel(layout.x + slot * kSlotWidth, y, FormatInt(buffer, "+", active - shown),
+                             9.0f, LABEL_WARNING);
+        }
+    }
+};
+
+// 仪表盘的组件列表；新增组件时在这里注册
+using DashboardWidgets =
+    WidgetRegistry<TitleWidget, SpeedometerWidget, TachometerWidget, BatteryWidget,
+                   AutopilotWidget, GearWidget, TemperatureWidget, EnergyFlowWidget,
+                   MinimapWidget, NavigationWidget, AlertsWidget>;
+
+}  // namespace mjpc
+
+#endif  // MJPC_DASHBOARD_WIDGETS_H_
@@ -0,0 +1,76 @@
+#include "mjpc/draw_list.h"
+
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+
+namespace mjpc {
+
+void DrawList::Reserve(int commands, int vertices) {
+    commands_.reserve(commands);
+    vertices_.reserve(vertices);
+}
+
+void DrawList::Begin(unsigned int mode, const DrawState& state) {
+    mode_ = mode;
+    first_ = static_cast<int>(vertices_.size());
+    state_ = state;
+}
+
+void DrawList::End() {
+    int count = static_cast<int>(vertices_.size()) - first_;
+    if (count <= 0) return;
+    commands_.push_back({mode_, first_, count, state_});
+}
+
+// ============ 回放 ============
+void DrawList::Replay(int* draw_calls, int* vertices) const {
+    if (commands_.empty()) return;
+
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    const DrawVertex* data = vertices_.data();
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(DrawVertex), &data->x);
+    glTexCoordPointer(2, GL_FLOAT, sizeof(DrawVertex), &data->u);
+    glColorPointer(4, GL_FLOAT, sizeof(DrawVertex), &data->r);
+
+    // 只在状态变化时设置；第一个图元总是完整设置
+    DrawState current;
+    bool first = true;
+    for (const DrawCommand& command : commands_) {
+        const DrawState& state = command.state;
+        if (first || state.line_width != current.line_width) glLineWidth(state.line_width);
+        if (first || state.point_size != current.point_size) glPointSize(state.point_size);
+        if (first || state.blend != current.blend) {
+            if (state.blend) glEnable(GL_BLEND);
+            else glDisable(GL_BLEND);
+        }
+        if (first || state.texture != current.texture) {
+            if (state.texture) {
+                glEnable(GL_TEXTURE_2D);
+                glBindTexture(GL_TEXTURE_2D, state.texture);
+            } else {
+                glBindTexture(GL_TEXTURE_2D, 0);
+                glDisable(GL_TEXTURE_2D);
+            }
+        }
+        current = state;
+        first = false;
+
+        glDrawArrays(command.mode, command.first, command.count);
+        if (draw_calls) (*draw_calls)++;
+        if (vertices) *vertices += command.count;
+    }
+
+    if (current.texture) {
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glDisable(GL_TEXTURE_2D);
+    }
+    glPopClientAttrib();
+}
+
+}  // namespace mjpc
@@ -0,0 +1,79 @@
+#ifndef MJPC_DRAW_LIST_H_
+#define MJPC_DRAW_LIST_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace mjpc {
+
+// ============ 绘制列表 ============
+// 记录一帧的二维图元（顶点带颜色和纹理坐标）及其绘制状态，之后可在
+// 任意投影/视口下多次回放。回放用客户端顶点数组，每个图元一次
+// glDrawArrays，不再逐顶点调用 GL，多个视口共享同一份几何。
+// 清空不释放容量，预热之后记录不分配内存。
+
+// 图元的绘制状态（GL 固定管线中会影响光栅化的部分）
+struct DrawState {
+    float line_width = 1.0f;
+    float point_size = 1.0f;
+    unsigned int texture = 0;    // 0 为不贴图
+    bool blend = true;
+
+    bool operator==(const DrawState& other) const {
+        return line_width == other.line_width && point_size == other.point_size &&
+               texture == other.texture && blend == other.blend;
+    }
+    bool operator!=(const DrawState& other) const { return !(*this == other); }
+};
+
+struct DrawVertex {
+    float x, y;
+    float u, v;
+    float r, g, b, a;
+};
+
+struct DrawCommand {
+    unsigned int mode;           // GL_TRIANGLES、GL_LINE_LOOP 等
+    int first;
+    int count;
+    DrawState state;
+};
+
+class DrawList {
+public:
+    DrawList() = default;
+    // 列表是每帧重建的临时数据，复制（例如 Dashboard::CopyStateFrom）时不复制内容
+    DrawList(const DrawList&) {}
+    DrawList& operator=(const DrawList&) { return *this; }
+
+    void Reserve(int commands, int vertices);
+    void Clear() { commands_.clear(); vertices_.clear(); }
+
+    // Begin/Vertex/End 与 glBegin/glVertex/glEnd 对应；没有顶点的图元不记录
+    void Begin(unsigned int mode, const DrawState& state);
+    void Vertex(float x, float y, float u, float v, const float color[4]) {
+        vertices_.push_back({x, y, u, v, color[0], color[1], color[2], color[3]});
+    }
+    void End();
+
+    // 在当前投影和视口下回放（调用方负责混合函数等全局状态）；
+    // 返回后纹理为解绑状态。draw_calls/vertices 累加提交的数量（可为空）
+    void Replay(int* draw_calls, int* vertices) const;
+
+    int NumCommands() const { return static_cast<int>(commands_.size()); }
+    int NumVertices() const { return static_cast<int>(vertices_.size()); }
+    size_t MemoryBytes() const {
+        return commands_.capacity() * sizeof(DrawCommand) + vertices_.capacity() * sizeof(DrawVertex);
+    }
+
+private:
+    std::vector<DrawCommand> commands_;
+    std::vector<DrawVertex> vertices_;
+    unsigned int mode_ = 0;
+    int first_ = 0;
+    DrawState state_;
+};
+
+}  // namespace mjpc
+
+#endif  // MJPC_DRAW_LIST_H_
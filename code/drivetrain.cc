@@ -0,0 +1,268 @@
+#include "mjpc/drivetrain.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace mjpc {
+
+namespace {
+
+constexpr double kRadPerSecondToRpm = 60.0 / (2.0 * M_PI);
+// 低于此车轮角速度 (rad/s) 视为静止：此时按驱动力矩方向选择前进/倒挡
+constexpr double kStandstillSpeed = 0.5;
+// 静止时切换前进/倒挡所需的力矩比例
+constexpr double kReverseDrive = 0.05;
+// 降挡阈值不超过下一档升挡阈值的比例（防止两档之间来回跳）
+constexpr double kShiftHysteresis = 0.9;
+// 最高档不升、1 档不降（用有限值，插值时不产生 NaN）
+constexpr double kNever = std::numeric_limits<double>::max();
+
+// 关键点分段线性插值，x 超出范围时取端点
+double Interpolate(const double (*points)[2], int count, double x) {
+    if (count <= 0) return 0.0;
+    if (x <= points[0][0]) return points[0][1];
+    for (int i = 1; i < count; i++) {
+        if (x <= points[i][0]) {
+            double span = points[i][0] - points[i - 1][0];
+            double t = span > 0.0 ? (x - points[i - 1][0]) / span : 1.0;
+            return points[i - 1][1] + t * (points[i][1] - points[i - 1][1]);
+        }
+    }
+    return points[count - 1][1];
+}
+
+// 换挡图关键点插值（column 1 为升挡、2 为降挡）
+double InterpolateShift(const DrivetrainSpec& spec, int column, double throttle) {
+    double points[4][2];
+    int count = std::clamp(spec.num_shift_points, 1, 4);
+    for (int i = 0; i < count; i++) {
+        points[i][0] = spec.shift_points[i][0];
+        points[i][1] = spec.shift_points[i][column];
+    }
+    return Interpolate(points, count, throttle);
+}
+
+// 等间距表查表：x 为 [0, 1] 上的位置，表长 samples
+inline double LookUp(const double* table, int samples, double x) {
+    double position = std::clamp(x, 0.0, 1.0) * (samples - 1);
+    int i = std::min(static_cast<int>(position), samples - 2);
+    double t = position - i;
+    return table[i] + t * (table[i + 1] - table[i]);
+}
+
+}  // namespace
+
+// ============ 建表 ============
+DrivetrainTables::DrivetrainTables(const DrivetrainSpec& spec) : spec_(spec) {
+    num_gears_ = std::clamp(spec_.num_gears, 1, kMaxGears);
+    spec_.num_gears = num_gears_;
+    spec_.num_torque_points = std::clamp(spec_.num_torque_points, 1, 8);
+    spec_.limit_rpm = std::max(spec_.limit_rpm, spec_.idle_rpm + 1.0);
+
+    rpm_per_wheel_[0] = spec_.reverse_ratio * spec_.final_drive * kRadPerSecondToRpm;
+    for (int g = 1; g <= num_gears_; g++) {
+        rpm_per_wheel_[g] = spec_.gear_ratios[g - 1] * spec_.final_drive * kRadPerSecondToRpm;
+    }
+
+    // 扭矩曲线：[0, limit_rpm] 上等间距采样
+    torque_scale_ = kTorqueSamples / spec_.limit_rpm;
+    peak_power_kw_ = 0.0;
+    for (int i = 0; i <= kTorqueSamples; i++) {
+        double rpm = i / torque_scale_;
+        torque_table_[i] = Interpolate(spec_.torque_points, spec_.num_torque_points, rpm);
+        peak_power_kw_ = std::max(peak_power_kw_, torque_table_[i] * rpm / kRadPerSecondToRpm / 1000.0);
+    }
+    peak_power_kw_ = std::max(peak_power_kw_, 1e-6);
+
+    // 换挡图：发动机转速阈值按档位速比换算成车轮角速度，查表时不再做除法
+    for (int s = 0; s < kShiftSamples; s++) {
+        double throttle = static_cast<double>(s) / (kShiftSamples - 1);
+        double up_rpm = std::min(InterpolateShift(spec_, 1, throttle), spec_.limit_rpm);
+        double down_rpm = InterpolateShift(spec_, 2, throttle);
+        for (int g = 1; g <= num_gears_; g++) {
+            upshift_speed_[g - 1][s] = g < num_gears_ ? up_rpm / rpm_per_wheel_[g] : kNever;
+            double down = g > 1 ? down_rpm / rpm_per_wheel_[g] : -kNever;
+            if (g > 1) down = std::min(down, kShiftHysteresis * upshift_speed_[g - 2][s]);
+            downshift_speed_[g - 1][s] = down;
+        }
+    }
+
+    idle_fuel_per_second_ = spec_.idle_liters_per_hour / 3600.0;
+    fuel_per_kwh_second_ = spec_.bsfc_g_per_kwh / 1000.0 / std::max(spec_.fuel_density, 1e-6) / 3600.0;
+}
+
+double DrivetrainTables::MaxTorque(double rpm) const {
+    double position = std::clamp(rpm * torque_scale_, 0.0, static_cast<double>(kTorqueSamples));
+    int i = std::min(static_cast<int>(position), kTorqueSamples - 1);
+    double t = position - i;
+    return torque_table_[i] + t * (torque_table_[i + 1] - torque_table_[i]);
+}
+
+DrivetrainState DrivetrainTables::InitialState() const {
+    DrivetrainState state;
+    state.gear = 1;
+    state.rpm = spec_.idle_rpm;
+    state.fuel_liters = spec_.tank_liters;
+    state.temperature = spec_.ambient_temperature;
+    state.since_shift = spec_.shift_delay;
+    return state;
+}
+
+// ============ 单步 ============
+void DrivetrainTables::Step(const DrivetrainInput& input, double dt, DrivetrainState* state) const {
+    const double drive = std::clamp(input.drive, -1.0, 1.0);
+    const double wheel = input.wheel_speed;
+
+    // 前进/倒挡：行驶中跟随车轮转向，静止时跟随驱动力矩方向
+    bool reverse = state->gear < 0;
+    if (wheel < -kStandstillSpeed) {
+        reverse = true;
+    } else if (wheel > kStandstillSpeed) {
+        reverse = false;
+    } else if (drive < -kReverseDrive) {
+        reverse = true;
+    } else if (drive > kReverseDrive) {
+        reverse = false;
+    }
+    if (reverse != (state->gear < 0)) {
+        state->gear = reverse ? -1 : 1;
+        state->since_shift = 0.0;
+    }
+
+    // 与行驶方向相同的力矩为油门，相反的为制动
+    const double push = reverse ? -drive : drive;
+    state->throttle = std::max(push, 0.0);
+    state->brake = std::max(-push, 0.0);
+    const double speed = std::fabs(wheel);
+
+    // 换挡：每步最多一档，两次换挡间隔不少于 shift_delay
+    if (!reverse && state->since_shift >= spec_.shift_delay) {
+        int g = std::clamp(state->gear, 1, num_gears_);
+        if (speed > LookUp(upshift_speed_[g - 1], kShiftSamples, state->throttle)) {
+            g++;
+        } else if (speed < LookUp(downshift_speed_[g - 1], kShiftSamples, state->throttle)) {
+            g--;
+        }
+        if (g != state->gear) {
+            state->gear = g;
+            state->since_shift = 0.0;
+        }
+    }
+
+    // 发动机转速：车轮转速经速比换算，低速时由变矩器托住（油门越大允许越高）
+    double rpm = speed * rpm_per_wheel_[reverse ? 0 : state->gear];
+    double converter = spec_.idle_rpm + (spec_.stall_rpm - spec_.idle_rpm) * state->throttle;
+    rpm = std::min(std::max(rpm, converter), spec_.limit_rpm);
+    state->rpm = rpm;
+
+    // 断油转速处不输出扭矩
+    state->torque = rpm < spec_.limit_rpm ? MaxTorque(rpm) * state->throttle : 0.0;
+    state->power_kw = state->torque * rpm / kRadPerSecondToRpm / 1000.0;
+
+    if (dt <= 0.0) return;
+    state->since_shift += dt;
+
+    double flow = idle_fuel_per_second_ + fuel_per_kwh_second_ * state->power_kw;
+    state->fuel_liters = std::max(state->fuel_liters - flow * dt, 0.0);
+
+    double target = spec_.idle_temperature + spec_.full_load_rise * state->power_kw / peak_power_kw_;
+    double alpha = std::min(dt / std::max(spec_.thermal_time_constant, 1e-6), 1.0);
+    state->temperature += (target - state->temperature) * alpha;
+}
+
+void DrivetrainTables::Step(const DrivetrainInput* inputs, int count, double dt,
+                            DrivetrainState* states) const {
+    for (int i = 0; i < count; i++) Step(inputs[i], dt, states + i);
+}
+
+// ============ 车轮绑定 ============
+namespace {
+
+// 执行器对某个自由度的力矩臂（关节传动或固定腱），不作用于该自由度时为 0
+double ActuatorMoment(const mjModel* m, int actuator, int joint) {
+    const double gear = m->actuator_gear[6 * actuator];
+    const int target = m->actuator_trnid[2 * actuator];
+    if (m->actuator_trntype[actuator] == mjTRN_JOINT) {
+        return target == joint ? gear : 0.0;
+    }
+    if (m->actuator_trntype[actuator] == mjTRN_TENDON) {
+        double coef = 0.0;
+        const int begin = m->tendon_adr[target], end = begin + m->tendon_num[target];
+        for (int w = begin; w < end; w++) {
+            if (m->wrap_type[w] == mjWRAP_JOINT && m->wrap_objid[w] == joint) coef += m->wrap_prm[w];
+        }
+        return gear * coef;
+    }
+    return 0.0;
+}
+
+int JointActuatorSensor(const mjModel* m, int joint) {
+    for (int i = 0; i < m->nsensor; i++) {
+        if (m->sensor_type[i] == mjSENS_JOINTACTFRC && m->sensor_objid[i] == joint) {
+            return m->sensor_adr[i];
+        }
+    }
+    return -1;
+}
+
+}  // namespace
+
+WheelBinding BindWheels(const mjModel* m, const std::string& left_joint,
+                        const std::string& right_joint) {
+    WheelBinding binding;
+    if (!m) return binding;
+    int left = mj_name2id(m, mjOBJ_JOINT, left_joint.c_str());
+    int right = mj_name2id(m, mjOBJ_JOINT, right_joint.c_str());
+    if (left < 0 || right < 0 || m->jnt_type[left] != mjJNT_HINGE ||
+        m->jnt_type[right] != mjJNT_HINGE) {
+        return binding;
+    }
+    binding.left_dof = m->jnt_dofadr[left];
+    binding.right_dof = m->jnt_dofadr[right];
+    binding.left_sensor = JointActuatorSensor(m, left);
+    binding.right_sensor = JointActuatorSensor(m, right);
+
+    // 各执行器在满控制量下对左右轮的力矩，按和/差累加
+    for (int a = 0; a < m->nu; a++) {
+        double left_moment = ActuatorMoment(m, a, left);
+        double right_moment = ActuatorMoment(m, a, right);
+        if (left_moment == 0.0 && right_moment == 0.0) continue;
+        double control = 1.0;
+        if (m->actuator_ctrllimited[a]) {
+            control = std::max(std::fabs(m->actuator_ctrlrange[2 * a]),
+                               std::fabs(m->actuator_ctrlrange[2 * a + 1]));
+        }
+        binding.peak_drive += std::fabs(left_moment + right_moment) * control;
+        binding.peak_steer += std::fabs(left_moment - right_moment) * control;
+    }
+    return binding;
+}
+
+void ReadWheels(const WheelBinding& binding, const mjData* d, DrivetrainInput* input,
+                double* steer) {
+    if (!binding.Valid()) {
+        *input = DrivetrainInput();
+        if (steer) *steer = 0.0;
+        return;
+    }
+    double left_torque = binding.left_sensor >= 0 ? d->sensordata[binding.left_sensor]
+                                                  : d->qfrc_actuator[binding.left_dof];
+    double right_torque = binding.right_sensor >= 0 ? d->sensordata[binding.right_sensor]
+                                                    : d->qfrc_actuator[binding.right_dof];
+    input->wheel_speed = 0.5 * (d->qvel[binding.left_dof] + d->qvel[binding.right_dof]);
+    input->drive = binding.peak_drive > 0.0
+                       ? std::clamp((left_torque + right_torque) / binding.peak_drive, -1.0, 1.0)
+                       : 0.0;
+    if (steer) {
+        *steer = binding.peak_steer > 0.0
+                     ? std::clamp((left_torque - right_torque) / binding.peak_steer, -1.0, 1.0)
+                     : 0.0;
+    }
+}
+
+}  // namespace mjpc
@@ -0,0 +1,128 @@
+#ifndef MJPC_DRIVETRAIN_H_
+#define MJPC_DRIVETRAIN_H_
+
+#include <mujoco/mujoco.h>
+
+#include <string>
+
+namespace mjpc {
+
+// ============ 传动系统模型（查表） ============
+// 由驱动轮转速和轮端力矩推算发动机转速、档位、油耗和冷却液温度。
+// 扭矩曲线和换挡图在构造 DrivetrainTables 时按 DrivetrainSpec 的关键点
+// 预先采样成等间距表，每步只做下标计算和一次线性插值；每辆车的状态
+// 是一个小 POD（DrivetrainState），表可以被任意多辆车共享。
+
+constexpr int kMaxGears = 8;
+
+struct DrivetrainSpec {
+    // 档位速比（1 档起）与主减速比；车轮转速 × 速比 × 主减速比 = 发动机转速
+    int num_gears = 6;
+    double gear_ratios[kMaxGears] = {3.5, 2.1, 1.4, 1.0, 0.8, 0.65};
+    double final_drive = 3.9;
+    double reverse_ratio = 3.2;
+
+    double idle_rpm = 800.0;
+    double stall_rpm = 2200.0;       // 起步时变矩器允许的最高转速（全油门）
+    double limit_rpm = 7000.0;       // 断油转速
+
+    // 外特性扭矩曲线关键点 (rpm, N·m)，按转速升序
+    int num_torque_points = 6;
+    double torque_points[8][2] = {
+        {0.0, 120.0}, {1000.0, 180.0}, {2500.0, 250.0},
+        {4500.0, 260.0}, {6000.0, 220.0}, {7000.0, 170.0}};
+
+    // 换挡图关键点 (油门 0-1, 升挡转速, 降挡转速)，按油门升序
+    int num_shift_points = 3;
+    double shift_points[4][3] = {
+        {0.0, 2000.0, 1100.0}, {0.5, 3200.0, 1800.0}, {1.0, 6200.0, 3500.0}};
+    double shift_delay = 0.4;        // 两次换挡的最短间隔 (s)
+
+    // 油耗：怠速流量 + 有效燃油消耗率 × 功率
+    double tank_liters = 50.0;
+    double idle_liters_per_hour = 0.8;
+    double bsfc_g_per_kwh = 260.0;
+    double fuel_density = 0.745;     // kg/L
+
+    // 冷却液温度：一阶惯性趋向 怠速温度 + 功率比例 × 满载温升
+    double ambient_temperature = 25.0;
+    double idle_temperature = 85.0;
+    double full_load_rise = 25.0;
+    double thermal_time_constant = 20.0;   // s
+};
+
+// 一辆车一步的输入
+struct DrivetrainInput {
+    double wheel_speed = 0.0;        // 驱动轮平均角速度 (rad/s)，前进为正
+    double drive = 0.0;              // 轮端驱动力矩 / 可用峰值，前进方向为正，[-1, 1]
+};
+
+// 一辆车的状态（也是输出）
+struct DrivetrainState {
+    int gear = 1;                    // -1 倒挡，1..num_gears 前进挡
+    double rpm = 0.0;
+    double throttle = 0.0;           // 0-1
+    double brake = 0.0;              // 0-1（反向力矩，即制动）
+    double torque = 0.0;             // 发动机输出扭矩 (N·m)
+    double power_kw = 0.0;
+    double fuel_liters = 0.0;
+    double temperature = 0.0;
+    double since_shift = 0.0;        // 距上次换挡 (s)
+};
+
+class DrivetrainTables {
+public:
+    static constexpr int kTorqueSamples = 64;
+    static constexpr int kShiftSamples = 17;
+
+    explicit DrivetrainTables(const DrivetrainSpec& spec = DrivetrainSpec());
+
+    const DrivetrainSpec& Spec() const { return spec_; }
+    // 满油门扭矩 (N·m)，转速超出范围时取端点
+    double MaxTorque(double rpm) const;
+    // 满油、常温、1 档的初始状态
+    DrivetrainState InitialState() const;
+
+    // 推进 dt 秒；dt 为 0 时只更新转速和扭矩，不积分油耗、温度
+    void Step(const DrivetrainInput& input, double dt, DrivetrainState* state) const;
+    // 多辆车（状态与输入一一对应）
+    void Step(const DrivetrainInput* inputs, int count, double dt, DrivetrainState* states) const;
+
+private:
+    DrivetrainSpec spec_;
+    int num_gears_;
+    double rpm_per_wheel_[kMaxGears + 1];       // [0] 为倒挡，其余为前进挡
+    double torque_table_[kTorqueSamples + 1];
+    double torque_scale_;                        // 转速 -> 表下标
+    // 按油门采样的升/降挡车轮转速阈值 (rad/s)，[档位 - 1][油门]
+    double upshift_speed_[kMaxGears][kShiftSamples];
+    double downshift_speed_[kMaxGears][kShiftSamples];
+    double fuel_per_kwh_second_;                 // L / (kW·s)
+    double idle_fuel_per_second_;                // L / s
+    double peak_power_kw_;
+};
+
+// ============ 车轮绑定 ============
+// 左右驱动轮铰链关节的 qvel 地址和 jointactuatorfrc 传感器地址（没有该传感器时
+// 读 qfrc_actuator），以及按执行器的传动（关节或固定腱）计算的轮端峰值力矩。
+// 多车场景按各车的关节名分别绑定（如 StressSceneName("left", i)）。
+struct WheelBinding {
+    int left_dof = -1, right_dof = -1;
+    int left_sensor = -1, right_sensor = -1;     // sensordata 地址
+    double peak_drive = 0.0;                     // 左右轮力矩之和的峰值
+    double peak_steer = 0.0;                     // 左右轮力矩之差的峰值
+
+    bool Valid() const { return left_dof >= 0 && right_dof >= 0; }
+};
+
+// 按关节名绑定，任一关节不存在时返回的绑定无效
+WheelBinding BindWheels(const mjModel* m, const std::string& left_joint = "left",
+                        const std::string& right_joint = "right");
+
+// 读取一辆车的输入；steer 非空时写入转向力矩比例 [-1, 1]（左轮减右轮，右转为正）
+void ReadWheels(const WheelBinding& binding, const mjData* d, DrivetrainInput* input,
+                double* steer = nullptr);
+
+}  // namespace mjpc
+
+#endif  // MJPC_DRIVETRAIN_H_
@@ -0,0 +1,57 @@
+#include "mjpc/estimator_view.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mjpc/estimators/estimator.h"
+
+namespace mjpc {
+
+EstimatorView MakeEstimatorView(Estimator& estimator) {
+    EstimatorView view;
+    view.state = estimator.State();
+    view.covariance = estimator.Covariance();
+    view.covariance_dim = estimator.DimensionProcess();
+    return view;
+}
+
+bool ReadEstimatedPose(const EstimatorView& view, const mjModel* m, int body,
+                       EstimatedPose* pose) {
+    if (!view.Valid() || !m || body < 0 || body >= m->nbody) return false;
+    int joint = m->body_jntadr[body];
+    if (joint < 0 || m->jnt_type[joint] != mjJNT_FREE) return false;
+
+    // 自由关节 qpos: 位置 (3) + 四元数 (4)
+    const double* qpos = view.state + m->jnt_qposadr[joint];
+    const double* quat = qpos + 3;
+    pose->x = qpos[0];
+    pose->y = qpos[1];
+    pose->heading = atan2(2.0 * (quat[0] * quat[3] + quat[1] * quat[2]),
+                          1.0 - 2.0 * (quat[2] * quat[2] + quat[3] * quat[3]));
+
+    // 自由关节前 3 个自由度为平移
+    int dof = m->jnt_dofadr[joint];
+    int n = view.covariance_dim;
+    pose->has_covariance = view.covariance != nullptr && dof + 1 < n;
+    if (pose->has_covariance) {
+        pose->cov_xx = view.covariance[dof * n + dof];
+        pose->cov_xy = view.covariance[dof * n + dof + 1];
+        pose->cov_yy = view.covariance[(dof + 1) * n + dof + 1];
+    }
+    return true;
+}
+
+void CovarianceEllipse(double cov_xx, double cov_xy, double cov_yy, double k,
+                       double* major, double* minor, double* angle) {
+    // 对称 2x2 矩阵的特征值
+    double mean = 0.5 * (cov_xx + cov_yy);
+    double diff = 0.5 * (cov_xx - cov_yy);
+    double radius = sqrt(diff * diff + cov_xy * cov_xy);
+    double lambda1 = std::max(mean + radius, 0.0);
+    double lambda2 = std::max(mean - radius, 0.0);
+    *major = k * sqrt(lambda1);
+    *minor = k * sqrt(lambda2);
+    *angle = 0.5 * atan2(2.0 * cov_xy, cov_xx - cov_yy);
+}
+
+}  // namespace mjpc
@@ -0,0 +1,49 @@
+#ifndef MJPC_ESTIMATOR_VIEW_H_
+#define MJPC_ESTIMATOR_VIEW_H_
+
+#include <mujoco/mujoco.h>
+
+namespace mjpc {
+
+class Estimator;   // mjpc/estimators/estimator.h
+
+// ============ 估计器状态的只读视图 ============
+// 不持有、不复制估计器数据，只保存指针。与 estimators/ 中的估计器对接
+// （MakeEstimatorView）：
+//   view.state = estimator.State();             // [qpos (nq), qvel (nv), act (na)]
+//   view.covariance = estimator.Covariance();   // ndstate x ndstate，行主序
+//   view.covariance_dim = estimator.DimensionProcess();   // 2 * nv + na
+// 协方差定义在切空间上：位置块的行列号就是自由度地址 jnt_dofadr。
+// 指针需在估计器生命周期内有效；估计器在其他线程更新时，
+// 读到的是近似一致的快照，仅用于显示。
+struct EstimatorView {
+    const double* state = nullptr;
+    const double* covariance = nullptr;
+    int covariance_dim = 0;
+
+    bool Valid() const { return state != nullptr; }
+};
+
+// 指向估计器内部缓冲区的视图；估计器重新分配缓冲区（如 Initialize）后需重新获取
+EstimatorView MakeEstimatorView(Estimator& estimator);
+
+// 从视图读出的平面位姿
+struct EstimatedPose {
+    double x = 0.0, y = 0.0;
+    double heading = 0.0;                  // 偏航角 (rad)
+    double cov_xx = 0.0, cov_xy = 0.0, cov_yy = 0.0;   // 位置协方差 (m^2)
+    bool has_covariance = false;
+};
+
+// 读取 body（需带自由关节）的估计位姿：qpos 通过 jnt_qposadr 定位，
+// 协方差通过 jnt_dofadr 定位。body 没有自由关节或视图无效时返回 false。
+bool ReadEstimatedPose(const EstimatorView& view, const mjModel* m, int body,
+                       EstimatedPose* pose);
+
+// 2x2 协方差的 k-sigma 椭圆：半轴长度和长轴方向 (rad)
+void CovarianceEllipse(double cov_xx, double cov_xy, double cov_yy, double k,
+                       double* major, double* minor, double* angle);
+
+}  // namespace mjpc
+
+#endif  // MJPC_ESTIMATOR_VIEW_H_
@@ -0,0 +1,286 @@
+#include "mjpc/fleet_telemetry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace mjpc {
+
+namespace {
+
+// ============ SIMD 封装 ============
+// 内核只用到下面这些运算；每种指令集各实现一份，内核本身只写一次。
+#if defined(__AVX2__)
+struct Lanes {
+    static constexpr int kWidth = 4;
+    __m256d v;
+
+    static Lanes Set(double s) { return {_mm256_set1_pd(s)}; }
+    static Lanes Load(const double* p) { return {_mm256_loadu_pd(p)}; }
+    static Lanes Gather(const double* base, const int32_t* index) {
+        __m128i i = _mm_loadu_si128(reinterpret_cast<const __m128i*>(index));
+        return {_mm256_i32gather_pd(base, i, 8)};
+    }
+    void Store(double* p) const { _mm256_storeu_pd(p, v); }
+};
+inline Lanes operator+(Lanes a, Lanes b) { return {_mm256_add_pd(a.v, b.v)}; }
+inline Lanes operator-(Lanes a, Lanes b) { return {_mm256_sub_pd(a.v, b.v)}; }
+inline Lanes operator*(Lanes a, Lanes b) { return {_mm256_mul_pd(a.v, b.v)}; }
+inline Lanes operator/(Lanes a, Lanes b) { return {_mm256_div_pd(a.v, b.v)}; }
+inline Lanes Sqrt(Lanes a) { return {_mm256_sqrt_pd(a.v)}; }
+inline Lanes Min(Lanes a, Lanes b) { return {_mm256_min_pd(a.v, b.v)}; }
+inline Lanes Max(Lanes a, Lanes b) { return {_mm256_max_pd(a.v, b.v)}; }
+inline Lanes Abs(Lanes a) {
+    return {_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)};
+}
+// 每路取 a 的绝对值并带上 sign 的符号位
+inline Lanes CopySign(Lanes a, Lanes sign) {
+    __m256d mask = _mm256_set1_pd(-0.0);
+    return {_mm256_or_pd(_mm256_andnot_pd(mask, a.v), _mm256_and_pd(mask, sign.v))};
+}
+inline Lanes Greater(Lanes a, Lanes b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ)}; }
+inline Lanes Less(Lanes a, Lanes b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ)}; }
+inline Lanes Select(Lanes mask, Lanes t, Lanes f) {
+    return {_mm256_blendv_pd(f.v, t.v, mask.v)};
+}
+#elif defined(__SSE2__)
+struct Lanes {
+    static constexpr int kWidth = 2;
+    __m128d v;
+
+    static Lanes Set(double s) { return {_mm_set1_pd(s)}; }
+    static Lanes Load(const double* p) { return {_mm_loadu_pd(p)}; }
+    static Lanes Gather(const double* base, const int32_t* index) {
+        return {_mm_set_pd(base[index[1]], base[index[0]])};
+    }
+    void Store(double* p) const { _mm_storeu_pd(p, v); }
+};
+inline Lanes operator+(Lanes a, Lanes b) { return {_mm_add_pd(a.v, b.v)}; }
+inline Lanes operator-(Lanes a, Lanes b) { return {_mm_sub_pd(a.v, b.v)}; }
+inline Lanes operator*(Lanes a, Lanes b) { return {_mm_mul_pd(a.v, b.v)}; }
+inline Lanes operator/(Lanes a, Lanes b) { return {_mm_div_pd(a.v, b.v)}; }
+inline Lanes Sqrt(Lanes a) { return {_mm_sqrt_pd(a.v)}; }
+inline Lanes Min(Lanes a, Lanes b) { return {_mm_min_pd(a.v, b.v)}; }
+inline Lanes Max(Lanes a, Lanes b) { return {_mm_max_pd(a.v, b.v)}; }
+inline Lanes Abs(Lanes a) { return {_mm_andnot_pd(_mm_set1_pd(-0.0), a.v)}; }
+inline Lanes CopySign(Lanes a, Lanes sign) {
+    __m128d mask = _mm_set1_pd(-0.0);
+    return {_mm_or_pd(_mm_andnot_pd(mask, a.v), _mm_and_pd(mask, sign.v))};
+}
+inline Lanes Greater(Lanes a, Lanes b) { return {_mm_cmpgt_pd(a.v, b.v)}; }
+inline Lanes Less(Lanes a, Lanes b) { return {_mm_cmplt_pd(a.v, b.v)}; }
+// SSE2 没有 blendv，用位运算选择
+inline Lanes Select(Lanes mask, Lanes t, Lanes f) {
+    return {_mm_or_pd(_mm_and_pd(mask.v, t.v), _mm_andnot_pd(mask.v, f.v))};
+}
+#else
+struct Lanes {
+    static constexpr int kWidth = 1;
+    double v;
+    bool m = false;   // 比较结果
+
+    static Lanes Set(double s) { return {s}; }
+    static Lanes Load(const double* p) { return {*p}; }
+    static Lanes Gather(const double* base, const int32_t* index) {
+        return {base[index[0]]};
+    }
+    void Store(double* p) const { *p = v; }
+};
+inline Lanes operator+(Lanes a, Lanes b) { return {a.v + b.v}; }
+inline Lanes operator-(Lanes a, Lanes b) { return {a.v - b.v}; }
+inline Lanes operator*(Lanes a, Lanes b) { return {a.v * b.v}; }
+inline Lanes operator/(Lanes a, Lanes b) { return {a.v / b.v}; }
+inline Lanes Sqrt(Lanes a) { return {std::sqrt(a.v)}; }
+inline Lanes Min(Lanes a, Lanes b) { return {b.v < a.v ? b.v : a.v}; }
+inline Lanes Max(Lanes a, Lanes b) { return {b.v > a.v ? b.v : a.v}; }
+inline Lanes Abs(Lanes a) { return {std::fabs(a.v)}; }
+inline Lanes CopySign(Lanes a, Lanes sign) { return {std::copysign(a.v, sign.v)}; }
+inline Lanes Greater(Lanes a, Lanes b) { return {0.0, a.v > b.v}; }
+inline Lanes Less(Lanes a, Lanes b) { return {0.0, a.v < b.v}; }
+inline Lanes Select(Lanes mask, Lanes t, Lanes f) { return mask.m ? t : f; }
+#endif
+
+// ============ atan2 ============
+// Cephes atan 的有理逼近：先把参数约化到 [0, 1]（min/max），大于 tan(π/8)
+// 附近时再用 (a-1)/(a+1) 约化到 [-0.42, 0.42]，最后按象限还原。
+// 双精度下与 std::atan2 的误差在 1e-15 量级，无分支。
+inline Lanes Atan2(Lanes y, Lanes x) {
+    const Lanes zero = Lanes::Set(0.0);
+    const Lanes one = Lanes::Set(1.0);
+    const Lanes ax = Abs(x), ay = Abs(y);
+    const Lanes hi = Max(ax, ay), lo = Min(ax, ay);
+    // hi == 0（车辆四元数退化）时比值取 0
+    Lanes a = lo / Select(Greater(hi, zero), hi, one);
+
+    const Lanes reduce = Greater(a, Lanes::Set(0.66));
+    Lanes t = Select(reduce, (a - one) / (a + one), a);
+    Lanes base = Select(reduce, Lanes::Set(M_PI / 4), zero);
+    Lanes extra = Select(reduce, Lanes::Set(0.5 * 6.123233995736765886130e-17), zero);
+
+    Lanes z = t * t;
+    Lanes p = Lanes::Set(-8.750608600031904122785e-1);
+    p = p * z + Lanes::Set(-1.615753718733365076637e1);
+    p = p * z + Lanes::Set(-7.500855792314704667340e1);
+    p = p * z + Lanes::Set(-1.228866684490136173410e2);
+    p = p * z + Lanes::Set(-6.485021904942025371773e1);
+    Lanes q = z + Lanes::Set(2.485846490142306297962e1);
+    q = q * z + Lanes::Set(1.650270098316988542046e2);
+    q = q * z + Lanes::Set(4.328810604912902668951e2);
+    q = q * z + Lanes::Set(4.853903996359136964868e2);
+    q = q * z + Lanes::Set(1.945506571482613964425e2);
+    Lanes r = base + (t * (z * p / q) + t + extra);
+
+    // 还原：|y| > |x| 时取余角，x < 0 时取补角，符号跟随 y
+    r = Select(Greater(ay, ax), Lanes::Set(M_PI / 2) - r, r);
+    r = Select(Less(x, zero), Lanes::Set(M_PI) - r, r);
+    return CopySign(r, y);
+}
+
+}  // namespace
+
+// ============ 绑定 ============
+int FleetTelemetry::Bind(const mjModel* m, const std::string& name_prefix) {
+    if (m == model_ && name_prefix == name_prefix_) return num_vehicles_;
+    model_ = m;
+    name_prefix_ = name_prefix;
+    body_.clear();
+    qpos_adr_.clear();
+    qvel_adr_.clear();
+    has_previous_ = false;
+
+    if (m) {
+        for (int b = 1; b < m->nbody; b++) {
+            int joint = m->body_jntadr[b];
+            if (joint < 0 || m->jnt_type[joint] != mjJNT_FREE) continue;
+            if (!name_prefix.empty()) {
+                const char* name = mj_id2name(m, mjOBJ_BODY, b);
+                if (!name || std::strncmp(name, name_prefix.c_str(), name_prefix.size()) != 0) {
+                    continue;
+                }
+            }
+            body_.push_back(b);
+            qpos_adr_.push_back(m->jnt_qposadr[joint]);
+            qvel_adr_.push_back(m->jnt_dofadr[joint]);
+        }
+    }
+
+    num_vehicles_ = static_cast<int>(body_.size());
+    padded_ = (num_vehicles_ + Lanes::kWidth - 1) / Lanes::kWidth * Lanes::kWidth;
+    if (num_vehicles_ > 0) {
+        // 补齐的通道读取最后一辆车，结果写在 NumVehicles() 之后，调用方不可见
+        const int32_t last_qpos = qpos_adr_.back(), last_qvel = qvel_adr_.back();
+        qpos_adr_.resize(padded_, last_qpos);
+        qvel_adr_.resize(padded_, last_qvel);
+    }
+    for (std::vector<double>* field : {&x_, &y_, &speed_, &yaw_, &accel_, &previous_speed_}) {
+        field->assign(padded_, 0.0);
+    }
+    return num_vehicles_;
+}
+
+// ============ 提取 ============
+void FleetTelemetry::BeginStep(const mjData* d, double* inv_dt) {
+    double dt = has_previous_ ? d->time - previous_time_ : 0.0;
+    *inv_dt = dt > 0.0 ? 1.0 / dt : 0.0;
+    // 时间回退（重置）时重新开始差分
+    if (dt < 0.0) std::fill(accel_.begin(), accel_.end(), 0.0);
+}
+
+void FleetTelemetry::Extract(const mjData* d) {
+    if (num_vehicles_ == 0) return;
+    double inv_dt_value;
+    BeginStep(d, &inv_dt_value);
+    const bool update_accel = inv_dt_value > 0.0;
+    const Lanes inv_dt = Lanes::Set(inv_dt_value);
+    const Lanes one = Lanes::Set(1.0), two = Lanes::Set(2.0);
+    const double* qpos = d->qpos;
+    const double* qvel = d->qvel;
+
+    for (int i = 0; i < padded_; i += Lanes::kWidth) {
+        const int32_t* pa = qpos_adr_.data() + i;
+        const int32_t* va = qvel_adr_.data() + i;
+        // 自由关节 qpos: x y z qw qx qy qz；qvel 前三个为世界系线速度
+        Lanes x = Lanes::Gather(qpos, pa);
+        Lanes y = Lanes::Gather(qpos + 1, pa);
+        Lanes qw = Lanes::Gather(qpos + 3, pa);
+        Lanes qx = Lanes::Gather(qpos + 4, pa);
+        Lanes qy = Lanes::Gather(qpos + 5, pa);
+        Lanes qz = Lanes::Gather(qpos + 6, pa);
+        Lanes vx = Lanes::Gather(qvel, va);
+        Lanes vy = Lanes::Gather(qvel + 1, va);
+
+        Lanes speed = Sqrt(vx * vx + vy * vy);
+        Lanes yaw = Atan2(two * (qw * qz + qx * qy), one - two * (qy * qy + qz * qz));
+
+        x.Store(x_.data() + i);
+        y.Store(y_.data() + i);
+        yaw.Store(yaw_.data() + i);
+        speed.Store(speed_.data() + i);
+        if (update_accel) {
+            ((speed - Lanes::Load(previous_speed_.data() + i)) * inv_dt).Store(accel_.data() + i);
+        }
+        speed.Store(previous_speed_.data() + i);
+    }
+    previous_time_ = d->time;
+    has_previous_ = true;
+}
+
+void FleetTelemetry::ExtractReference(const mjData* d) {
+    if (num_vehicles_ == 0) return;
+    double inv_dt;
+    BeginStep(d, &inv_dt);
+    for (int i = 0; i < num_vehicles_; i++) {
+        const double* pos = d->qpos + qpos_adr_[i];
+        const double* vel = d->qvel + qvel_adr_[i];
+        double w = pos[3], qx = pos[4], qy = pos[5], qz = pos[6];
+        x_[i] = pos[0];
+        y_[i] = pos[1];
+        yaw_[i] = std::atan2(2.0 * (w * qz + qx * qy), 1.0 - 2.0 * (qy * qy + qz * qz));
+        speed_[i] = std::sqrt(vel[0] * vel[0] + vel[1] * vel[1]);
+        if (inv_dt > 0.0) accel_[i] = (speed_[i] - previous_speed_[i]) * inv_dt;
+        previous_speed_[i] = speed_[i];
+    }
+    previous_time_ = d->time;
+    has_previous_ = true;
+}
+
+// ============ 汇总 ============
+FleetTelemetry::Summary FleetTelemetry::Summarize() const {
+    Summary summary;
+    if (num_vehicles_ == 0) return summary;
+    for (int i = 0; i < num_vehicles_; i++) {
+        summary.mean_speed += speed_[i];
+        summary.max_speed = std::max(summary.max_speed, speed_[i]);
+        summary.mean_abs_accel += std::fabs(accel_[i]);
+        summary.centroid_x += x_[i];
+        summary.centroid_y += y_[i];
+    }
+    double inv_n = 1.0 / num_vehicles_;
+    summary.mean_speed *= inv_n;
+    summary.mean_abs_accel *= inv_n;
+    summary.centroid_x *= inv_n;
+    summary.centroid_y *= inv_n;
+    return summary;
+}
+
+const char* FleetTelemetry::KernelName() {
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSE2__)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+}  // namespace mjpc
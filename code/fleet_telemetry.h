@@ -0,0 +1,71 @@
+#ifndef MJPC_FLEET_TELEMETRY_H_
+#define MJPC_FLEET_TELEMETRY_H_
+
+#include <mujoco/mujoco.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mjpc {
+
+// ============ 多车遥测提取（SoA） ============
+// 场景中每辆车是一个带自由关节的 body。Bind 时为每辆车预先计算 qpos/qvel
+// 地址表，Extract 每步按地址表批量读取，输出按字段连续存放的数组：
+//   x, y      位置 (m)
+//   speed     水平速度 (m/s)
+//   yaw       偏航角（由四元数计算, rad）
+//   accel     水平速度的变化率 (m/s²)
+// 编译时启用 AVX2 时使用 4 路 gather 内核，仅有 SSE2 时为 2 路内核，
+// 否则为标量循环；三者计算方法相同（偏航角用同一个有理逼近的 atan2）。
+class FleetTelemetry {
+public:
+    // 车辆为带自由关节的 body；name_prefix 非空时只取名称以其开头的 body。
+    // 返回车辆数，模型指针不变时直接返回。
+    int Bind(const mjModel* m, const std::string& name_prefix = "");
+
+    // 从 d 提取所有车辆；仿真时间未推进时不更新加速度
+    void Extract(const mjData* d);
+    // 标量参考实现（使用 std::atan2），用于校验 SIMD 内核
+    void ExtractReference(const mjData* d);
+
+    int NumVehicles() const { return num_vehicles_; }
+    int BodyId(int vehicle) const { return body_[vehicle]; }
+
+    const double* X() const { return x_.data(); }
+    const double* Y() const { return y_.data(); }
+    const double* Speed() const { return speed_.data(); }
+    const double* Yaw() const { return yaw_.data(); }
+    const double* Accel() const { return accel_.data(); }
+
+    // 车队汇总（分析用）
+    struct Summary {
+        double mean_speed = 0.0;
+        double max_speed = 0.0;
+        double mean_abs_accel = 0.0;
+        double centroid_x = 0.0, centroid_y = 0.0;
+    };
+    Summary Summarize() const;
+
+    // 当前编译使用的内核："avx2"、"sse2" 或 "scalar"
+    static const char* KernelName();
+
+private:
+    void BeginStep(const mjData* d, double* inv_dt);
+
+    const mjModel* model_ = nullptr;
+    std::string name_prefix_;
+    int num_vehicles_ = 0;
+    int padded_ = 0;                            // 按 SIMD 宽度补齐的长度
+    std::vector<int> body_;
+    std::vector<int32_t> qpos_adr_, qvel_adr_;  // 补齐部分重复最后一辆车的地址
+
+    std::vector<double> x_, y_, speed_, yaw_, accel_;
+    std::vector<double> previous_speed_;
+    double previous_time_ = 0.0;
+    bool has_previous_ = false;
+};
+
+}  // namespace mjpc
+
+#endif  // MJPC_FLEET_TELEMETRY_H_
@@ -0,0 +1,220 @@
+#include "mjpc/frame_capture.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <GLFW/glfw3.h>
+#include <lodepng.h>
+
+#include "mjpc/threadpool.h"
+
+namespace mjpc {
+
+namespace {
+
+// ============ GL 入口（通过 GLFW 获取，不依赖 glext.h） ============
+constexpr unsigned int kPixelPackBuffer = 0x88EB;
+constexpr unsigned int kStreamRead = 0x88E1;
+constexpr unsigned int kReadOnly = 0x88B8;
+constexpr unsigned int kSyncGpuCommandsComplete = 0x9117;
+constexpr unsigned int kSyncFlushCommandsBit = 0x00000001;
+constexpr unsigned int kAlreadySignaled = 0x911A;
+constexpr unsigned int kConditionSatisfied = 0x911C;
+constexpr uint64_t kStopTimeoutNs = 1000000000ull;   // Stop 时每个读回最多等 1 s
+
+struct GLFunctions {
+    void (APIENTRY *GenBuffers)(int, unsigned int*) = nullptr;
+    void (APIENTRY *DeleteBuffers)(int, const unsigned int*) = nullptr;
+    void (APIENTRY *BindBuffer)(unsigned int, unsigned int) = nullptr;
+    void (APIENTRY *BufferData)(unsigned int, ptrdiff_t, const void*, unsigned int) = nullptr;
+    void* (APIENTRY *MapBuffer)(unsigned int, unsigned int) = nullptr;
+    unsigned char (APIENTRY *UnmapBuffer)(unsigned int) = nullptr;
+    void* (APIENTRY *FenceSync)(unsigned int, unsigned int) = nullptr;
+    unsigned int (APIENTRY *ClientWaitSync)(void*, unsigned int, uint64_t) = nullptr;
+    void (APIENTRY *DeleteSync)(void*) = nullptr;
+};
+
+GLFunctions gl;
+
+template <typename T>
+bool Load(T* function, const char* name) {
+    *function = reinterpret_cast<T>(glfwGetProcAddress(name));
+    return *function != nullptr;
+}
+
+bool LoadFunctions() {
+    return Load(&gl.GenBuffers, "glGenBuffers") &&
+           Load(&gl.DeleteBuffers, "glDeleteBuffers") &&
+           Load(&gl.BindBuffer, "glBindBuffer") &&
+           Load(&gl.BufferData, "glBufferData") &&
+           Load(&gl.MapBuffer, "glMapBuffer") &&
+           Load(&gl.UnmapBuffer, "glUnmapBuffer") &&
+           Load(&gl.FenceSync, "glFenceSync") &&
+           Load(&gl.ClientWaitSync, "glClientWaitSync") &&
+           Load(&gl.DeleteSync, "glDeleteSync");
+}
+
+}  // namespace
+
+FrameCapture::FrameCapture() = default;
+
+FrameCapture::~FrameCapture() { Stop(); }
+
+// ============ 启动/停止 ============
+bool FrameCapture::Start(const FrameCaptureOptions& options) {
+    if (running_) return false;
+    if (!LoadFunctions()) {
+        fprintf(stderr, "FrameCapture: PBO/sync functions unavailable\n");
+        return false;
+    }
+
+    options_ = options;
+    options_.pbo_count = std::max(options.pbo_count, 2);
+    options_.encoder_threads = std::max(options.encoder_threads, 1);
+    options_.queue_capacity = std::max(options.queue_capacity, 1);
+
+    readbacks_.assign(options_.pbo_count, Readback());
+    for (Readback& readback : readbacks_) gl.GenBuffers(1, &readback.buffer);
+    next_readback_ = 0;
+
+    images_.assign(options_.queue_capacity, Image());
+    free_images_.clear();
+    for (int i = options_.queue_capacity - 1; i >= 0; i--) free_images_.push_back(i);
+
+    pool_ = std::make_unique<ThreadPool>(options_.encoder_threads);
+    jobs_scheduled_ = 0;
+    frames_captured_ = 0;
+    frames_written_.store(0, std::memory_order_relaxed);
+    frames_dropped_.store(0, std::memory_order_relaxed);
+    write_errors_.store(0, std::memory_order_relaxed);
+    running_ = true;
+    return true;
+}
+
+void FrameCapture::Stop() {
+    if (!running_) return;
+
+    // 先等编码释放帧缓冲，再取回最后几帧
+    pool_->WaitCount(static_cast<int>(jobs_scheduled_));
+    Harvest(true);
+    pool_->WaitCount(static_cast<int>(jobs_scheduled_));
+    pool_.reset();
+
+    for (Readback& readback : readbacks_) {
+        if (readback.fence) gl.DeleteSync(readback.fence);
+        gl.DeleteBuffers(1, &readback.buffer);
+    }
+    readbacks_.clear();
+    images_.clear();
+    free_images_.clear();
+    running_ = false;
+}
+
+// ============ 读回 ============
+void FrameCapture::Capture(int x, int y, int width, int height) {
+    if (!running_ || width <= 0 || height <= 0) return;
+    Harvest(false);
+
+    // 轮到的 PBO 仍在读回中：GPU 落后太多，丢弃本帧而不是等待
+    Readback& readback = readbacks_[next_readback_];
+    if (readback.fence) {
+        frames_dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    size_t size = static_cast<size_t>(width) * height * 4;
+    gl.BindBuffer(kPixelPackBuffer, readback.buffer);
+    if (readback.capacity < size) {
+        gl.BufferData(kPixelPackBuffer, static_cast<ptrdiff_t>(size), nullptr, kStreamRead);
+        readback.capacity = size;
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);   // 写入 PBO，立即返回
+    gl.BindBuffer(kPixelPackBuffer, 0);
+
+    readback.fence = gl.FenceSync(kSyncGpuCommandsComplete, 0);
+    readback.frame = frames_captured_++;
+    readback.width = width;
+    readback.height = height;
+    next_readback_ = (next_readback_ + 1) % static_cast<int>(readbacks_.size());
+}
+
+void FrameCapture::Harvest(bool wait) {
+    const int count = static_cast<int>(readbacks_.size());
+    for (int i = 0; i < count; i++) {
+        // 从最早发起的读回开始
+        Readback& readback = readbacks_[(next_readback_ + i) % count];
+        if (!readback.fence) continue;
+        unsigned int status = gl.ClientWaitSync(readback.fence, kSyncFlushCommandsBit,
+                                                wait ? kStopTimeoutNs : 0);
+        bool complete = status == kAlreadySignaled || status == kConditionSatisfied;
+        if (!complete && !wait) continue;
+        gl.DeleteSync(readback.fence);
+        readback.fence = nullptr;
+
+        int image = -1;
+        if (complete) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!free_images_.empty()) {
+                image = free_images_.back();
+                free_images_.pop_back();
+            }
+        }
+        if (image < 0) {
+            // 编码跟不上（或等待超时）：丢弃
+            frames_dropped_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        // 复制出 PBO 并翻转为自上而下的行序；容量只在分辨率变大时增长
+        Image& target = images_[image];
+        size_t stride = static_cast<size_t>(readback.width) * 4;
+        target.pixels.resize(stride * readback.height);
+        target.frame = readback.frame;
+        target.width = readback.width;
+        target.height = readback.height;
+        gl.BindBuffer(kPixelPackBuffer, readback.buffer);
+        const unsigned char* pixels = static_cast<const unsigned char*>(gl.MapBuffer(kPixelPackBuffer, kReadOnly));
+        if (pixels) {
+            for (int row = 0; row < readback.height; row++) {
+                std::memcpy(target.pixels.data() + row * stride,
+                            pixels + (readback.height - 1 - row) * stride, stride);
+            }
+            gl.UnmapBuffer(kPixelPackBuffer);
+        }
+        gl.BindBuffer(kPixelPackBuffer, 0);
+        if (!pixels) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            free_images_.push_back(image);
+            frames_dropped_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        jobs_scheduled_++;
+        pool_->Schedule([this, image]() { Encode(image); });
+    }
+}
+
+// ============ 编码线程 ============
+void FrameCapture::Encode(int image) {
+    const Image& source = images_[image];
+    char name[32];
+    snprintf(name, sizeof(name), "_%06llu.png", static_cast<unsigned long long>(source.frame));
+    std::string path = options_.directory + "/" + options_.prefix + name;
+
+    unsigned error = lodepng::encode(path, source.pixels, source.width, source.height);
+    if (error) {
+        write_errors_.fetch_add(1, std::memory_order_relaxed);
+        fprintf(stderr, "FrameCapture: %s: %s\n", path.c_str(), lodepng_error_text(error));
+    } else {
+        frames_written_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_images_.push_back(image);
+}
+
+}  // namespace mjpc
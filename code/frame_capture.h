@@ -0,0 +1,90 @@
+#ifndef MJPC_FRAME_CAPTURE_H_
+#define MJPC_FRAME_CAPTURE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mjpc {
+
+class ThreadPool;
+
+// ============ 异步帧捕获 ============
+// 每帧把当前读帧缓冲（场景 + 仪表盘，交换缓冲前）异步读回到一组像素缓冲
+// 对象（PBO）中轮换使用，每次读回后插入 fence；之后的帧里 fence 已完成的
+// PBO 才被映射、复制到定长的帧缓冲池，交给线程池用 lodepng 编码成 PNG。
+// 主线程从不等待 GPU 或编码：PBO 仍在读回中或缓冲池已满时丢弃该帧并计数。
+//   capture.Start(options);          // GL 上下文为当前上下文
+//   ... 渲染场景和仪表盘 ...
+//   capture.Capture(0, 0, width, height);
+//   glfwSwapBuffers(window);
+struct FrameCaptureOptions {
+    std::string directory = ".";
+    std::string prefix = "frame";     // 文件名为 <prefix>_<帧号 6 位>.png
+    int pbo_count = 3;                // 读回轮换的 PBO 数（读回到映射之间相隔 pbo_count - 1 帧）
+    int encoder_threads = 2;
+    int queue_capacity = 8;           // 等待或正在编码的帧数上限
+};
+
+class FrameCapture {
+public:
+    FrameCapture();
+    ~FrameCapture();
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // 需要 GL 2.1 PBO 和 GL 3.2 sync 对象，不支持时返回 false
+    bool Start(const FrameCaptureOptions& options);
+    // 取回仍在读回中的帧，等待编码完成并释放 PBO；GL 上下文需为当前上下文
+    void Stop();
+    bool IsRunning() const { return running_; }
+
+    // 发起读回矩形 (x, y 为左下角，像素) 并处理已完成的读回，不阻塞
+    void Capture(int x, int y, int width, int height);
+
+    uint64_t FramesCaptured() const { return frames_captured_; }   // 发起读回的帧
+    uint64_t FramesWritten() const { return frames_written_.load(std::memory_order_relaxed); }
+    uint64_t FramesDropped() const { return frames_dropped_.load(std::memory_order_relaxed); }
+    uint64_t WriteErrors() const { return write_errors_.load(std::memory_order_relaxed); }
+
+private:
+    struct Readback {
+        unsigned int buffer = 0;
+        void* fence = nullptr;         // 非空表示读回进行中
+        size_t capacity = 0;           // 缓冲大小 (字节)
+        uint64_t frame = 0;
+        int width = 0, height = 0;
+    };
+    struct Image {
+        std::vector<unsigned char> pixels;   // RGBA，自上而下
+        uint64_t frame = 0;
+        int width = 0, height = 0;
+    };
+
+    // 映射已完成（wait 为真时等待）的读回并交给编码线程
+    void Harvest(bool wait);
+    void Encode(int image);
+
+    FrameCaptureOptions options_;
+    bool running_ = false;
+    std::vector<Readback> readbacks_;
+    int next_readback_ = 0;
+    uint64_t frames_captured_ = 0;
+    uint64_t jobs_scheduled_ = 0;
+
+    std::unique_ptr<ThreadPool> pool_;
+    std::mutex mutex_;                 // 保护 free_images_
+    std::vector<Image> images_;
+    std::vector<int> free_images_;
+
+    std::atomic<uint64_t> frames_written_{0};
+    std::atomic<uint64_t> frames_dropped_{0};
+    std::atomic<uint64_t> write_errors_{0};
+};
+
+}  // namespace mjpc
+
+#endif  // MJPC_FRAME_CAPTURE_H_
@@ -0,0 +1,93 @@
+#include "mjpc/grpc/telemetry_service.h"
+
+#include <cstring>
+
+namespace mjpc::telemetry_grpc {
+
+namespace {
+
+constexpr int kDefaultQueueCapacity = 256;
+constexpr int kDefaultBatchFrames = 64;
+constexpr double kPollTimeout = 0.1;   // 秒，检查客户端取消的间隔
+
+}  // namespace
+
+bool TelemetryService::ParseChannels(const telemetry::StreamTelemetryRequest& request,
+                                     uint32_t* mask, std::string* unknown) {
+    *mask = 0;
+    for (const std::string& name : request.channels()) {
+        int channel = 0;
+        while (channel < CHANNEL_COUNT && std::strcmp(TelemetryChannelName(channel), name.c_str()) != 0) {
+            channel++;
+        }
+        if (channel == CHANNEL_COUNT) {
+            if (unknown) *unknown = name;
+            return false;
+        }
+        *mask |= 1u << channel;
+    }
+    return true;
+}
+
+grpc::Status TelemetryService::StreamTelemetry(grpc::ServerContext* context,
+                                               const telemetry::StreamTelemetryRequest* request,
+                                               grpc::ServerWriter<telemetry::TelemetryBatch>* writer) {
+    BroadcastOptions options;
+    std::string unknown;
+    if (!ParseChannels(*request, &options.channels, &unknown)) {
+        return {grpc::StatusCode::INVALID_ARGUMENT, "unknown telemetry channel: " + unknown};
+    }
+    if (request->rate_hz() < 0.0 || request->queue_capacity() < 0 || request->max_batch_frames() < 0) {
+        return {grpc::StatusCode::INVALID_ARGUMENT, "rate_hz, queue_capacity and max_batch_frames must be >= 0"};
+    }
+    options.rate_hz = request->rate_hz();
+    options.queue_capacity = request->queue_capacity() > 0 ? request->queue_capacity() : kDefaultQueueCapacity;
+    options.overflow = request->overflow() == telemetry::StreamTelemetryRequest::COALESCE
+                           ? BROADCAST_COALESCE
+                           : BROADCAST_DROP_OLDEST;
+    const int max_frames = request->max_batch_frames() > 0 ? request->max_batch_frames() : kDefaultBatchFrames;
+
+    int id = broadcaster_->Subscribe(options);
+    const uint32_t mask = options.channels ? options.channels : (1u << CHANNEL_COUNT) - 1;
+
+    std::vector<BroadcastFrame> frames;
+    frames.reserve(max_frames);
+    telemetry::TelemetryBatch batch;
+    bool first = true;
+    grpc::Status status = grpc::Status::OK;
+
+    while (!context->IsCancelled()) {
+        frames.clear();
+        int count = broadcaster_->Next(id, &frames, max_frames, kPollTimeout);
+        if (count < 0) {
+            status = {grpc::StatusCode::UNAVAILABLE, "telemetry broadcaster shut down"};
+            break;
+        }
+        if (count == 0) continue;
+
+        batch.Clear();
+        if (first) {
+            for (int c = 0; c < CHANNEL_COUNT; c++) {
+                if ((mask >> c) & 1u) batch.add_channels(TelemetryChannelName(c));
+            }
+        }
+        for (const BroadcastFrame& frame : frames) {
+            telemetry::TelemetryFrame* out = batch.add_frames();
+            out->set_time(frame.time);
+            out->set_sequence(frame.sequence);
+            out->mutable_values()->Add(frame.values, frame.values + frame.num_values);
+        }
+        BroadcastStats stats = broadcaster_->Stats(id);
+        batch.set_dropped(stats.dropped);
+        batch.set_coalesced(stats.coalesced);
+
+        // 客户端断开时 Write 返回 false
+        if (!writer->Write(batch)) break;
+        first = false;
+    }
+
+    broadcaster_->Unsubscribe(id);
+    return status;
+}
+
+}  // namespace mjpc::telemetry_grpc
@@ -0,0 +1,43 @@
+#ifndef MJPC_GRPC_TELEMETRY_SERVICE_H_
+#define MJPC_GRPC_TELEMETRY_SERVICE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <grpcpp/server_context.h>
+#include <grpcpp/support/status.h>
+#include <grpcpp/support/sync_stream.h>
+
+#include "mjpc/grpc/telemetry.grpc.pb.h"
+#include "mjpc/grpc/telemetry.pb.h"
+#include "mjpc/telemetry_broadcast.h"
+
+namespace mjpc::telemetry_grpc {
+
+// ============ 遥测流服务 ============
+// 每个 StreamTelemetry 调用在广播器上注册一个订阅者，处理线程循环
+// Next 并把帧打包写出。写出阻塞（客户端慢）时仿真线程照常 Publish，
+// 积压由订阅者队列按请求的策略丢弃或合并。
+// 本地测试可以把服务注册到 grpc::Server 上，用 Server::InProcessChannel
+// 创建客户端存根，不经过网络。
+class TelemetryService final : public telemetry::Telemetry::Service {
+public:
+    // broadcaster 不持有所有权，须比服务活得久
+    explicit TelemetryService(TelemetryBroadcaster* broadcaster) : broadcaster_(broadcaster) {}
+
+    grpc::Status StreamTelemetry(grpc::ServerContext* context,
+                                 const telemetry::StreamTelemetryRequest* request,
+                                 grpc::ServerWriter<telemetry::TelemetryBatch>* writer) override;
+
+    // 通道名 -> 位掩码；有未知通道时返回 false 并写入 unknown
+    static bool ParseChannels(const telemetry::StreamTelemetryRequest& request, uint32_t* mask,
+                              std::string* unknown);
+
+private:
+    TelemetryBroadcaster* broadcaster_;
+};
+
+}  // namespace mjpc::telemetry_grpc
+
+#endif  // MJPC_GRPC_TELEMETRY_SERVICE_H_
@@ -0,0 +1,136 @@
+#include "mjpc/grpc/telemetry_service.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <grpcpp/client_context.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "gtest/gtest.h"
+#include "mjpc/dashboard_data.h"
+#include "mjpc/telemetry_broadcast.h"
+
+namespace mjpc::telemetry_grpc {
+namespace {
+
+// 服务注册到进程内服务器，客户端经 InProcessChannel 调用，不经过网络
+class TelemetryServiceTest : public testing::Test {
+protected:
+    void SetUp() override {
+        service_ = std::make_unique<TelemetryService>(&broadcaster_);
+        grpc::ServerBuilder builder;
+        builder.RegisterService(service_.get());
+        server_ = builder.BuildAndStart();
+        ASSERT_NE(server_, nullptr);
+        stub_ = telemetry::Telemetry::NewStub(server_->InProcessChannel(grpc::ChannelArguments()));
+    }
+
+    void TearDown() override {
+        StopPublishing();
+        broadcaster_.Shutdown();
+        server_->Shutdown();
+    }
+
+    // 后台线程以 1 ms 仿真步长持续发布，速度等于步数
+    void StartPublishing() {
+        publisher_ = std::thread([this]() {
+            DashboardData data;
+            for (int step = 0; !stop_.load(); step++) {
+                data.speed_ms = step;
+                data.rpm = 2000.0;
+                broadcaster_.Publish(0.001 * step, data);
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        });
+    }
+
+    void StopPublishing() {
+        stop_.store(true);
+        if (publisher_.joinable()) publisher_.join();
+    }
+
+    TelemetryBroadcaster broadcaster_;
+    std::unique_ptr<TelemetryService> service_;
+    std::unique_ptr<grpc::Server> server_;
+    std::unique_ptr<telemetry::Telemetry::Stub> stub_;
+    std::thread publisher_;
+    std::atomic<bool> stop_{false};
+};
+
+TEST_F(TelemetryServiceTest, StreamsSelectedChannels) {
+    telemetry::StreamTelemetryRequest request;
+    request.add_channels("speed_ms");
+    request.add_channels("rpm");
+    request.set_max_batch_frames(8);
+    grpc::ClientContext context;
+    auto reader = stub_->StreamTelemetry(&context, request);
+    StartPublishing();
+
+    telemetry::TelemetryBatch batch;
+    int batches = 0, frames = 0;
+    uint64_t last_sequence = 0;
+    double last_speed = -1.0;
+    while (frames < 100 && reader->Read(&batch)) {
+        if (batches == 0) {
+            ASSERT_EQ(batch.channels_size(), 2);
+            EXPECT_EQ(batch.channels(0), "speed_ms");
+            EXPECT_EQ(batch.channels(1), "rpm");
+        } else {
+            EXPECT_EQ(batch.channels_size(), 0);
+        }
+        EXPECT_LE(batch.frames_size(), 8);
+        for (const telemetry::TelemetryFrame& frame : batch.frames()) {
+            ASSERT_EQ(frame.values_size(), 2);
+            EXPECT_GT(frame.sequence(), last_sequence);
+            EXPECT_GT(frame.values(0), last_speed);
+            EXPECT_EQ(frame.values(1), 2000.0);
+            last_sequence = frame.sequence();
+            last_speed = frame.values(0);
+            frames++;
+        }
+        batches++;
+    }
+    EXPECT_GE(frames, 100);
+
+    // 客户端取消后服务端退出循环并取消订阅
+    context.TryCancel();
+    while (reader->Read(&batch)) {}
+    EXPECT_EQ(reader->Finish().error_code(), grpc::StatusCode::CANCELLED);
+    for (int i = 0; i < 100 && broadcaster_.NumSubscribers() > 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(broadcaster_.NumSubscribers(), 0);
+}
+
+TEST_F(TelemetryServiceTest, RejectsUnknownChannel) {
+    telemetry::StreamTelemetryRequest request;
+    request.add_channels("warp_factor");
+    grpc::ClientContext context;
+    auto reader = stub_->StreamTelemetry(&context, request);
+    telemetry::TelemetryBatch batch;
+    EXPECT_FALSE(reader->Read(&batch));
+    grpc::Status status = reader->Finish();
+    EXPECT_EQ(status.error_code(), grpc::StatusCode::INVALID_ARGUMENT);
+    EXPECT_EQ(broadcaster_.NumSubscribers(), 0);
+}
+
+TEST_F(TelemetryServiceTest, ShutdownEndsStream) {
+    telemetry::StreamTelemetryRequest request;
+    grpc::ClientContext context;
+    auto reader = stub_->StreamTelemetry(&context, request);
+    for (int i = 0; i < 100 && broadcaster_.NumSubscribers() == 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(broadcaster_.NumSubscribers(), 1);
+    broadcaster_.Shutdown();
+    telemetry::TelemetryBatch batch;
+    while (reader->Read(&batch)) {}
+    EXPECT_EQ(reader->Finish().error_code(), grpc::StatusCode::UNAVAILABLE);
+}
+
+}  // namespace
+}  // namespace mjpc::telemetry_grpc
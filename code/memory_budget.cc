@@ -0,0 +1,19 @@
+#include "mjpc/memory_budget.h"
+
+namespace mjpc {
+
+const char* MemorySubsystemName(int subsystem) {
+    static const char* const kNames[MEMORY_SUBSYSTEM_COUNT] = {
+        "vertex_buffers", "history", "textures", "recorder"
+    };
+    if (subsystem < 0 || subsystem >= MEMORY_SUBSYSTEM_COUNT) return "unknown";
+    return kNames[subsystem];
+}
+
+size_t MemoryUsage::Total() const {
+    size_t total = 0;
+    for (size_t value : bytes) total += value;
+    return total;
+}
+
+}  // namespace mjpc
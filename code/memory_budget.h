@@ -0,0 +1,40 @@
+#ifndef MJPC_MEMORY_BUDGET_H_
+#define MJPC_MEMORY_BUDGET_H_
+
+#include <cstddef>
+
+namespace mjpc {
+
+// ============ 内存统计与预算 ============
+// 仪表盘按子系统统计自身占用的内存（按实际分配的容量计算），
+// 每个子系统可以设置上限；超出上限时由对应子系统淘汰旧数据或降采样，
+// 而不是无限增长。
+enum MemorySubsystem {
+    MEMORY_VERTEX_BUFFERS,   // 图元顶点（绘制列表和填充率统计的暂存）
+    MEMORY_HISTORY,          // 历史缓冲（规划器耗时、代价历史、趋势图列）
+    MEMORY_TEXTURES,         // GL 纹理（辉光纹理、异步渲染目标），按纹素格式估算
+    MEMORY_RECORDER,         // 遥测记录器（未写出的编码块 + 金字塔索引）
+    MEMORY_SUBSYSTEM_COUNT
+};
+
+const char* MemorySubsystemName(int subsystem);
+
+// 各子系统当前占用 (字节)
+struct MemoryUsage {
+    size_t bytes[MEMORY_SUBSYSTEM_COUNT] = {};
+    size_t Total() const;
+};
+
+// 各子系统上限 (字节)，0 表示不限制
+struct MemoryBudget {
+    size_t cap[MEMORY_SUBSYSTEM_COUNT] = {};
+
+    bool Limited(int subsystem) const { return cap[subsystem] > 0; }
+    bool Exceeded(const MemoryUsage& usage, int subsystem) const {
+        return Limited(subsystem) && usage.bytes[subsystem] > cap[subsystem];
+    }
+};
+
+}  // namespace mjpc
+
+#endif  // MJPC_MEMORY_BUDGET_H_
@@ -0,0 +1,98 @@
+#include "mjpc/planner_stats.h"
+
+#include <algorithm>
+
+namespace mjpc {
+
+PlannerStats::PlannerStats() {
+    Reset();
+}
+
+void PlannerStats::Reset() {
+    plan_iterations_.store(0, std::memory_order_relaxed);
+    rollouts_.store(0, std::memory_order_relaxed);
+    missed_deadlines_.store(0, std::memory_order_relaxed);
+    last_plan_time_.store(0.0, std::memory_order_relaxed);
+    last_policy_latency_.store(0.0, std::memory_order_relaxed);
+    deadline_.store(0.02, std::memory_order_relaxed);  // task.xml 默认 agent_timestep
+    queue_depth_.store(0, std::memory_order_relaxed);
+    busy_workers_.store(0, std::memory_order_relaxed);
+    num_workers_.store(0, std::memory_order_relaxed);
+    busy_ns_.store(0, std::memory_order_relaxed);
+    for (int i = 0; i < kHistoryLength; i++) {
+        history_[i].store(0.0f, std::memory_order_relaxed);
+    }
+    history_head_.store(0, std::memory_order_relaxed);
+}
+
+// ============ 规划器端 ============
+void PlannerStats::RecordPlanIteration(double planning_seconds, int rollouts) {
+    last_plan_time_.store(planning_seconds, std::memory_order_relaxed);
+    rollouts_.fetch_add(static_cast<uint64_t>(std::max(rollouts, 0)),
+                        std::memory_order_relaxed);
+    if (planning_seconds > deadline_.load(std::memory_order_relaxed)) {
+        missed_deadlines_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 写入环形缓冲区；只有规划线程写，读端容忍撕裂的窗口边界
+    uint64_t head = history_head_.load(std::memory_order_relaxed);
+    history_[head % kHistoryLength].store(static_cast<float>(planning_seconds),
+                                          std::memory_order_relaxed);
+    history_head_.store(head + 1, std::memory_order_release);
+
+    plan_iterations_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PlannerStats::RecordPolicyUpdate(double latency_seconds) {
+    last_policy_latency_.store(latency_seconds, std::memory_order_relaxed);
+}
+
+void PlannerStats::SetDeadline(double seconds) {
+    if (seconds > 0.0) deadline_.store(seconds, std::memory_order_relaxed);
+}
+
+// ============ 线程池端 ============
+void PlannerStats::SetNumWorkers(int num_workers) {
+    num_workers_.store(num_workers, std::memory_order_relaxed);
+}
+
+void PlannerStats::OnJobFinished(double busy_seconds) {
+    busy_workers_.fetch_sub(1, std::memory_order_relaxed);
+    busy_ns_.fetch_add(static_cast<uint64_t>(busy_seconds * 1.0e9),
+                       std::memory_order_relaxed);
+}
+
+// ============ 读取端 ============
+void PlannerStats::Read(Snapshot* out) const {
+    if (!out) return;
+    out->plan_iterations = plan_iterations_.load(std::memory_order_relaxed);
+    out->rollouts = rollouts_.load(std::memory_order_relaxed);
+    out->missed_deadlines = missed_deadlines_.load(std::memory_order_relaxed);
+    out->last_plan_time = last_plan_time_.load(std::memory_order_relaxed);
+    out->last_policy_latency = last_policy_latency_.load(std::memory_order_relaxed);
+    // 入队/出队计数存在短暂的竞争窗口，读端截断为非负
+    out->queue_depth = std::max(queue_depth_.load(std::memory_order_relaxed), 0);
+    out->busy_workers = std::max(busy_workers_.load(std::memory_order_relaxed), 0);
+    out->num_workers = num_workers_.load(std::memory_order_relaxed);
+    out->busy_ns = busy_ns_.load(std::memory_order_relaxed);
+    out->wall_time = Now();
+}
+
+int PlannerStats::CopyHistory(float* out, int capacity) const {
+    if (!out || capacity <= 0) return 0;
+    uint64_t head = history_head_.load(std::memory_order_acquire);
+    int count = static_cast<int>(std::min<uint64_t>(head, kHistoryLength));
+    count = std::min(count, capacity);
+    for (int i = 0; i < count; i++) {
+        uint64_t index = head - count + i;
+        out[i] = history_[index % kHistoryLength].load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+PlannerStats& GlobalPlannerStats() {
+    static PlannerStats stats;
+    return stats;
+}
+
+}  // namespace mjpc
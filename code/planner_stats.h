@@ -0,0 +1,125 @@
+#ifndef MJPC_PLANNER_STATS_H_
+#define MJPC_PLANNER_STATS_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+namespace mjpc {
+
+// ============ 规划器 / 线程池性能计数器 ============
+// 所有写入都是 relaxed 原子操作，规划线程和线程池工作线程可以直接调用，
+// 不加锁；仪表盘在渲染线程中周期性地读取快照。
+//
+// 接入点：
+//   ThreadPool::Schedule     -> OnJobScheduled()
+//   ThreadPool 工作线程取到任务 -> OnJobStarted()
+//   ThreadPool 工作线程完成任务 -> OnJobFinished(耗时)
+//   Agent::PlanIteration     -> RecordPlanIteration(耗时, rollout 数)
+//   策略拷贝到 active policy  -> RecordPolicyUpdate(延迟)
+// 调用点在 threadpool.cc / agent.cc 中（本快照未包含这两个文件），可直接使用
+// 下方的 InstrumentJob 和 ScopedPlanIteration，无需改动 ThreadPool 接口。
+class PlannerStats {
+public:
+    // 滚动窗口长度（规划迭代次数）
+    static constexpr int kHistoryLength = 128;
+
+    // 计数器快照（渲染线程使用）
+    struct Snapshot {
+        uint64_t plan_iterations = 0;      // 累计规划迭代次数
+        uint64_t rollouts = 0;             // 累计 rollout 数
+        uint64_t missed_deadlines = 0;     // 累计超时次数（> agent_timestep）
+        double last_plan_time = 0.0;       // 最近一次规划耗时 (s)
+        double last_policy_latency = 0.0;  // 最近一次策略更新延迟 (s)
+        int queue_depth = 0;               // 线程池等待中的任务数
+        int busy_workers = 0;              // 正在执行任务的工作线程数
+        int num_workers = 0;               // 工作线程总数
+        uint64_t busy_ns = 0;              // 工作线程累计忙碌时间 (ns)
+        double wall_time = 0.0;            // 快照时刻 (s, steady_clock)
+    };
+
+    PlannerStats();
+
+    // ============ 规划器端 ============
+    void RecordPlanIteration(double planning_seconds, int rollouts);
+    void RecordPolicyUpdate(double latency_seconds);
+    // 控制周期（agent_timestep），用于统计超时
+    void SetDeadline(double seconds);
+    double Deadline() const { return deadline_.load(std::memory_order_relaxed); }
+
+    // ============ 线程池端 ============
+    void SetNumWorkers(int num_workers);
+    void OnJobScheduled() { queue_depth_.fetch_add(1, std::memory_order_relaxed); }
+    void OnJobStarted() {
+        queue_depth_.fetch_sub(1, std::memory_order_relaxed);
+        busy_workers_.fetch_add(1, std::memory_order_relaxed);
+    }
+    void OnJobFinished(double busy_seconds);
+
+    // ============ 读取端 ============
+    void Read(Snapshot* out) const;
+    // 按时间顺序拷贝最近的规划耗时，返回拷贝数量（<= capacity）
+    int CopyHistory(float* out, int capacity) const;
+
+    void Reset();
+
+    // 单调时钟（秒）
+    static double Now() {
+        return std::chrono::duration<double>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    std::atomic<uint64_t> plan_iterations_;
+    std::atomic<uint64_t> rollouts_;
+    std::atomic<uint64_t> missed_deadlines_;
+    std::atomic<double> last_plan_time_;
+    std::atomic<double> last_policy_latency_;
+    std::atomic<double> deadline_;
+    std::atomic<int> queue_depth_;
+    std::atomic<int> busy_workers_;
+    std::atomic<int> num_workers_;
+    std::atomic<uint64_t> busy_ns_;
+
+    // 规划耗时环形缓冲区
+    std::atomic<float> history_[kHistoryLength];
+    std::atomic<uint64_t> history_head_;
+};
+
+// 进程内共享实例（ThreadPool 与 Agent 无需额外传参即可上报）
+PlannerStats& GlobalPlannerStats();
+
+// ============ 接入辅助 ============
+// 包装提交给 ThreadPool::Schedule 的任务：包装时计入队列，执行时上报开始/结束
+// 例：pool.Schedule(InstrumentJob(GlobalPlannerStats(), [&]() { ... }));
+template <typename Job>
+auto InstrumentJob(PlannerStats& stats, Job job) {
+    stats.OnJobScheduled();
+    return [&stats, job = std::move(job)]() mutable {
+        stats.OnJobStarted();
+        double start = PlannerStats::Now();
+        job();
+        stats.OnJobFinished(PlannerStats::Now() - start);
+    };
+}
+
+// Agent::PlanIteration 内的作用域计时，析构时记录一次规划迭代
+// 例：ScopedPlanIteration timer(GlobalPlannerStats(), num_trajectory);
+class ScopedPlanIteration {
+public:
+    ScopedPlanIteration(PlannerStats& stats, int rollouts)
+        : stats_(stats), rollouts_(rollouts), start_(PlannerStats::Now()) {}
+    ~ScopedPlanIteration() { stats_.RecordPlanIteration(PlannerStats::Now() - start_, rollouts_); }
+    ScopedPlanIteration(const ScopedPlanIteration&) = delete;
+    ScopedPlanIteration& operator=(const ScopedPlanIteration&) = delete;
+
+private:
+    PlannerStats& stats_;
+    int rollouts_;
+    double start_;
+};
+
+}  // namespace mjpc
+
+#endif  // MJPC_PLANNER_STATS_H_
@@ -0,0 +1,96 @@
+#include "mjpc/quality_governor.h"
+
+#include <algorithm>
+
+namespace mjpc {
+
+// 升级退避的上限倍数；升级后的级别保持 kBackoffDecay 倍 restore_windows 个窗口后退避清零
+constexpr int kMaxBackoff = 16;
+constexpr int kBackoffDecay = 4;
+
+const QualitySettings& GetQualitySettings(int level) {
+    static const QualitySettings kLevels[kQualityLevels] = {
+        // glow  segments  animation  trace  strip  update
+        {true,   32,       0.0,       1,     1,     1.0},
+        {true,   24,       30.0,      2,     2,     0.5},
+        {false,  16,       20.0,      4,     4,     0.5},
+        {false,  12,       10.0,      8,     8,     0.25},
+    };
+    return kLevels[std::clamp(level, 0, kQualityLevels - 1)];
+}
+
+void QualityGovernor::Configure(const QualityGovernorOptions& options) {
+    options_ = options;
+    options_.window = std::max(options.window, 1);
+    options_.restore_windows = std::max(options.restore_windows, 1);
+    options_.min_level = std::clamp(options.min_level, 0, kQualityLevels - 1);
+    options_.max_level = std::clamp(options.max_level, options_.min_level, kQualityLevels - 1);
+    Reset();
+}
+
+void QualityGovernor::Reset() {
+    level_ = options_.min_level;
+    window_sum_ms_ = 0.0;
+    window_frames_ = 0;
+    average_ms_ = 0.0;
+    good_windows_ = 0;
+    required_windows_ = options_.restore_windows;
+    stable_windows_ = 0;
+    restored_ = false;
+    changes_ = 0;
+}
+
+void QualityGovernor::SetLevel(int level) {
+    level = std::clamp(level, options_.min_level, options_.max_level);
+    if (level != level_) ChangeLevel(level);
+    restored_ = false;
+}
+
+void QualityGovernor::ChangeLevel(int level) {
+    restored_ = level < level_;
+    level_ = level;
+    window_sum_ms_ = 0.0;
+    window_frames_ = 0;
+    good_windows_ = 0;
+    stable_windows_ = 0;
+    changes_++;
+}
+
+bool QualityGovernor::AddFrame(double frame_ms) {
+    if (!(frame_ms > 0.0) || frame_ms > options_.max_frame_ms) return false;
+    window_sum_ms_ += frame_ms;
+    if (++window_frames_ < options_.window) return false;
+
+    average_ms_ = window_sum_ms_ / window_frames_;
+    window_sum_ms_ = 0.0;
+    window_frames_ = 0;
+    const double target_ms = 1000.0 / std::max(options_.target_fps, 1.0);
+
+    // 降级
+    if (average_ms_ > target_ms * options_.degrade_ratio) {
+        if (level_ >= options_.max_level) return false;
+        if (restored_ && stable_windows_ == 0) {
+            required_windows_ = std::min(required_windows_ * 2,
+                                         options_.restore_windows * kMaxBackoff);
+        }
+        ChangeLevel(level_ + 1);
+        return true;
+    }
+
+    if (++stable_windows_ >= options_.restore_windows * kBackoffDecay && restored_) {
+        required_windows_ = options_.restore_windows;
+    }
+
+    // 升级（需要足够的余量，且连续多个窗口）
+    if (average_ms_ < target_ms * options_.restore_ratio && level_ > options_.min_level) {
+        if (++good_windows_ >= required_windows_) {
+            ChangeLevel(level_ - 1);
+            return true;
+        }
+    } else {
+        good_windows_ = 0;
+    }
+    return false;
+}
+
+}  // namespace mjpc
@@ -0,0 +1,80 @@
+#ifndef MJPC_QUALITY_GOVERNOR_H_
+#define MJPC_QUALITY_GOVERNOR_H_
+
+namespace mjpc {
+
+// ============ 画质级别 ============
+// 0 为完整画质，级别越高越省：辉光、圆弧细分、动画频率、小地图轨迹密度、
+// 趋势图列数和装饰性周期任务（轨迹、趋势图、代价）的频率依次降低。
+constexpr int kQualityLevels = 4;
+
+struct QualitySettings {
+    bool glow;                  // 辉光四边形
+    int circle_segments;        // 整圆的分段数（圆弧按同样的分段）
+    double animation_rate_hz;   // 动画更新频率，0 为每次 UpdateAnimation
+    int trace_stride;           // 小地图轨迹每隔几个采样取一点
+    int strip_chart_divisor;    // 趋势图列数除以此值
+    double update_rate_scale;   // 装饰性周期任务的频率倍数
+};
+
+// level 超出范围时取最近的级别
+const QualitySettings& GetQualitySettings(int level);
+
+// ============ 画质调节器 ============
+// 按帧统计最近 window 帧的平均工作时间（CPU 实际用于渲染的时间，不含等待
+// 垂直同步），每满一个窗口评估一次：
+//   平均工作时间 > 目标周期 × degrade_ratio            -> 降一级
+//   连续 restore_windows 个窗口 < 目标周期 × restore_ratio -> 升一级
+// 两个阈值之间为死区；每次改变级别后重新开始计窗口。刚升级就在下一个窗口
+// 降回的（说明升级后负担不起）升级所需窗口数加倍，升级后的级别稳定一段时间后
+// 才恢复，负载恰好在两级之间时不会反复切换。
+struct QualityGovernorOptions {
+    double target_fps = 60.0;
+    int window = 30;                 // 每次评估的帧数
+    double degrade_ratio = 0.9;      // 工作时间接近周期即降级，避免错过垂直同步
+    double restore_ratio = 0.6;
+    int restore_windows = 3;
+    double max_frame_ms = 250.0;     // 更长的帧视为停顿（窗口最小化、断点等），不计入
+    int min_level = 0;
+    int max_level = kQualityLevels - 1;
+};
+
+class QualityGovernor {
+public:
+    QualityGovernor() = default;
+    explicit QualityGovernor(const QualityGovernorOptions& options) { Configure(options); }
+
+    // 设置参数并回到 min_level
+    void Configure(const QualityGovernorOptions& options);
+    void Reset();
+
+    // 记录一帧的工作时间 (ms)，级别改变时返回 true
+    bool AddFrame(double frame_ms);
+    // 手动设置级别（限制在 [min_level, max_level]），重新开始计窗口
+    void SetLevel(int level);
+
+    int Level() const { return level_; }
+    const QualityGovernorOptions& Options() const { return options_; }
+    // 上一个完整窗口的平均工作时间 (ms) 和按它折算的帧率，还没有完整窗口时为 0
+    double AverageFrameMs() const { return average_ms_; }
+    double AverageFps() const { return average_ms_ > 0.0 ? 1000.0 / average_ms_ : 0.0; }
+    int NumChanges() const { return changes_; }
+
+private:
+    void ChangeLevel(int level);
+
+    QualityGovernorOptions options_;
+    int level_ = 0;
+    double window_sum_ms_ = 0.0;
+    int window_frames_ = 0;
+    double average_ms_ = 0.0;
+    int good_windows_ = 0;           // 连续满足升级条件的窗口数
+    int required_windows_ = 3;       // 当前升级所需窗口数（含退避）
+    int stable_windows_ = 0;         // 当前级别已保持的窗口数
+    bool restored_ = false;          // 当前级别由升级得到
+    int changes_ = 0;
+};
+
+}  // namespace mjpc
+
+#endif  // MJPC_QUALITY_GOVERNOR_H_
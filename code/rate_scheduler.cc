@@ -0,0 +1,123 @@
+#include "mjpc/rate_scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace mjpc {
+
+RateScheduler::RateScheduler(double tick) : tick_(tick > 0.0 ? tick : 0.001) {
+    for (int& head : slots_) head = -1;
+}
+
+int64_t RateScheduler::PeriodTicks(double rate_hz) const {
+    if (!(rate_hz > 0.0)) return 0;
+    return std::max<int64_t>(1, llround(1.0 / (rate_hz * tick_)));
+}
+
+// ============ 任务 ============
+int RateScheduler::Add(const char* name, double rate_hz) {
+    if (num_tasks_ >= kMaxTasks) return -1;
+    int task = num_tasks_++;
+    tasks_[task].name = name;
+    SetRate(task, rate_hz);
+    return task;
+}
+
+void RateScheduler::SetRate(int task, double rate_hz) {
+    if (task < 0 || task >= num_tasks_) return;
+    Remove(task);
+    Task& current = tasks_[task];
+    current.rate = std::max(rate_hz, 0.0);
+    current.period = PeriodTicks(rate_hz);
+    uint32_t bit = 1u << task;
+    if (current.period == 0) {
+        every_advance_ |= bit;
+        immediate_ &= ~bit;
+    } else {
+        every_advance_ &= ~bit;
+        immediate_ |= bit;
+    }
+}
+
+int RateScheduler::Find(const char* name) const {
+    for (int i = 0; i < num_tasks_; i++) {
+        if (strcmp(tasks_[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+void RateScheduler::Reset() {
+    for (int i = 0; i < num_tasks_; i++) {
+        if (tasks_[i].period == 0) continue;
+        Remove(i);
+        immediate_ |= 1u << i;
+    }
+}
+
+// ============ 时间轮 ============
+void RateScheduler::Insert(int task) {
+    int slot = static_cast<int>(((tasks_[task].due % kSlots) + kSlots) % kSlots);
+    tasks_[task].next = slots_[slot];
+    slots_[slot] = task;
+}
+
+void RateScheduler::Remove(int task) {
+    int slot = static_cast<int>(((tasks_[task].due % kSlots) + kSlots) % kSlots);
+    for (int* link = &slots_[slot]; *link >= 0; link = &tasks_[*link].next) {
+        if (*link == task) {
+            *link = tasks_[task].next;
+            break;
+        }
+    }
+    tasks_[task].next = -1;
+}
+
+uint32_t RateScheduler::Advance(double time) {
+    // 取最近的 tick，避免 0.002 这类步长的累积误差把到期时刻推后一个 tick
+    int64_t target = llround(time / tick_);
+    if (!started_ || target < current_) {
+        // 首次调用或时间回退（仿真重置）
+        Reset();
+        started_ = true;
+        current_ = target;
+    }
+    uint32_t mask = every_advance_;
+
+    // 只访问经过的槽位，最多转一圈
+    int64_t steps = std::min<int64_t>(target - current_, kSlots);
+    for (int64_t i = 1; i <= steps; i++) {
+        int slot = static_cast<int>((((current_ + i) % kSlots) + kSlots) % kSlots);
+        int task = slots_[slot];
+        while (task >= 0) {
+            int next = tasks_[task].next;
+            Task& current = tasks_[task];
+            if (current.due <= target) {
+                mask |= 1u << task;
+                Remove(task);
+                // 错过的周期合并为一次，保持相位
+                current.due += current.period;
+                if (current.due <= target) {
+                    current.due += ((target - current.due) / current.period + 1) * current.period;
+                }
+                Insert(task);
+            }
+            task = next;
+        }
+    }
+
+    // 新加入或改频率的任务立即到期，从当前 tick 起按周期计
+    for (int task = 0; immediate_ != 0 && task < num_tasks_; task++) {
+        uint32_t bit = 1u << task;
+        if (!(immediate_ & bit)) continue;
+        immediate_ &= ~bit;
+        mask |= bit;
+        tasks_[task].due = target + tasks_[task].period;
+        Insert(task);
+    }
+
+    current_ = target;
+    return mask;
+}
+
+}  // namespace mjpc
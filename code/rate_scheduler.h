@@ -0,0 +1,68 @@
+#ifndef MJPC_RATE_SCHEDULER_H_
+#define MJPC_RATE_SCHEDULER_H_
+
+#include <cstdint>
+
+namespace mjpc {
+
+// ============ 多频率调度（时间轮） ============
+// 每个任务有自己的频率 (Hz，按调用方传入的时间计，仪表盘使用仿真时间)。
+// 任务按下一次到期的 tick 挂在 kSlots 个槽位的链表上，Advance 只访问
+// 经过的槽位，开销与任务总数无关；频率为 0 的任务每次 Advance 都到期。
+//
+// Advance 返回本次到期任务的位掩码，由调用方分派。两次 Advance 之间
+// 错过多个周期的任务只触发一次，之后保持原相位。全部状态为定长数组，
+// 运行时不分配内存。
+class RateScheduler {
+public:
+    static constexpr int kMaxTasks = 32;
+    static constexpr int kSlots = 64;
+    static constexpr double kEveryAdvance = 0.0;
+
+    // tick 为时间轮分辨率 (s)，任务周期按 tick 取整
+    explicit RateScheduler(double tick = 0.001);
+
+    // 添加任务，返回任务编号（按添加顺序从 0 开始），已满时返回 -1。
+    // name 需为静态字符串。新任务在下一次 Advance 时到期。
+    int Add(const char* name, double rate_hz);
+    // 修改频率，从下一次 Advance 起按新周期计
+    void SetRate(int task, double rate_hz);
+    double Rate(int task) const { return tasks_[task].rate; }
+    const char* Name(int task) const { return tasks_[task].name; }
+    int NumTasks() const { return num_tasks_; }
+    // 按名称查找任务，不存在时返回 -1
+    int Find(const char* name) const;
+
+    // 推进到 time；time 回退时视为重置，所有任务立即到期
+    uint32_t Advance(double time);
+    // 所有任务在下一次 Advance 时到期
+    void Reset();
+
+    static bool Due(uint32_t mask, int task) { return (mask >> task) & 1u; }
+
+private:
+    struct Task {
+        const char* name = "";
+        double rate = 0.0;
+        int64_t period = 0;      // tick 数，0 为每次 Advance
+        int64_t due = 0;         // 下一次到期的 tick
+        int next = -1;           // 同一槽位链表中的下一个任务
+    };
+
+    void Insert(int task);
+    void Remove(int task);
+    int64_t PeriodTicks(double rate_hz) const;
+
+    double tick_;
+    int64_t current_ = 0;        // 已处理到的 tick
+    bool started_ = false;
+    Task tasks_[kMaxTasks];
+    int num_tasks_ = 0;
+    uint32_t every_advance_ = 0; // 频率为 0 的任务
+    uint32_t immediate_ = 0;     // 下一次 Advance 立即到期（新加入、改频率、重置）
+    int slots_[kSlots];          // 各槽位链表头
+};
+
+}  // namespace mjpc
+
+#endif  // MJPC_RATE_SCHEDULER_H_
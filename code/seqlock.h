@@ -0,0 +1,75 @@
+#ifndef MJPC_SEQLOCK_H_
+#define MJPC_SEQLOCK_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace mjpc {
+
+// ============ 顺序锁（单写多读） ============
+// 写者不等待读者：写前把序号加 1（奇数表示正在写），写完再加 1。
+// 读者复制数据前后各读一次序号，序号为奇数或前后不一致时重试。
+// 数据按 64 位字以 relaxed 原子操作读写，读写并发时没有数据竞争；
+// 对象本身是标准布局，可以直接放在共享内存中（要求 64 位原子无锁）。
+// 只允许一个写者，多个写者需在外部互斥。
+template <typename T>
+class SeqLock {
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock requires a trivially copyable T");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "SeqLock requires lock-free 64-bit atomics");
+    static constexpr int kWords = static_cast<int>((sizeof(T) + 7) / 8);
+
+    SeqLock() { Reset(); }
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    // 清零（仅在没有并发读写时调用，例如刚映射的共享内存）
+    void Reset() {
+        sequence_.store(0, std::memory_order_relaxed);
+        for (int i = 0; i < kWords; i++) words_[i].store(0, std::memory_order_relaxed);
+    }
+
+    void Write(const T& value) {
+        uint64_t words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+        uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (int i = 0; i < kWords; i++) words_[i].store(words[i], std::memory_order_relaxed);
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    // 读一次，读到一致的数据时返回 true；写者正在写时返回 false
+    bool TryRead(T* value, uint64_t* sequence = nullptr) const {
+        uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1) return false;
+        uint64_t words[kWords];
+        for (int i = 0; i < kWords; i++) words[i] = words_[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) != before) return false;
+        std::memcpy(value, words, sizeof(T));
+        if (sequence) *sequence = before;
+        return true;
+    }
+
+    // 最多重试 max_attempts 次
+    bool Read(T* value, uint64_t* sequence = nullptr, int max_attempts = 1000) const {
+        for (int i = 0; i < max_attempts; i++) {
+            if (TryRead(value, sequence)) return true;
+        }
+        return false;
+    }
+
+    // 当前序号（偶数为稳定状态，每次写入加 2），可用于判断是否有新数据
+    uint64_t Sequence() const { return sequence_.load(std::memory_order_acquire); }
+
+private:
+    std::atomic<uint64_t> sequence_;
+    std::atomic<uint64_t> words_[kWords];
+};
+
+}  // namespace mjpc
+
+#endif  // MJPC_SEQLOCK_H_
@@ -0,0 +1,251 @@
+#include "mjpc/stress_scene.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+
+namespace mjpc {
+
+namespace {
+
+// 车辆在网格中的起点（网格以原点为中心）
+void GridPosition(const StressSceneOptions& options, int columns, int rows, int car,
+                  double* x, double* y) {
+    int row = car / columns;
+    int column = car % columns;
+    *x = (column - 0.5 * (columns - 1)) * options.spacing;
+    *y = (row - 0.5 * (rows - 1)) * options.spacing;
+}
+
+void Append(std::string* xml, const char* format, ...) {
+    char buffer[1024];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    xml->append(buffer);
+}
+
+}  // namespace
+
+std::string StressSceneName(const char* base, int car) {
+    if (car == 0) return base;
+    return std::string(base) + "_" + std::to_string(car);
+}
+
+// ============ MJCF 生成 ============
+std::string StressSceneXml(const StressSceneOptions& options) {
+    const int num_cars = std::max(options.num_cars, 1);
+    const int columns = options.columns > 0
+        ? options.columns
+        : static_cast<int>(std::ceil(std::sqrt(static_cast<double>(num_cars))));
+    const int rows = (num_cars + columns - 1) / columns;
+    auto name = [](const char* base, int car) { return StressSceneName(base, car); };
+
+    // 地面覆盖整个网格和目标点
+    double half_x = 0.5 * (columns - 1) * options.spacing + std::fabs(options.goal_offset_x) + 1.0;
+    double half_y = 0.5 * (rows - 1) * options.spacing + std::fabs(options.goal_offset_y) + 1.0;
+    half_x = std::max(half_x, 3.0);
+    half_y = std::max(half_y, 3.0);
+
+    std::string xml;
+    xml.reserve(4096 + static_cast<size_t>(num_cars) * 3072);
+    Append(&xml, "<mujoco model=\"Simple Car Stress %d\">\n", num_cars);
+    xml +=
+        "  <compiler autolimits=\"true\"/>\n"
+        "  <option timestep=\"0.002\" iterations=\"50\" solver=\"Newton\" tolerance=\"1e-10\">\n"
+        "    <flag gravity=\"enable\"/>\n"
+        "  </option>\n";
+    // 接触缓冲按车辆数放大
+    Append(&xml, "  <size memory=\"%dM\"/>\n\n", 1 + num_cars / 4);
+
+    xml +=
+        "  <custom>\n"
+        "    <numeric name=\"agent_planner\" data=\"1\"/>\n"
+        "    <numeric name=\"agent_horizon\" data=\"2.0\"/>\n"
+        "    <numeric name=\"agent_timestep\" data=\"0.02\"/>\n"
+        "    <numeric name=\"sampling_sample_width\" data=\"0.02\"/>\n"
+        "    <numeric name=\"sampling_control_width\" data=\"0.03\"/>\n"
+        "    <numeric name=\"sampling_spline_points\" data=\"10\"/>\n"
+        "    <numeric name=\"sampling_exploration\" data=\"0.5\"/>\n"
+        "    <numeric name=\"gradient_spline_points\" data=\"10\"/>\n"
+        "    <numeric name=\"residual_Goal_Position_x\" data=\"1.0 0.0 0.0 3.0\"/>\n"
+        "    <numeric name=\"residual_Goal_Position_y\" data=\"1.0 0.0 0.0 3.0\"/>\n"
+        "    <numeric name=\"estimator\" data=\"0\"/>\n"
+        "  </custom>\n\n";
+
+    xml +=
+        "  <asset>\n"
+        "    <texture name=\"grid\" type=\"2d\" builtin=\"checker\" width=\"512\" height=\"512\" rgb1=\".1 .2 .3\" rgb2=\".2 .3 .4\"/>\n"
+        "    <material name=\"grid\" texture=\"grid\" texrepeat=\"1 1\" texuniform=\"true\" reflectance=\".2\"/>\n"
+        "    <mesh name=\"chasis\" scale=\".01 .006 .0015\"\n"
+        "      vertex=\" 9 2 0  -10 10 10  9 -2 0  10 3 -10  10 -3 -10  -8 10 -10  -10 -10 10  -8 -10 -10  -5 0 20\"/>\n"
+        "  </asset>\n\n"
+        "  <default>\n"
+        "    <joint damping=\".05\" armature=\"0.005\"/>\n"
+        "    <geom friction=\"1 0.5 0.5\" condim=\"3\"/>\n"
+        "    <default class=\"wheel\">\n"
+        "      <geom type=\"cylinder\" size=\".03 .01\" rgba=\".5 .5 1 1\" friction=\"1.5 0.5 0.5\"/>\n"
+        "    </default>\n"
+        "    <default class=\"decor\">\n"
+        "      <site type=\"box\" rgba=\".5 1 .5 1\"/>\n"
+        "    </default>\n"
+        "  </default>\n\n";
+
+    // ============ 车辆和目标点 ============
+    // 车辆 body 在前、目标在后，保证第 0 辆车和它的目标分别是第一个自由关节和第一个 mocap
+    xml += "  <worldbody>\n";
+    Append(&xml, "    <geom type=\"plane\" size=\"%g %g .01\" material=\"grid\" friction=\"1 0.5 0.5\" condim=\"3\"/>\n",
+           half_x, half_y);
+    for (int i = 0; i < num_cars; i++) {
+        double x, y;
+        GridPosition(options, columns, rows, i, &x, &y);
+        Append(&xml, "    <body name=\"%s\" pos=\"%g %g .05\">\n", name("car", i).c_str(), x, y);
+        xml +=
+            "      <freejoint/>\n"
+            "      <inertial pos=\"0 0 0\" mass=\"1\" diaginertia=\"0.02 0.02 0.03\"/>\n";
+        if (i == 0 || options.lights) {
+            Append(&xml, "      <light name=\"%s\" pos=\"0 0 2\" mode=\"trackcom\" diffuse=\".4 .4 .4\"/>\n",
+                   name("top light", i).c_str());
+        }
+        Append(&xml, "      <geom name=\"%s\" type=\"mesh\" mesh=\"chasis\"/>\n", name("chasis", i).c_str());
+        Append(&xml, "      <geom name=\"%s\" pos=\".08 0 -.015\" type=\"sphere\" size=\".015\" condim=\"1\" priority=\"1\"/>\n",
+               name("front wheel", i).c_str());
+        if (i == 0 || options.lights) {
+            Append(&xml, "      <light name=\"%s\" pos=\".1 0 .02\" dir=\"2 0 -1\" diffuse=\"1 1 1\"/>\n",
+                   name("front light", i).c_str());
+        }
+        const char* sides[2] = {"left", "right"};
+        const char* offsets[2] = {".06", "-.06"};
+        for (int s = 0; s < 2; s++) {
+            std::string wheel = std::string(sides[s]) + " wheel";
+            Append(&xml, "      <body name=\"%s\" pos=\"-.07 %s 0\" zaxis=\"0 1 0\">\n",
+                   name(wheel.c_str(), i).c_str(), offsets[s]);
+            Append(&xml, "        <joint name=\"%s\"/>\n", name(sides[s], i).c_str());
+            xml +=
+                "        <geom class=\"wheel\"/>\n"
+                "        <site class=\"decor\" size=\".006 .025 .012\"/>\n"
+                "        <site class=\"decor\" size=\".025 .006 .012\"/>\n"
+                "      </body>\n";
+        }
+        xml += "    </body>\n";
+    }
+    for (int i = 0; i < num_cars; i++) {
+        double x, y;
+        GridPosition(options, columns, rows, i, &x, &y);
+        Append(&xml, "    <body name=\"%s\" mocap=\"true\" pos=\"%g %g 0.01\">\n",
+               name("goal", i).c_str(), x + options.goal_offset_x, y + options.goal_offset_y);
+        Append(&xml, "      <geom name=\"%s\" type=\"sphere\" size=\"0.08\" rgba=\"0 1 0 .5\" contype=\"0\" conaffinity=\"0\"/>\n",
+               name("goal", i).c_str());
+        xml += "    </body>\n";
+    }
+    xml += "  </worldbody>\n\n";
+
+    // ============ 传动 ============
+    xml += "  <tendon>\n";
+    for (int i = 0; i < num_cars; i++) {
+        std::string left = name("left", i), right = name("right", i);
+        Append(&xml, "    <fixed name=\"%s\">\n", name("forward", i).c_str());
+        Append(&xml, "      <joint joint=\"%s\" coef=\".5\"/>\n", left.c_str());
+        Append(&xml, "      <joint joint=\"%s\" coef=\".5\"/>\n", right.c_str());
+        xml += "    </fixed>\n";
+        Append(&xml, "    <fixed name=\"%s\">\n", name("turn", i).c_str());
+        Append(&xml, "      <joint joint=\"%s\" coef=\"-.5\"/>\n", left.c_str());
+        Append(&xml, "      <joint joint=\"%s\" coef=\".5\"/>\n", right.c_str());
+        xml += "    </fixed>\n";
+    }
+    xml += "  </tendon>\n\n  <actuator>\n";
+    for (int i = 0; i < num_cars; i++) {
+        std::string forward = name("forward", i), turn = name("turn", i);
+        Append(&xml, "    <motor name=\"%s\" tendon=\"%s\" ctrlrange=\"-1 1\" gear=\"12\"/>\n",
+               forward.c_str(), forward.c_str());
+        Append(&xml, "    <motor name=\"%s\" tendon=\"%s\" ctrlrange=\"-1 1\" gear=\"6\"/>\n",
+               turn.c_str(), turn.c_str());
+    }
+    xml += "  </actuator>\n\n";
+
+    // ============ 传感器（user 传感器必须在最前面且连续） ============
+    xml +=
+        "  <sensor>\n"
+        "    <user name=\"Goal_Position_x\" dim=\"1\" user=\"0 10.0 0 100.0\"/>\n"
+        "    <user name=\"Goal_Position_y\" dim=\"1\" user=\"0 10.0 0 100.0\"/>\n"
+        "    <user name=\"Control_Forward\" dim=\"1\" user=\"0 0.1 0.0 1.0\"/>\n"
+        "    <user name=\"Control_Turn\" dim=\"1\" user=\"0 0.1 0.0 1.0\"/>\n";
+    for (int i = 0; i < num_cars; i++) {
+        std::string car = name("car", i);
+        Append(&xml, "    <framelinvel name=\"%s\" objtype=\"body\" objname=\"%s\"/>\n",
+               name("car_velocity", i).c_str(), car.c_str());
+        Append(&xml, "    <frameangvel name=\"%s\" objtype=\"body\" objname=\"%s\"/>\n",
+               name("car_angular_velocity", i).c_str(), car.c_str());
+        // 与 task.xml 相同，力矩传感器与关节同名
+        std::string right = name("right", i), left = name("left", i);
+        Append(&xml, "    <jointactuatorfrc name=\"%s\" joint=\"%s\"/>\n", right.c_str(), right.c_str());
+        Append(&xml, "    <jointactuatorfrc name=\"%s\" joint=\"%s\"/>\n", left.c_str(), left.c_str());
+        Append(&xml, "    <framepos name=\"%s\" objtype=\"body\" objname=\"%s\"/>\n",
+               name("trace0", i).c_str(), car.c_str());
+    }
+    xml += "  </sensor>\n\n";
+
+    // ============ 初始关键帧（每辆车 7 + 2 个 qpos） ============
+    xml += "  <keyframe>\n    <key name=\"home\" qpos=\"";
+    for (int i = 0; i < num_cars; i++) {
+        double x, y;
+        GridPosition(options, columns, rows, i, &x, &y);
+        Append(&xml, "%s%g %g 0 1 0 0 0 0 0", i ? "  " : "", x, y);
+    }
+    xml += "\"/>\n  </keyframe>\n</mujoco>\n";
+    return xml;
+}
+
+bool WriteStressScene(const std::string& path, const StressSceneOptions& options) {
+    FILE* file = fopen(path.c_str(), "w");
+    if (!file) return false;
+    std::string xml = StressSceneXml(options);
+    bool ok = fwrite(xml.data(), 1, xml.size(), file) == xml.size();
+    return fclose(file) == 0 && ok;
+}
+
+// ============ 对象编号 ============
+int StressSceneIndex::Bind(const mjModel* m) {
+    car_body.clear();
+    forward.clear();
+    turn.clear();
+    goal_mocap.clear();
+    wheels.clear();
+    if (!m) return 0;
+    for (int i = 0;; i++) {
+        int body = mj_name2id(m, mjOBJ_BODY, StressSceneName("car", i).c_str());
+        int forward_id = mj_name2id(m, mjOBJ_ACTUATOR, StressSceneName("forward", i).c_str());
+        int turn_id = mj_name2id(m, mjOBJ_ACTUATOR, StressSceneName("turn", i).c_str());
+        int goal = mj_name2id(m, mjOBJ_BODY, StressSceneName("goal", i).c_str());
+        if (body < 0 || forward_id < 0 || turn_id < 0) break;
+        car_body.push_back(body);
+        forward.push_back(forward_id);
+        turn.push_back(turn_id);
+        goal_mocap.push_back(goal >= 0 ? m->body_mocapid[goal] : -1);
+        wheels.push_back(BindWheels(m, StressSceneName("left", i), StressSceneName("right", i)));
+    }
+    return NumCars();
+}
+
+// ============ 控制 ============
+void StressPursuitControl(mjData* d, const StressSceneIndex& index) {
+    for (int i = 0; i < index.NumCars(); i++) {
+        if (index.goal_mocap[i] < 0) continue;
+        const double* goal = d->mocap_pos + 3 * index.goal_mocap[i];
+        const double* pos = d->xpos + 3 * index.car_body[i];
+        const double* quat = d->xquat + 4 * index.car_body[i];
+        double yaw = atan2(2.0 * (quat[0] * quat[3] + quat[1] * quat[2]),
+                           1.0 - 2.0 * (quat[2] * quat[2] + quat[3] * quat[3]));
+        double dx = goal[0] - pos[0];
+        double dy = goal[1] - pos[1];
+        double distance = sqrt(dx * dx + dy * dy);
+        double heading_error = atan2(dy, dx) - yaw;
+        heading_error = atan2(sin(heading_error), cos(heading_error));
+        d->ctrl[index.forward[i]] = std::clamp(2.0 * distance * cos(heading_error), -1.0, 1.0);
+        d->ctrl[index.turn[i]] = std::clamp(1.5 * heading_error, -1.0, 1.0);
+    }
+}
+
+}  // namespace mjpc
@@ -0,0 +1,58 @@
+#ifndef MJPC_STRESS_SCENE_H_
+#define MJPC_STRESS_SCENE_H_
+
+#include <mujoco/mujoco.h>
+
+#include <string>
+#include <vector>
+
+#include "mjpc/drivetrain.h"
+
+namespace mjpc {
+
+// ============ 多车压力场景 ============
+// 生成包含 N 辆 car_model.xml 车辆的独立 MJCF（不依赖 include），用于测量
+// 仪表盘和遥测随车辆数的扩展性。车辆按网格排列，每辆车有一个对应的目标点。
+//
+// 命名：第 0 辆车保持原名（car、left、right、forward、turn、goal ...），
+// 与单车任务和仪表盘的名称查找兼容；第 i 辆车在所有名称后加 "_i"
+// （car_3、left wheel_3、forward_3、goal_3 ...）。
+// 代价用的 user 传感器只属于第 0 辆车，其余传感器每辆车一份。
+
+struct StressSceneOptions {
+    int num_cars = 1;
+    int columns = 0;              // 每行车辆数，0 为 ceil(sqrt(N))
+    double spacing = 0.6;         // 网格间距 (m)
+    double goal_offset_x = 1.0;   // 目标点相对各车起点的偏移 (m)
+    double goal_offset_y = 1.0;
+    bool lights = false;          // 每辆车的两盏灯（渲染器灯光数量有限，默认只保留第 0 辆）
+};
+
+// 第 i 辆车的对象名称
+std::string StressSceneName(const char* base, int car);
+
+// 生成 MJCF 文本
+std::string StressSceneXml(const StressSceneOptions& options);
+
+// 写出到文件，成功返回 true
+bool WriteStressScene(const std::string& path, const StressSceneOptions& options);
+
+// 生成场景中各车辆的对象编号（按名称查找，Bind 一次后每步直接使用）
+struct StressSceneIndex {
+    std::vector<int> car_body;
+    std::vector<int> forward;     // 执行器
+    std::vector<int> turn;
+    std::vector<int> goal_mocap;  // mocap 编号
+    std::vector<WheelBinding> wheels;
+
+    // 返回找到的车辆数（从第 0 辆起连续）
+    int Bind(const mjModel* m);
+    int NumCars() const { return static_cast<int>(car_body.size()); }
+};
+
+// 所有车辆朝各自目标点做比例追踪（与 GoalPursuitController 相同的控制律）
+void StressPursuitControl(mjData* d, const StressSceneIndex& index);
+
+}  // namespace mjpc
+
+#endif  // MJPC_STRESS_SCENE_H_
@@ -0,0 +1,35 @@
+#include <cstdio>
+#include <string>
+
+#include <absl/flags/flag.h>
+#include <absl/flags/parse.h>
+
+#include "mjpc/stress_scene.h"
+
+ABSL_FLAG(int, cars, 10, "Number of vehicles.");
+ABSL_FLAG(int, columns, 0, "Vehicles per grid row, 0 for ceil(sqrt(cars)).");
+ABSL_FLAG(double, spacing, 0.6, "Grid spacing (m).");
+ABSL_FLAG(double, goal_x, 1.0, "Goal offset from each vehicle's start, x (m).");
+ABSL_FLAG(double, goal_y, 1.0, "Goal offset from each vehicle's start, y (m).");
+ABSL_FLAG(bool, lights, false, "Give every vehicle its headlights, not just the first.");
+ABSL_FLAG(std::string, output, "stress.xml", "Output MJCF path.");
+
+int main(int argc, char** argv) {
+    absl::ParseCommandLine(argc, argv);
+
+    mjpc::StressSceneOptions options;
+    options.num_cars = absl::GetFlag(FLAGS_cars);
+    options.columns = absl::GetFlag(FLAGS_columns);
+    options.spacing = absl::GetFlag(FLAGS_spacing);
+    options.goal_offset_x = absl::GetFlag(FLAGS_goal_x);
+    options.goal_offset_y = absl::GetFlag(FLAGS_goal_y);
+    options.lights = absl::GetFlag(FLAGS_lights);
+
+    std::string output = absl::GetFlag(FLAGS_output);
+    if (!mjpc::WriteStressScene(output, options)) {
+        fprintf(stderr, "Failed to write %s\n", output.c_str());
+        return 1;
+    }
+    printf("Wrote %d vehicles to %s\n", options.num_cars, output.c_str());
+    return 0;
+}
@@ -0,0 +1,161 @@
+#include "mjpc/telemetry_broadcast.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace mjpc {
+
+int TelemetryBroadcaster::NumChannels(uint32_t channels) {
+    int count = 0;
+    for (int c = 0; c < CHANNEL_COUNT; c++) count += (channels >> c) & 1u;
+    return count;
+}
+
+// ============ 订阅管理 ============
+int TelemetryBroadcaster::Subscribe(const BroadcastOptions& options) {
+    auto subscriber = std::make_shared<Subscriber>();
+    subscriber->options = options;
+    const uint32_t all = (1u << CHANNEL_COUNT) - 1;
+    subscriber->options.channels = options.channels ? (options.channels & all) : all;
+    subscriber->options.queue_capacity = std::max(options.queue_capacity, 1);
+    subscriber->queue.resize(subscriber->options.queue_capacity);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscriber->id = next_id_++;
+    subscribers_.push_back(subscriber);
+    return subscriber->id;
+}
+
+void TelemetryBroadcaster::Unsubscribe(int subscriber) {
+    std::shared_ptr<Subscriber> removed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = std::find_if(subscribers_.begin(), subscribers_.end(),
+                               [subscriber](const std::shared_ptr<Subscriber>& s) {
+                                   return s->id == subscriber;
+                               });
+        if (it == subscribers_.end()) return;
+        removed = *it;
+        subscribers_.erase(it);
+    }
+    {
+        std::lock_guard<std::mutex> lock(removed->mutex);
+        removed->closed = true;
+    }
+    removed->ready.notify_all();
+}
+
+void TelemetryBroadcaster::Shutdown() {
+    std::vector<std::shared_ptr<Subscriber>> removed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        removed.swap(subscribers_);
+    }
+    for (const std::shared_ptr<Subscriber>& subscriber : removed) {
+        {
+            std::lock_guard<std::mutex> lock(subscriber->mutex);
+            subscriber->closed = true;
+        }
+        subscriber->ready.notify_all();
+    }
+}
+
+int TelemetryBroadcaster::NumSubscribers() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(subscribers_.size());
+}
+
+std::shared_ptr<TelemetryBroadcaster::Subscriber> TelemetryBroadcaster::Find(int subscriber) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const std::shared_ptr<Subscriber>& s : subscribers_) {
+        if (s->id == subscriber) return s;
+    }
+    return nullptr;
+}
+
+// ============ 发布 ============
+void TelemetryBroadcaster::Publish(double time, const DashboardData& data) {
+    double values[CHANNEL_COUNT];
+    ExtractTelemetryChannels(data, values);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (subscribers_.empty()) return;
+    uint64_t sequence = ++sequence_;
+
+    for (const std::shared_ptr<Subscriber>& subscriber : subscribers_) {
+        bool notify = false;
+        {
+            std::lock_guard<std::mutex> subscriber_lock(subscriber->mutex);
+            const BroadcastOptions& options = subscriber->options;
+
+            // 下采样：按仿真时间，错过多个周期时只取一帧并保持相位
+            if (!subscriber->started || time < subscriber->last_time) {
+                subscriber->started = true;
+                subscriber->next_time = time;
+            }
+            subscriber->last_time = time;
+            if (options.rate_hz > 0.0) {
+                if (time < subscriber->next_time) continue;
+                double period = 1.0 / options.rate_hz;
+                subscriber->next_time += period * (1.0 + std::floor((time - subscriber->next_time) / period));
+            }
+
+            // 选出队列中的写入位置
+            const int capacity = options.queue_capacity;
+            int slot;
+            if (subscriber->count < capacity) {
+                slot = (subscriber->head + subscriber->count) % capacity;
+                subscriber->count++;
+            } else if (options.overflow == BROADCAST_COALESCE) {
+                slot = (subscriber->head + subscriber->count - 1) % capacity;
+                subscriber->stats.coalesced++;
+            } else {
+                slot = (subscriber->head + subscriber->count) % capacity;
+                subscriber->head = (subscriber->head + 1) % capacity;
+                subscriber->stats.dropped++;
+            }
+
+            BroadcastFrame& frame = subscriber->queue[slot];
+            frame.time = time;
+            frame.sequence = sequence;
+            frame.num_values = 0;
+            for (int c = 0; c < CHANNEL_COUNT; c++) {
+                if ((options.channels >> c) & 1u) frame.values[frame.num_values++] = values[c];
+            }
+            notify = true;
+        }
+        if (notify) subscriber->ready.notify_one();
+    }
+}
+
+// ============ 消费 ============
+int TelemetryBroadcaster::Next(int subscriber_id, std::vector<BroadcastFrame>* frames,
+                               int max_frames, double timeout) {
+    std::shared_ptr<Subscriber> subscriber = Find(subscriber_id);
+    if (!subscriber || !frames) return -1;
+
+    std::unique_lock<std::mutex> lock(subscriber->mutex);
+    subscriber->ready.wait_for(lock, std::chrono::duration<double>(std::max(timeout, 0.0)),
+                               [&]() { return subscriber->count > 0 || subscriber->closed; });
+    if (subscriber->closed) return -1;
+
+    int taken = std::min(subscriber->count, std::max(max_frames, 0));
+    const int capacity = subscriber->options.queue_capacity;
+    for (int i = 0; i < taken; i++) {
+        frames->push_back(subscriber->queue[subscriber->head]);
+        subscriber->head = (subscriber->head + 1) % capacity;
+    }
+    subscriber->count -= taken;
+    subscriber->stats.delivered += taken;
+    return taken;
+}
+
+BroadcastStats TelemetryBroadcaster::Stats(int subscriber_id) const {
+    std::shared_ptr<Subscriber> subscriber = Find(subscriber_id);
+    if (!subscriber) return BroadcastStats();
+    std::lock_guard<std::mutex> lock(subscriber->mutex);
+    return subscriber->stats;
+}
+
+}  // namespace mjpc
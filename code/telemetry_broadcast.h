@@ -0,0 +1,100 @@
+#ifndef MJPC_TELEMETRY_BROADCAST_H_
+#define MJPC_TELEMETRY_BROADCAST_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "mjpc/dashboard_data.h"
+#include "mjpc/telemetry_recorder.h"
+
+namespace mjpc {
+
+// ============ 遥测广播（与传输方式无关） ============
+// 仿真线程调用 Publish，按订阅者各自的通道选择和下采样频率把帧放入
+// 订阅者的定长队列；消费线程（RPC 处理、网络发送等）用 Next 批量取出。
+// 队列满时按订阅者的策略丢弃最旧的帧或合并到最新一帧，Publish 从不等待
+// 慢速订阅者，也不分配内存（队列在订阅时一次分配）。
+
+enum BroadcastOverflow {
+    BROADCAST_DROP_OLDEST,   // 丢弃最旧的帧，保留最近 capacity 帧
+    BROADCAST_COALESCE       // 新帧覆盖队尾，队列中保留较早的帧和最新状态
+};
+
+struct BroadcastOptions {
+    uint32_t channels = 0;         // 通道位掩码（1u << TelemetryChannel），0 为全部
+    double rate_hz = 0.0;          // 下采样频率（仿真时间），0 为每次 Publish
+    int queue_capacity = 256;      // 帧数
+    BroadcastOverflow overflow = BROADCAST_DROP_OLDEST;
+};
+
+// 一帧：只含订阅的通道，按通道编号升序
+struct BroadcastFrame {
+    double time = 0.0;
+    uint64_t sequence = 0;         // 广播序号（所有订阅者共用），可据此发现丢帧
+    int num_values = 0;
+    double values[CHANNEL_COUNT] = {};
+};
+
+struct BroadcastStats {
+    uint64_t delivered = 0;        // 已由 Next 取出
+    uint64_t dropped = 0;          // 队列满时丢弃
+    uint64_t coalesced = 0;        // 队列满时合并
+};
+
+class TelemetryBroadcaster {
+public:
+    TelemetryBroadcaster() = default;
+    ~TelemetryBroadcaster() { Shutdown(); }
+    TelemetryBroadcaster(const TelemetryBroadcaster&) = delete;
+    TelemetryBroadcaster& operator=(const TelemetryBroadcaster&) = delete;
+
+    // 返回订阅编号（> 0）
+    int Subscribe(const BroadcastOptions& options);
+    // 取消订阅，唤醒正在 Next 中等待的消费者
+    void Unsubscribe(int subscriber);
+    // 取消所有订阅
+    void Shutdown();
+    int NumSubscribers() const;
+
+    // 仿真线程调用；time 为仿真时间 (s)，回退时各订阅者的下采样重新开始
+    void Publish(double time, const DashboardData& data);
+
+    // 最多等待 timeout 秒，把最多 max_frames 帧追加到 frames。
+    // 返回取出的帧数（超时为 0），订阅不存在或已取消时返回 -1。
+    int Next(int subscriber, std::vector<BroadcastFrame>* frames, int max_frames,
+             double timeout);
+    BroadcastStats Stats(int subscriber) const;
+
+    // 掩码中的通道数
+    static int NumChannels(uint32_t channels);
+
+private:
+    struct Subscriber {
+        int id = 0;
+        BroadcastOptions options;
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::vector<BroadcastFrame> queue;   // 环形缓冲
+        int head = 0;
+        int count = 0;
+        double next_time = 0.0;              // 下一次采样的仿真时间
+        double last_time = 0.0;
+        bool started = false;
+        bool closed = false;
+        BroadcastStats stats;
+    };
+
+    std::shared_ptr<Subscriber> Find(int subscriber) const;
+
+    mutable std::mutex mutex_;
+    std::vector<std::shared_ptr<Subscriber>> subscribers_;
+    int next_id_ = 1;
+    uint64_t sequence_ = 0;
+};
+
+}  // namespace mjpc
+
+#endif  // MJPC_TELEMETRY_BROADCAST_H_
@@ -0,0 +1,501 @@
+#include "mjpc/telemetry_codec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace mjpc {
+
+namespace {
+
+constexpr char kFileMagic[4] = {'M', 'J', 'T', 'L'};
+constexpr char kBlockMagic[4] = {'M', 'J', 'T', 'B'};
+constexpr uint16_t kVersion = 1;
+
+// ============ 小端序读写 ============
+void PutBytes(std::vector<uint8_t>* out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        out->push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void PutDouble(std::vector<uint8_t>* out, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    PutBytes(out, bits, 8);
+}
+
+uint64_t GetBytes(const uint8_t* in, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+double GetDouble(const uint8_t* in) {
+    uint64_t bits = GetBytes(in, 8);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// bits 位二进制补码 -> 有符号整数
+int64_t SignExtend(uint64_t value, int bits) {
+    if (bits >= 64) return static_cast<int64_t>(value);
+    uint64_t sign = 1ull << (bits - 1);
+    return static_cast<int64_t>((value ^ sign) - sign);
+}
+
+int LeadingZeros(uint64_t x) { return x ? __builtin_clzll(x) : 64; }
+int TrailingZeros(uint64_t x) { return x ? __builtin_ctzll(x) : 64; }
+
+uint64_t DoubleBits(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// 列编码的长度范围：首个样本 64 位，之后每个样本 1 位到 max_bits 位
+// （时间戳最长为 4 位前缀 + 64 位，数值最长为 2 位控制 + 5 + 6 + 64 位）
+constexpr size_t kMaxTimestampBits = 68;
+constexpr size_t kMaxFloatBits = 77;
+
+size_t ColumnBytes(int count, size_t bits_per_sample) {
+    return (64 + static_cast<size_t>(count - 1) * bits_per_sample + 7) / 8;
+}
+
+// 线性外推预测下一个值：2 * p1 - p2，并截断到列精度，
+// 保证残差的尾随零不被预测值破坏。编码端与解码端计算完全一致。
+uint64_t PredictBits(double p1, double p2, int count, int mantissa_bits) {
+    if (count < 2) return DoubleBits(p1);
+    double prediction = 2.0 * p1 - p2;
+    if (!std::isfinite(prediction)) return DoubleBits(p1);
+    return DoubleBits(TruncateMantissa(prediction, mantissa_bits));
+}
+
+}  // namespace
+
+// ============ BitWriter / BitReader ============
+void BitWriter::Write(uint64_t value, int bits) {
+    if (bits <= 0) return;
+    if (bits < 64) value &= (1ull << bits) - 1;
+
+    int free = 64 - fill_;
+    if (bits < free) {
+        accumulator_ |= value << (free - bits);
+        fill_ += bits;
+        return;
+    }
+
+    // 填满当前字，剩余位进入下一个字
+    int rest = bits - free;
+    accumulator_ |= (free == 64) ? value : (value >> rest);
+    words_.push_back(accumulator_);
+    accumulator_ = rest > 0 ? value << (64 - rest) : 0;
+    fill_ = rest;
+}
+
+void BitWriter::AppendTo(std::vector<uint8_t>* out) const {
+    for (uint64_t word : words_) {
+        for (int i = 7; i >= 0; i--) out->push_back(static_cast<uint8_t>(word >> (8 * i)));
+    }
+    int tail_bytes = (fill_ + 7) / 8;
+    for (int i = 0; i < tail_bytes; i++) {
+        out->push_back(static_cast<uint8_t>(accumulator_ >> (56 - 8 * i)));
+    }
+}
+
+uint64_t BitReader::Read(int bits) {
+    uint64_t result = 0;
+    while (bits > 0) {
+        size_t byte = position_ >> 3;
+        int offset = static_cast<int>(position_ & 7);
+        int available = 8 - offset;
+        int take = std::min(available, bits);
+        uint8_t value = byte < size_ ? data_[byte] : 0;
+        uint64_t chunk = (value >> (available - take)) & ((1u << take) - 1);
+        result = (result << take) | chunk;
+        position_ += take;
+        bits -= take;
+    }
+    return result;
+}
+
+// ============ 时间戳列 ============
+void TimestampColumnEncoder::Clear() {
+    bits_.Clear();
+    count_ = 0;
+    previous_ = 0;
+    previous_delta_ = 0;
+}
+
+void TimestampColumnEncoder::Append(int64_t timestamp) {
+    if (count_++ == 0) {
+        bits_.Write(static_cast<uint64_t>(timestamp), 64);
+        previous_ = timestamp;
+        previous_delta_ = 0;
+        return;
+    }
+
+    int64_t delta = timestamp - previous_;
+    int64_t dod = delta - previous_delta_;
+    previous_ = timestamp;
+    previous_delta_ = delta;
+
+    // 固定步长时 dod 恒为 0，每个样本只占 1 位
+    if (dod == 0) {
+        bits_.Write(0, 1);
+    } else if (dod >= -64 && dod < 64) {
+        bits_.Write(0b10, 2);
+        bits_.Write(static_cast<uint64_t>(dod), 7);
+    } else if (dod >= -256 && dod < 256) {
+        bits_.Write(0b110, 3);
+        bits_.Write(static_cast<uint64_t>(dod), 9);
+    } else if (dod >= -2048 && dod < 2048) {
+        bits_.Write(0b1110, 4);
+        bits_.Write(static_cast<uint64_t>(dod), 12);
+    } else {
+        bits_.Write(0b1111, 4);
+        bits_.Write(static_cast<uint64_t>(dod), 64);
+    }
+}
+
+bool DecodeTimestampColumn(const uint8_t* data, size_t size, int count, int64_t* out) {
+    BitReader reader(data, size);
+    int64_t previous = 0;
+    int64_t previous_delta = 0;
+    for (int i = 0; i < count; i++) {
+        if (i == 0) {
+            previous = static_cast<int64_t>(reader.Read(64));
+            out[0] = previous;
+            continue;
+        }
+
+        int64_t dod;
+        if (reader.Read(1) == 0) {
+            dod = 0;
+        } else if (reader.Read(1) == 0) {
+            dod = SignExtend(reader.Read(7), 7);
+        } else if (reader.Read(1) == 0) {
+            dod = SignExtend(reader.Read(9), 9);
+        } else if (reader.Read(1) == 0) {
+            dod = SignExtend(reader.Read(12), 12);
+        } else {
+            dod = static_cast<int64_t>(reader.Read(64));
+        }
+        previous_delta += dod;
+        previous += previous_delta;
+        out[i] = previous;
+    }
+    return !reader.Overrun();
+}
+
+// ============ 浮点列 ============
+void FloatColumnEncoder::Clear() {
+    bits_.Clear();
+    count_ = 0;
+    previous_ = 0.0;
+    previous2_ = 0.0;
+    previous_leading_ = -1;
+    previous_trailing_ = 0;
+}
+
+void FloatColumnEncoder::Append(double value) {
+    uint64_t bits = DoubleBits(value);
+    if (count_ == 0) {
+        bits_.Write(bits, 64);
+        previous_ = value;
+        count_ = 1;
+        return;
+    }
+
+    // 与预测值异或：平滑信号的高位（符号、指数、高位尾数）基本相同
+    uint64_t x = bits ^ PredictBits(previous_, previous2_, count_, mantissa_bits_);
+    previous2_ = previous_;
+    previous_ = value;
+    count_++;
+    if (x == 0) {
+        bits_.Write(0, 1);
+        return;
+    }
+    bits_.Write(1, 1);
+
+    int leading = std::min(LeadingZeros(x), 31);
+    int trailing = TrailingZeros(x);
+    if (previous_leading_ >= 0 && leading >= previous_leading_ &&
+        trailing >= previous_trailing_) {
+        // 沿用上一个有效位窗口
+        bits_.Write(0, 1);
+        bits_.Write(x >> previous_trailing_, 64 - previous_leading_ - previous_trailing_);
+    } else {
+        int length = 64 - leading - trailing;
+        bits_.Write(1, 1);
+        bits_.Write(static_cast<uint64_t>(leading), 5);
+        bits_.Write(static_cast<uint64_t>(length & 63), 6);   // 64 记为 0
+        bits_.Write(x >> trailing, length);
+        previous_leading_ = leading;
+        previous_trailing_ = trailing;
+    }
+}
+
+bool DecodeFloatColumn(const uint8_t* data, size_t size, int count, int mantissa_bits,
+                       double* out) {
+    BitReader reader(data, size);
+    double previous = 0.0;
+    double previous2 = 0.0;
+    int leading = 0;
+    int trailing = 0;
+    for (int i = 0; i < count; i++) {
+        uint64_t bits;
+        if (i == 0) {
+            bits = reader.Read(64);
+        } else {
+            bits = PredictBits(previous, previous2, i, mantissa_bits);
+            if (reader.Read(1) == 1) {
+                if (reader.Read(1) == 1) {
+                    leading = static_cast<int>(reader.Read(5));
+                    int length = static_cast<int>(reader.Read(6));
+                    if (length == 0) length = 64;
+                    trailing = 64 - leading - length;
+                    if (trailing < 0) return false;
+                }
+                int length = 64 - leading - trailing;
+                bits ^= reader.Read(length) << trailing;
+            }
+        }
+        previous2 = previous;
+        memcpy(&previous, &bits, sizeof(double));
+        out[i] = previous;
+    }
+    return !reader.Overrun();
+}
+
+double TruncateMantissa(double value, int bits) {
+    if (bits >= 52 || bits < 0 || !std::isfinite(value)) return value;
+    uint64_t u;
+    memcpy(&u, &value, sizeof(u));
+    int drop = 52 - bits;
+    u += 1ull << (drop - 1);           // 四舍五入（进位可能进入指数位，结果仍正确）
+    u &= ~((1ull << drop) - 1);
+    memcpy(&value, &u, sizeof(value));
+    return value;
+}
+
+// ============ TelemetryWriter ============
+bool TelemetryWriter::Open(const std::string& path, const std::vector<std::string>& channels,
+                           const std::vector<int>& mantissa_bits, int block_size) {
+    Close();
+    if (channels.empty() || channels.size() > 0xFFFF || block_size <= 0) return false;
+
+    file_ = fopen(path.c_str(), "wb");
+    if (!file_) return false;
+
+    channels_ = channels;
+    mantissa_bits_ = mantissa_bits;
+    mantissa_bits_.resize(channels.size(), 52);
+    // 先限制到 [0, 52]：文件头、编码器的预测截断和写入时的截断用同一个值
+    for (int& bits : mantissa_bits_) bits = std::clamp(bits, 0, 52);
+    block_size_ = block_size;
+    block_count_ = 0;
+    samples_written_ = 0;
+    bytes_written_ = 0;
+
+    int num_channels = NumChannels();
+    channel_min_.assign(num_channels, 0.0);
+    channel_max_.assign(num_channels, 0.0);
+    columns_.assign(num_channels, FloatColumnEncoder());
+    for (int i = 0; i < num_channels; i++) columns_[i].SetMantissaBits(mantissa_bits_[i]);
+    timestamps_.Clear();
+
+    // 文件头
+    scratch_.clear();
+    scratch_.insert(scratch_.end(), kFileMagic, kFileMagic + 4);
+    PutBytes(&scratch_, kVersion, 2);
+    PutBytes(&scratch_, static_cast<uint64_t>(num_channels), 2);
+    PutBytes(&scratch_, static_cast<uint64_t>(block_size_), 4);
+    for (int i = 0; i < num_channels; i++) {
+        size_t length = std::min<size_t>(channels_[i].size(), 255);
+        scratch_.push_back(static_cast<uint8_t>(length));
+        scratch_.insert(scratch_.end(), channels_[i].begin(), channels_[i].begin() + length);
+        scratch_.push_back(static_cast<uint8_t>(mantissa_bits_[i]));
+    }
+    if (fwrite(scratch_.data(), 1, scratch_.size(), file_) != scratch_.size()) {
+        Close();
+        return false;
+    }
+    bytes_written_ += scratch_.size();
+    return true;
+}
+
+bool TelemetryWriter::Append(int64_t timestamp_ns, const double* values) {
+    if (!file_) return false;
+
+    if (block_count_ == 0) {
+        t_min_ = t_max_ = timestamp_ns;
+    }
+    t_min_ = std::min(t_min_, timestamp_ns);
+    t_max_ = std::max(t_max_, timestamp_ns);
+    timestamps_.Append(timestamp_ns);
+
+    for (int i = 0; i < NumChannels(); i++) {
+        double value = TruncateMantissa(values[i], mantissa_bits_[i]);
+        if (block_count_ == 0) {
+            channel_min_[i] = channel_max_[i] = value;
+        } else {
+            channel_min_[i] = std::min(channel_min_[i], value);
+            channel_max_[i] = std::max(channel_max_[i], value);
+        }
+        columns_[i].Append(value);
+    }
+
+    block_count_++;
+    samples_written_++;
+    if (block_count_ >= block_size_) return WriteBlock();
+    return true;
+}
+
+size_t TelemetryWriter::PendingBytes() const {
+    size_t bits = timestamps_.Bits().BitCount();
+    for (const FloatColumnEncoder& column : columns_) bits += column.Bits().BitCount();
+    return bits / 8;
+}
+
+bool TelemetryWriter::WriteBlock() {
+    if (!file_ || block_count_ == 0) return true;
+    int num_channels = NumChannels();
+
+    scratch_.clear();
+    scratch_.insert(scratch_.end(), kBlockMagic, kBlockMagic + 4);
+    PutBytes(&scratch_, static_cast<uint64_t>(block_count_), 4);
+    PutBytes(&scratch_, static_cast<uint64_t>(t_min_), 8);
+    PutBytes(&scratch_, static_cast<uint64_t>(t_max_), 8);
+    for (int i = 0; i < num_channels; i++) {
+        PutDouble(&scratch_, channel_min_[i]);
+        PutDouble(&scratch_, channel_max_[i]);
+    }
+
+    // 列长度表，随后是各列数据
+    PutBytes(&scratch_, (timestamps_.Bits().BitCount() + 7) / 8, 4);
+    for (int i = 0; i < num_channels; i++) {
+        PutBytes(&scratch_, (columns_[i].Bits().BitCount() + 7) / 8, 4);
+    }
+    timestamps_.Bits().AppendTo(&scratch_);
+    for (int i = 0; i < num_channels; i++) {
+        columns_[i].Bits().AppendTo(&scratch_);
+    }
+
+    bool ok = fwrite(scratch_.data(), 1, scratch_.size(), file_) == scratch_.size();
+    bytes_written_ += scratch_.size();
+
+    block_count_ = 0;
+    timestamps_.Clear();
+    for (FloatColumnEncoder& column : columns_) column.Clear();
+    return ok;
+}
+
+bool TelemetryWriter::Close() {
+    if (!file_) return true;
+    bool ok = WriteBlock();
+    ok = (fclose(file_) == 0) && ok;
+    file_ = nullptr;
+    return ok;
+}
+
+// ============ TelemetryReader ============
+bool TelemetryReader::Open(const std::string& path) {
+    Close();
+    file_ = fopen(path.c_str(), "rb");
+    if (!file_) return false;
+
+    uint8_t header[12];
+    if (fread(header, 1, sizeof(header), file_) != sizeof(header) ||
+        memcmp(header, kFileMagic, 4) != 0 || GetBytes(header + 4, 2) != kVersion) {
+        Close();
+        return false;
+    }
+    int num_channels = static_cast<int>(GetBytes(header + 6, 2));
+    block_size_ = static_cast<int>(GetBytes(header + 8, 4));
+
+    channels_.clear();
+    mantissa_bits_.clear();
+    for (int i = 0; i < num_channels; i++) {
+        uint8_t length = 0;
+        char name[256];
+        uint8_t bits = 52;
+        if (fread(&length, 1, 1, file_) != 1 || fread(name, 1, length, file_) != length ||
+            fread(&bits, 1, 1, file_) != 1 || bits > 52) {
+            Close();
+            return false;
+        }
+        channels_.emplace_back(name, length);
+        mantissa_bits_.push_back(bits);
+    }
+    return true;
+}
+
+void TelemetryReader::Close() {
+    if (file_) fclose(file_);
+    file_ = nullptr;
+}
+
+bool TelemetryReader::ReadBlock(TelemetryBlock* block) {
+    if (!file_ || !block) return false;
+    int num_channels = static_cast<int>(channels_.size());
+
+    // 固定部分：魔数、样本数、时间范围、min/max、列长度表
+    size_t fixed = 24 + 16 * num_channels + 4 * (1 + num_channels);
+    scratch_.resize(fixed);
+    if (fread(scratch_.data(), 1, fixed, file_) != fixed ||
+        memcmp(scratch_.data(), kBlockMagic, 4) != 0) {
+        return false;
+    }
+    const uint8_t* p = scratch_.data();
+    int count = static_cast<int>(GetBytes(p + 4, 4));
+    if (count <= 0 || count > block_size_) return false;
+
+    block->count = count;
+    block->t_min = static_cast<int64_t>(GetBytes(p + 8, 8));
+    block->t_max = static_cast<int64_t>(GetBytes(p + 16, 8));
+    block->channel_min.resize(num_channels);
+    block->channel_max.resize(num_channels);
+    for (int i = 0; i < num_channels; i++) {
+        block->channel_min[i] = GetDouble(p + 24 + 16 * i);
+        block->channel_max[i] = GetDouble(p + 32 + 16 * i);
+    }
+
+    // 列长度必须在 count 个样本可能的最短和最长编码之间，
+    // 损坏的文件不会导致按任意长度分配和读取
+    std::vector<size_t> lengths(1 + num_channels);
+    size_t total = 0;
+    const uint8_t* table = p + 24 + 16 * num_channels;
+    for (int i = 0; i <= num_channels; i++) {
+        lengths[i] = GetBytes(table + 4 * i, 4);
+        size_t max_bits = i == 0 ? kMaxTimestampBits : kMaxFloatBits;
+        if (lengths[i] < ColumnBytes(count, 1) || lengths[i] > ColumnBytes(count, max_bits)) {
+            return false;
+        }
+        total += lengths[i];
+    }
+
+    scratch_.resize(total);
+    if (fread(scratch_.data(), 1, total, file_) != total) return false;
+
+    block->timestamps.resize(count);
+    block->values.resize(static_cast<size_t>(count) * num_channels);
+    const uint8_t* column = scratch_.data();
+    if (!DecodeTimestampColumn(column, lengths[0], count, block->timestamps.data())) {
+        return false;
+    }
+    column += lengths[0];
+    for (int i = 0; i < num_channels; i++) {
+        if (!DecodeFloatColumn(column, lengths[i + 1], count, mantissa_bits_[i],
+                               block->values.data() + static_cast<size_t>(i) * count)) {
+            return false;
+        }
+        column += lengths[i + 1];
+    }
+    return true;
+}
+
+}  // namespace mjpc
@@ -0,0 +1,174 @@
+#ifndef MJPC_TELEMETRY_CODEC_H_
+#define MJPC_TELEMETRY_CODEC_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace mjpc {
+
+// ============ 列式遥测压缩格式（Gorilla 风格） ============
+// 文件由文件头和若干数据块组成，每个数据块按列存储：
+//   时间戳列：纳秒整数，二阶差分（delta-of-delta）变长编码
+//   数值列：  double，与线性外推预测值异或后只存有效位（前导零/尾随零窗口）
+// 块头带每个通道的 min/max，读端不解码也能跳过无关的数据块。
+// 所有多字节整数按小端序存储，不依赖外部压缩库。
+//
+// 文件头:  "MJTL" u16 版本 u16 通道数 u32 块大小
+//          每通道: u8 名称长度, 名称, u8 尾数保留位数 (0-52)
+// 数据块:  "MJTB" u32 样本数 i64 t_min i64 t_max
+//          每通道: f64 min f64 max
+//          u32 列字节数 x (1 + 通道数)，随后依次为各列数据
+
+// 按位写入（高位在前）
+class BitWriter {
+public:
+    void Write(uint64_t value, int bits);
+    void Clear() { words_.clear(); accumulator_ = 0; fill_ = 0; }
+    size_t BitCount() const { return words_.size() * 64 + fill_; }
+    // 追加到字节缓冲区（最后一个字节低位补零）
+    void AppendTo(std::vector<uint8_t>* out) const;
+
+private:
+    std::vector<uint64_t> words_;
+    uint64_t accumulator_ = 0;
+    int fill_ = 0;
+};
+
+// 按位读取
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+    uint64_t Read(int bits);
+    bool Overrun() const { return position_ > size_ * 8; }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t position_ = 0;
+};
+
+// 时间戳列（delta-of-delta）
+class TimestampColumnEncoder {
+public:
+    void Append(int64_t timestamp);
+    void Clear();
+    const BitWriter& Bits() const { return bits_; }
+
+private:
+    BitWriter bits_;
+    int count_ = 0;
+    int64_t previous_ = 0;
+    int64_t previous_delta_ = 0;
+};
+
+bool DecodeTimestampColumn(const uint8_t* data, size_t size, int count, int64_t* out);
+
+// 浮点列（XOR）
+// 与 Gorilla 的"与前值异或"不同，这里与 2 * p1 - p2 的预测值异或：
+// 速度、位置、里程这类连续变化的量，预测残差的有效位比相邻差值少得多。
+class FloatColumnEncoder {
+public:
+    // 预测值按列精度截断，需与写入的截断位数一致
+    void SetMantissaBits(int bits) { mantissa_bits_ = bits; }
+    void Append(double value);
+    void Clear();
+    const BitWriter& Bits() const { return bits_; }
+
+private:
+    BitWriter bits_;
+    int mantissa_bits_ = 52;
+    int count_ = 0;
+    double previous_ = 0.0;
+    double previous2_ = 0.0;
+    int previous_leading_ = -1;
+    int previous_trailing_ = 0;
+};
+
+bool DecodeFloatColumn(const uint8_t* data, size_t size, int count, int mantissa_bits,
+                       double* out);
+
+// 尾数截断到 bits 位（四舍五入）；52 表示无损
+double TruncateMantissa(double value, int bits);
+
+// 解码后的数据块
+struct TelemetryBlock {
+    int count = 0;
+    int64_t t_min = 0, t_max = 0;
+    std::vector<double> channel_min, channel_max;
+    std::vector<int64_t> timestamps;    // count
+    std::vector<double> values;         // 按列：values[channel * count + i]
+};
+
+// ============ 流式写入 ============
+class TelemetryWriter {
+public:
+    TelemetryWriter() = default;
+    ~TelemetryWriter() { Close(); }
+    TelemetryWriter(const TelemetryWriter&) = delete;
+    TelemetryWriter& operator=(const TelemetryWriter&) = delete;
+
+    // mantissa_bits 为空时全部无损；每个值限制在 [0, 52]，52 为无损
+    bool Open(const std::string& path, const std::vector<std::string>& channels,
+              const std::vector<int>& mantissa_bits, int block_size = 4096);
+    // 追加一个样本（values 长度为通道数）；块满时自动写出
+    bool Append(int64_t timestamp_ns, const double* values);
+    // 写出未满的数据块并关闭文件
+    bool Close();
+
+    bool IsOpen() const { return file_ != nullptr; }
+    int NumChannels() const { return static_cast<int>(channels_.size()); }
+    uint64_t SamplesWritten() const { return samples_written_; }
+    uint64_t BytesWritten() const { return bytes_written_; }
+    // 编码器缓冲区当前占用（未写出的块）
+    size_t PendingBytes() const;
+
+private:
+    bool WriteBlock();
+
+    FILE* file_ = nullptr;
+    std::vector<std::string> channels_;
+    std::vector<int> mantissa_bits_;
+    int block_size_ = 4096;
+
+    int block_count_ = 0;
+    int64_t t_min_ = 0, t_max_ = 0;
+    std::vector<double> channel_min_, channel_max_;
+    TimestampColumnEncoder timestamps_;
+    std::vector<FloatColumnEncoder> columns_;
+    std::vector<uint8_t> scratch_;
+
+    uint64_t samples_written_ = 0;
+    uint64_t bytes_written_ = 0;
+};
+
+// ============ 流式读取 ============
+class TelemetryReader {
+public:
+    TelemetryReader() = default;
+    ~TelemetryReader() { Close(); }
+    TelemetryReader(const TelemetryReader&) = delete;
+    TelemetryReader& operator=(const TelemetryReader&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    const std::vector<std::string>& Channels() const { return channels_; }
+    const std::vector<int>& MantissaBits() const { return mantissa_bits_; }
+    int BlockSize() const { return block_size_; }
+
+    // 读取并解码下一个数据块，文件结束或数据损坏时返回 false
+    bool ReadBlock(TelemetryBlock* block);
+
+private:
+    FILE* file_ = nullptr;
+    std::vector<std::string> channels_;
+    std::vector<int> mantissa_bits_;
+    int block_size_ = 0;
+    std::vector<uint8_t> scratch_;
+};
+
+}  // namespace mjpc
+
+#endif  // MJPC_TELEMETRY_CODEC_H_
@@ -0,0 +1,63 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include <absl/flags/flag.h>
+#include <absl/flags/parse.h>
+
+#include "mjpc/console_view.h"
+#include "mjpc/telemetry_shm.h"
+
+ABSL_FLAG(std::string, name, mjpc::kDefaultTelemetryShmName, "Shared-memory segment name.");
+ABSL_FLAG(double, rate, 10.0, "Polling rate (Hz).");
+ABSL_FLAG(int, count, 0, "Number of lines to print, 0 runs until interrupted.");
+ABSL_FLAG(bool, tui, false, "Redraw a full-screen view in place instead of printing lines.");
+
+// 从共享内存读取仿真进程发布的遥测，每次有新快照时打印一行（--tui 时原地刷新界面）
+int main(int argc, char** argv) {
+    absl::ParseCommandLine(argc, argv);
+    std::string name = absl::GetFlag(FLAGS_name);
+    double rate = absl::GetFlag(FLAGS_rate);
+    int count = absl::GetFlag(FLAGS_count);
+    auto period = std::chrono::duration<double>(rate > 0.0 ? 1.0 / rate : 0.1);
+
+    bool tui = absl::GetFlag(FLAGS_tui);
+    mjpc::ConsoleView view;
+
+    mjpc::TelemetryShmReader reader;
+    bool waiting = false;
+    mjpc::TelemetrySnapshot snapshot;
+    for (int printed = 0; count <= 0 || printed < count;) {
+        std::this_thread::sleep_for(period);
+        // 发布者尚未启动或已重启时重新打开
+        if (!reader.IsOpen() && !reader.Open(name)) {
+            if (!waiting) fprintf(stderr, "Waiting for %s ...\n", name.c_str());
+            waiting = true;
+            continue;
+        }
+        waiting = false;
+        if (!reader.HasUpdate()) {
+            // 没有新快照时检查段是否已被删除或替换（发布者退出或重启），是则下次重新打开
+            if (reader.Stale()) reader.Close();
+            continue;
+        }
+        if (!reader.Read(&snapshot)) continue;
+        if (tui) {
+            const std::string& output = view.Draw(snapshot);
+            fwrite(output.data(), 1, output.size(), stdout);
+            fflush(stdout);
+            printed++;
+            continue;
+        }
+        printf("t=%9.3f frame=%-8llu speed=%6.1f km/h rpm=%5.0f gear=%2d fuel=%5.1f%% "
+               "temp=%5.1f C %s%s\n",
+               snapshot.time, static_cast<unsigned long long>(snapshot.frame), snapshot.speed_kmh,
+               snapshot.rpm, snapshot.gear, snapshot.fuel, snapshot.temperature, snapshot.mode,
+               snapshot.warning ? " WARNING" : "");
+        fflush(stdout);
+        printed++;
+    }
+    if (tui && view.FramesDrawn() > 0) fputs(mjpc::ConsoleView::RestoreSequence(), stdout);
+    return 0;
+}
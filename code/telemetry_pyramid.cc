@@ -0,0 +1,452 @@
+#include "mjpc/telemetry_pyramid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace mjpc {
+
+namespace {
+
+constexpr char kIndexMagic[4] = {'M', 'J', 'T', 'P'};
+constexpr uint16_t kIndexVersion = 2;   // 版本 1 没有淘汰桶数
+
+// ============ 小端序读写 ============
+bool WriteBytes(FILE* file, uint64_t value, int bytes) {
+    uint8_t buffer[8];
+    for (int i = 0; i < bytes; i++) buffer[i] = static_cast<uint8_t>(value >> (8 * i));
+    return fwrite(buffer, 1, bytes, file) == static_cast<size_t>(bytes);
+}
+
+bool ReadBytes(FILE* file, int bytes, uint64_t* value) {
+    uint8_t buffer[8];
+    if (fread(buffer, 1, bytes, file) != static_cast<size_t>(bytes)) return false;
+    *value = 0;
+    for (int i = 0; i < bytes; i++) *value |= static_cast<uint64_t>(buffer[i]) << (8 * i);
+    return true;
+}
+
+bool WriteDouble(FILE* file, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return WriteBytes(file, bits, 8);
+}
+
+bool ReadDouble(FILE* file, double* value) {
+    uint64_t bits;
+    if (!ReadBytes(file, 8, &bits)) return false;
+    memcpy(value, &bits, sizeof(bits));
+    return true;
+}
+
+bool WriteFloats(FILE* file, const std::vector<float>& values) {
+    for (float value : values) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        if (!WriteBytes(file, bits, 4)) return false;
+    }
+    return true;
+}
+
+bool ReadFloats(FILE* file, size_t count, std::vector<float>* values) {
+    values->resize(count);
+    for (size_t i = 0; i < count; i++) {
+        uint64_t bits;
+        if (!ReadBytes(file, 4, &bits)) return false;
+        uint32_t word = static_cast<uint32_t>(bits);
+        memcpy(&(*values)[i], &word, sizeof(word));
+    }
+    return true;
+}
+
+// 去掉前 drop 个元素并收缩容量（相当于 erase + shrink_to_fit + reserve(capacity)）
+template <typename T>
+void Compact(std::vector<T>* values, size_t drop, size_t capacity) {
+    std::vector<T> compacted;
+    compacted.reserve(std::max(capacity, values->size() - drop));
+    compacted.assign(values->begin() + drop, values->end());
+    values->swap(compacted);
+}
+
+}  // namespace
+
+std::string TelemetryIndexPath(const std::string& telemetry_path) {
+    return telemetry_path + ".idx";
+}
+
+// ============ 追加 ============
+void TelemetryPyramid::Reset(int num_channels) {
+    num_channels_ = std::max(num_channels, 0);
+    num_samples_ = 0;
+    t_first_ = 0.0;
+    levels_.clear();
+    levels_.reserve(kMaxLevels);   // 层级创建时不重新分配，Merge/Commit 中的引用保持有效
+    levels_.emplace_back();
+    levels_[0].min.resize(num_channels_);
+    levels_[0].max.resize(num_channels_);
+    levels_[0].mean.resize(num_channels_);
+    ResetAccumulator(&levels_[0].pending);
+}
+
+void TelemetryPyramid::ResetAccumulator(Accumulator* accumulator) const {
+    accumulator->t_first = accumulator->t_last = 0.0;
+    accumulator->count = 0;
+    accumulator->children = 0;
+    accumulator->min.assign(num_channels_, 0.0);
+    accumulator->max.assign(num_channels_, 0.0);
+    accumulator->sum.assign(num_channels_, 0.0);
+}
+
+bool TelemetryPyramid::TimeRange(double* t_first, double* t_last) const {
+    if (num_samples_ == 0 || levels_.empty()) return false;
+    const Level& base = levels_[0];
+    *t_first = t_first_;
+    *t_last = base.pending.count > 0 ? base.pending.t_last : base.t_last.back();
+    return true;
+}
+
+void TelemetryPyramid::Append(double time, const double* values) {
+    if (levels_.empty()) Reset(num_channels_);
+    if (num_samples_ == 0) t_first_ = time;
+    num_samples_++;
+    Merge(0, time, time, 1, values, values, values);
+}
+
+void TelemetryPyramid::Merge(int level, double t_first, double t_last, uint32_t count,
+                             const double* min, const double* max, const double* sum) {
+    Accumulator& pending = levels_[level].pending;
+    if (pending.count == 0) {
+        pending.t_first = t_first;
+        for (int c = 0; c < num_channels_; c++) {
+            pending.min[c] = min[c];
+            pending.max[c] = max[c];
+            pending.sum[c] = sum[c];
+        }
+    } else {
+        for (int c = 0; c < num_channels_; c++) {
+            pending.min[c] = std::min(pending.min[c], min[c]);
+            pending.max[c] = std::max(pending.max[c], max[c]);
+            pending.sum[c] += sum[c];
+        }
+    }
+    pending.t_last = t_last;
+    pending.count += count;
+    pending.children++;
+
+    uint32_t capacity = level == 0 ? kBaseSamples : kFanout;
+    if (pending.children >= capacity) Commit(level);
+}
+
+void TelemetryPyramid::Commit(int level) {
+    bool promote = level + 1 < kMaxLevels;
+    if (promote && NumLevels() <= level + 1) {
+        levels_.emplace_back();
+        Level& parent = levels_.back();
+        parent.min.resize(num_channels_);
+        parent.max.resize(num_channels_);
+        parent.mean.resize(num_channels_);
+        ResetAccumulator(&parent.pending);
+    }
+
+    Level& current = levels_[level];
+    Accumulator& pending = current.pending;
+    current.t_first.push_back(pending.t_first);
+    current.t_last.push_back(pending.t_last);
+    current.count.push_back(pending.count);
+    for (int c = 0; c < num_channels_; c++) {
+        current.min[c].push_back(static_cast<float>(pending.min[c]));
+        current.max[c].push_back(static_cast<float>(pending.max[c]));
+        current.mean[c].push_back(static_cast<float>(pending.sum[c] / pending.count));
+    }
+
+    if (promote) {
+        Merge(level + 1, pending.t_first, pending.t_last, pending.count,
+              pending.min.data(), pending.max.data(), pending.sum.data());
+    }
+    ResetAccumulator(&levels_[level].pending);
+}
+
+// ============ 查询 ============
+int TelemetryPyramid::Query(int channel, double t0, double t1, int pixels, Column* out) const {
+    if (pixels <= 0) return -1;
+    for (int i = 0; i < pixels; i++) out[i] = Column();
+    if (channel < 0 || channel >= num_channels_ || num_samples_ == 0 || !(t1 > t0)) return -1;
+
+    // 选择桶时长不超过一列时长的最粗层级
+    double column_duration = (t1 - t0) / pixels;
+    int level = 0;
+    for (int l = NumLevels() - 1; l > 0; l--) {
+        const Level& candidate = levels_[l];
+        if (candidate.Size() < 2) continue;
+        double duration = (candidate.t_last.back() - candidate.t_first.front()) / candidate.Size();
+        if (duration <= column_duration) {
+            level = l;
+            break;
+        }
+    }
+
+    // 桶先裁剪到查询窗口，再计入与它相交的每一列：min/max 原样计入，
+    // 均值按该列分到的样本数（按相交时长比例，至少 1）加权（增量平均，不分配内存）。
+    // 淘汰后补齐前缀的粗层级桶可能跨越很多列，不能只按中点归入一列。
+    auto accumulate = [&](double first, double last, uint32_t count,
+                          float min, float max, float mean) {
+        if (count == 0 || last < t0 || first > t1) return;
+        double clipped_first = std::max(first, t0);
+        double clipped_last = std::min(last, t1);
+        int begin = static_cast<int>(floor((clipped_first - t0) / column_duration));
+        int end = static_cast<int>(floor((clipped_last - t0) / column_duration));
+        begin = std::clamp(begin, 0, pixels - 1);
+        end = std::clamp(end, begin, pixels - 1);
+        double span = last - first;
+        for (int column = begin; column <= end; column++) {
+            uint32_t share = count;
+            if (begin != end && span > 0.0) {
+                double lo = std::max(clipped_first, t0 + column * column_duration);
+                double hi = std::min(clipped_last, t0 + (column + 1) * column_duration);
+                share = std::max<uint32_t>(
+                    1, static_cast<uint32_t>(count * std::max(hi - lo, 0.0) / span + 0.5));
+            }
+            Column& target = out[column];
+            if (target.count == 0) {
+                target.min = min;
+                target.max = max;
+                target.mean = mean;
+            } else {
+                target.min = std::min(target.min, min);
+                target.max = std::max(target.max, max);
+                target.mean += (mean - target.mean) * share / (target.count + share);
+            }
+            target.count += share;
+        }
+    };
+
+    // 逻辑下标 [begin, end) 内、与查询范围相交的已完成桶
+    auto accumulate_level = [&](int l, size_t begin, size_t end) {
+        const Level& current = levels_[l];
+        size_t first = std::lower_bound(current.t_last.begin(), current.t_last.end(), t0) -
+                       current.t_last.begin();
+        first = std::max(first + current.evicted, begin) - current.evicted;
+        end = std::min(end, current.End()) - current.evicted;
+        const std::vector<float>& min = current.min[channel];
+        const std::vector<float>& max = current.max[channel];
+        const std::vector<float>& mean = current.mean[channel];
+        for (size_t i = first; i < end && current.t_first[i] <= t1; i++) {
+            accumulate(current.t_first[i], current.t_last[i], current.count[i],
+                       min[i], max[i], mean[i]);
+        }
+    };
+
+    // 选定层级的已完成桶；该层已淘汰的前缀依次由更粗的层级补齐
+    size_t end = levels_[level].End();
+    for (int l = level; l < NumLevels(); l++) {
+        const Level& current = levels_[l];
+        accumulate_level(l, current.evicted, end);
+        if (current.evicted == 0 || l + 1 == NumLevels()) break;
+        end = current.evicted / kFanout;
+    }
+    // 更细层级补齐尚未合并到上层的尾部
+    for (int l = level - 1; l >= 0; l--) {
+        accumulate_level(l, levels_[l + 1].End() * static_cast<size_t>(kFanout),
+                         levels_[l].End());
+    }
+    const Accumulator& pending = levels_[0].pending;
+    if (pending.count > 0) {
+        accumulate(pending.t_first, pending.t_last, pending.count,
+                   static_cast<float>(pending.min[channel]),
+                   static_cast<float>(pending.max[channel]),
+                   static_cast<float>(pending.sum[channel] / pending.count));
+    }
+    return level;
+}
+
+size_t TelemetryPyramid::BucketBytes() const {
+    return 2 * sizeof(double) + sizeof(uint32_t) + 3 * sizeof(float) * num_channels_;
+}
+
+size_t TelemetryPyramid::LevelBytes(const Level& level) const {
+    size_t bytes = (level.t_first.capacity() + level.t_last.capacity()) * sizeof(double) +
+                   level.count.capacity() * sizeof(uint32_t);
+    for (int c = 0; c < num_channels_; c++) {
+        bytes += (level.min[c].capacity() + level.max[c].capacity() + level.mean[c].capacity()) *
+                 sizeof(float);
+    }
+    return bytes;
+}
+
+size_t TelemetryPyramid::MemoryBytes() const {
+    size_t bytes = 0;
+    for (const Level& level : levels_) {
+        bytes += LevelBytes(level);
+        bytes += 3 * sizeof(double) * num_channels_;
+    }
+    return bytes;
+}
+
+bool TelemetryPyramid::Trimmed() const {
+    for (const Level& level : levels_) {
+        if (level.evicted > 0) return true;
+    }
+    return false;
+}
+
+// ============ 淘汰 ============
+size_t TelemetryPyramid::Trim(size_t max_bytes) {
+    size_t bytes = MemoryBytes();
+    if (bytes <= max_bytes || NumLevels() < 2) return 0;
+    size_t target = max_bytes / 4 * 3;
+
+    // 各层（最顶层除外）最多保留 keep 个桶：每层覆盖的时间与桶时长成正比，
+    // 最近的数据保留最细的分辨率。二分求满足预算的最大 keep。
+    size_t fixed = bytes;
+    size_t largest = 0;
+    for (int l = 0; l + 1 < NumLevels(); l++) {
+        fixed -= LevelBytes(levels_[l]);
+        largest = std::max(largest, levels_[l].Size());
+    }
+    size_t budget = target > fixed ? (target - fixed) / BucketBytes() : 0;
+    size_t lo = 0, hi = largest;
+    while (lo < hi) {
+        size_t keep = (lo + hi + 1) / 2;
+        size_t retained = 0;
+        for (int l = 0; l + 1 < NumLevels(); l++) retained += std::min(levels_[l].Size(), keep);
+        if (retained <= budget) lo = keep; else hi = keep - 1;
+    }
+    size_t keep = lo;
+
+    // 只淘汰已合并到上层的桶，且按 kFanout 对齐，使上层桶恰好覆盖淘汰的范围；
+    // 每层淘汰的时间范围不超过更细的层级，查询时逐层向上补齐前缀
+    size_t total = 0;
+    for (int l = 0; l + 1 < NumLevels(); l++) {
+        Level& current = levels_[l];
+        if (current.Size() <= keep) continue;
+        size_t merged = levels_[l + 1].End() * kFanout - current.evicted;
+        if (l > 0) {
+            size_t finer = levels_[l - 1].evicted / kFanout - current.evicted;
+            merged = std::min(merged, finer / kFanout * kFanout);
+        }
+        size_t excess = current.Size() - keep;
+        size_t drop = std::min((excess + kFanout - 1) / kFanout * kFanout, merged);
+        if (drop == 0) continue;
+
+        // 淘汰后释放多余容量（否则 MemoryBytes 不会下降），再留出 1/3 的增长空间：
+        // 保留部分为预算的 3/4，容量恰好在再次超出预算时用完，不会每次追加都触发 Trim
+        size_t capacity = current.Size() - drop;
+        capacity += capacity / 3;
+        Compact(&current.t_first, drop, capacity);
+        Compact(&current.t_last, drop, capacity);
+        Compact(&current.count, drop, capacity);
+        for (int c = 0; c < num_channels_; c++) {
+            Compact(&current.min[c], drop, capacity);
+            Compact(&current.max[c], drop, capacity);
+            Compact(&current.mean[c], drop, capacity);
+        }
+        current.evicted += drop;
+        total += drop;
+    }
+    return total;
+}
+
+// ============ 索引文件 ============
+bool TelemetryPyramid::Save(const std::string& path) const {
+    // 在副本上自底向上提交未满的累加桶，使每一层都覆盖全部样本
+    TelemetryPyramid flushed = *this;
+    for (int l = 0; l < flushed.NumLevels(); l++) {
+        if (flushed.levels_[l].pending.count == 0) continue;
+        if (l + 1 < flushed.NumLevels()) {
+            flushed.Commit(l);
+        } else {
+            // 最顶层只写出，不再创建新层
+            Level& top = flushed.levels_[l];
+            const Accumulator& pending = top.pending;
+            top.t_first.push_back(pending.t_first);
+            top.t_last.push_back(pending.t_last);
+            top.count.push_back(pending.count);
+            for (int c = 0; c < num_channels_; c++) {
+                top.min[c].push_back(static_cast<float>(pending.min[c]));
+                top.max[c].push_back(static_cast<float>(pending.max[c]));
+                top.mean[c].push_back(static_cast<float>(pending.sum[c] / pending.count));
+            }
+        }
+    }
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+    bool ok = fwrite(kIndexMagic, 1, 4, file) == 4 &&
+              WriteBytes(file, kIndexVersion, 2) &&
+              WriteBytes(file, static_cast<uint64_t>(num_channels_), 2) &&
+              WriteBytes(file, kBaseSamples, 4) &&
+              WriteBytes(file, kFanout, 4) &&
+              WriteBytes(file, static_cast<uint64_t>(flushed.NumLevels()), 4);
+    for (const Level& level : flushed.levels_) {
+        if (!ok) break;
+        ok = WriteBytes(file, level.evicted, 8) && WriteBytes(file, level.Size(), 4);
+        for (size_t i = 0; ok && i < level.Size(); i++) {
+            ok = WriteDouble(file, level.t_first[i]) && WriteDouble(file, level.t_last[i]) &&
+                 WriteBytes(file, level.count[i], 4);
+        }
+        for (int c = 0; ok && c < num_channels_; c++) {
+            ok = WriteFloats(file, level.min[c]) && WriteFloats(file, level.max[c]) &&
+                 WriteFloats(file, level.mean[c]);
+        }
+    }
+    ok = (fclose(file) == 0) && ok;
+    return ok;
+}
+
+bool TelemetryPyramid::Load(const std::string& path) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    char magic[4];
+    uint64_t version = 0, channels = 0, base = 0, fanout = 0, num_levels = 0;
+    bool ok = fread(magic, 1, 4, file) == 4 && memcmp(magic, kIndexMagic, 4) == 0 &&
+              ReadBytes(file, 2, &version) && version >= 1 && version <= kIndexVersion &&
+              ReadBytes(file, 2, &channels) && ReadBytes(file, 4, &base) &&
+              ReadBytes(file, 4, &fanout) && ReadBytes(file, 4, &num_levels) &&
+              base == kBaseSamples && fanout == kFanout && num_levels <= kMaxLevels;
+    if (!ok) {
+        fclose(file);
+        return false;
+    }
+
+    Reset(static_cast<int>(channels));
+    levels_.resize(num_levels);
+    for (Level& level : levels_) {
+        level.min.resize(num_channels_);
+        level.max.resize(num_channels_);
+        level.mean.resize(num_channels_);
+        ResetAccumulator(&level.pending);
+
+        uint64_t evicted = 0, size = 0;
+        ok = ok && (version < 2 || ReadBytes(file, 8, &evicted)) && ReadBytes(file, 4, &size);
+        level.evicted = evicted;
+        if (!ok) break;
+        level.t_first.resize(size);
+        level.t_last.resize(size);
+        level.count.resize(size);
+        for (uint64_t i = 0; ok && i < size; i++) {
+            uint64_t count = 0;
+            ok = ReadDouble(file, &level.t_first[i]) && ReadDouble(file, &level.t_last[i]) &&
+                 ReadBytes(file, 4, &count);
+            level.count[i] = static_cast<uint32_t>(count);
+        }
+        for (int c = 0; ok && c < num_channels_; c++) {
+            ok = ReadFloats(file, size, &level.min[c]) && ReadFloats(file, size, &level.max[c]) &&
+                 ReadFloats(file, size, &level.mean[c]);
+        }
+    }
+    fclose(file);
+
+    if (!ok || levels_.empty()) {
+        Reset(num_channels_);
+        return false;
+    }
+    // 最顶层不淘汰，覆盖全部样本
+    const Level& top = levels_.back();
+    for (uint32_t count : top.count) num_samples_ += count;
+    t_first_ = top.Size() > 0 ? top.t_first.front() : 0.0;
+    return true;
+}
+
+}  // namespace mjpc
@@ -0,0 +1,105 @@
+#ifndef MJPC_TELEMETRY_PYRAMID_H_
+#define MJPC_TELEMETRY_PYRAMID_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mjpc {
+
+// ============ 多分辨率 min/max/mean 金字塔 ============
+// 第 0 层每个桶汇总 kBaseSamples 个原始样本，第 k 层每个桶汇总
+// kFanout 个第 k-1 层的桶。任意时间范围、任意缩放下，查询只读取
+// O(像素数 x kFanout) 个桶，与记录时长无关。
+//
+// 只在追加时更新：每层保留一个未满的累加桶，桶满后写入该层并
+// 合并到上一层的累加桶。
+//
+// 内存超出预算时（Trim）从最细层级开始淘汰最早的、已合并到上层的桶，
+// 查询这段时间时自动改用更粗的层级，相当于对旧数据降采样；最顶层不淘汰。
+//
+// 旁路索引文件（<遥测文件>.idx）:
+//   "MJTP" u16 版本 u16 通道数 u32 kBaseSamples u32 kFanout u32 层数
+//   每层: u64 已淘汰桶数（版本 2）u32 桶数，随后每个桶 f64 t_first f64 t_last
+//         u32 样本数，再按通道依次为 f32 min[桶数] f32 max[桶数] f32 mean[桶数]
+// 保存时各层未满的累加桶作为最后一个（样本数较少的）桶写出。
+class TelemetryPyramid {
+public:
+    static constexpr int kBaseSamples = 16;
+    static constexpr int kFanout = 8;
+    static constexpr int kMaxLevels = 12;
+
+    // 一个像素列的汇总，count 为 0 表示该列没有数据
+    struct Column {
+        float min = 0.0f;
+        float max = 0.0f;
+        float mean = 0.0f;
+        uint32_t count = 0;
+    };
+
+    void Reset(int num_channels);
+    int NumChannels() const { return num_channels_; }
+    int NumLevels() const { return static_cast<int>(levels_.size()); }
+    uint64_t NumSamples() const { return num_samples_; }
+    // 已记录的时间范围 (s)，没有样本时返回 false
+    bool TimeRange(double* t_first, double* t_last) const;
+
+    // 追加一个样本（时间单调不减；时间回退时调用方应先 Reset）
+    void Append(double time, const double* values);
+
+    // 把 [t0, t1] 按时间均分为 pixels 列，输出每列的 min/max/mean。
+    // 自动选择桶时长不超过每列时长的最粗层级；返回使用的层级
+    // （-1 表示没有数据）。跨越多列的桶（淘汰后由粗层级补齐的部分）
+    // 裁剪到窗口后计入相交的每一列。
+    int Query(int channel, double t0, double t1, int pixels, Column* out) const;
+
+    // 索引占用的字节数（按 vector 容量计）
+    size_t MemoryBytes() const;
+    // 超过 max_bytes 时淘汰细层级的旧桶，降到预算的 3/4（避免逐样本触发）并
+    // 释放多余容量；返回淘汰的桶数
+    size_t Trim(size_t max_bytes);
+    // 是否有层级淘汰过桶（此时细层级不覆盖全部样本，不应作为索引文件保存）
+    bool Trimmed() const;
+
+    bool Save(const std::string& path) const;
+    // 载入后只用于查询，不能继续 Append
+    bool Load(const std::string& path);
+
+private:
+    struct Accumulator {
+        double t_first = 0.0, t_last = 0.0;
+        uint32_t count = 0;      // 原始样本数
+        uint32_t children = 0;   // 已合并的下层桶数
+        std::vector<double> min, max, sum;
+    };
+
+    struct Level {
+        std::vector<double> t_first, t_last;
+        std::vector<uint32_t> count;
+        std::vector<std::vector<float>> min, max, mean;   // [通道][桶]
+        Accumulator pending;
+        size_t evicted = 0;      // 已淘汰的最早桶数，逻辑下标 = evicted + 数组下标
+        size_t Size() const { return t_first.size(); }
+        size_t End() const { return evicted + Size(); }
+    };
+
+    void ResetAccumulator(Accumulator* accumulator) const;
+    void Merge(int level, double t_first, double t_last, uint32_t count,
+               const double* min, const double* max, const double* sum);
+    void Commit(int level);
+
+    size_t BucketBytes() const;
+    size_t LevelBytes(const Level& level) const;
+
+    int num_channels_ = 0;
+    uint64_t num_samples_ = 0;
+    double t_first_ = 0.0;       // 第一个样本的时间（细层级可能已淘汰）
+    std::vector<Level> levels_;
+};
+
+// 遥测文件对应的索引文件路径
+std::string TelemetryIndexPath(const std::string& telemetry_path);
+
+}  // namespace mjpc
+
+#endif  // MJPC_TELEMETRY_PYRAMID_H_
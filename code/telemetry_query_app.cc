@@ -0,0 +1,63 @@
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <absl/flags/flag.h>
+#include <absl/flags/parse.h>
+
+#include "mjpc/telemetry_pyramid.h"
+#include "mjpc/telemetry_recorder.h"
+
+ABSL_FLAG(std::string, input, "", "Telemetry file (.mjtl); its .idx index is built if missing.");
+ABSL_FLAG(std::string, channel, "speed_ms", "Channel name.");
+ABSL_FLAG(double, t0, -1.0, "Range start (s); negative uses the start of the recording.");
+ABSL_FLAG(double, t1, -1.0, "Range end (s); negative uses the end of the recording.");
+ABSL_FLAG(int, pixels, 100, "Number of output columns.");
+
+// 按像素列输出任意时间范围的 min/max/mean（CSV），用于绘图和快速浏览长记录
+int main(int argc, char** argv) {
+    absl::ParseCommandLine(argc, argv);
+    std::string input = absl::GetFlag(FLAGS_input);
+    if (input.empty()) {
+        fprintf(stderr, "Usage: telemetry_query --input=<file.mjtl> [--channel=speed_ms]\n");
+        return 1;
+    }
+
+    mjpc::TelemetryPyramid pyramid;
+    if (!mjpc::LoadOrBuildTelemetryIndex(input, &pyramid)) {
+        fprintf(stderr, "Failed to read %s\n", input.c_str());
+        return 1;
+    }
+
+    std::string name = absl::GetFlag(FLAGS_channel);
+    int channel = -1;
+    for (int i = 0; i < mjpc::CHANNEL_COUNT; i++) {
+        if (name == mjpc::TelemetryChannelName(i)) channel = i;
+    }
+    if (channel < 0 || channel >= pyramid.NumChannels()) {
+        fprintf(stderr, "Unknown channel %s\n", name.c_str());
+        return 1;
+    }
+
+    double t_first = 0.0, t_last = 0.0;
+    pyramid.TimeRange(&t_first, &t_last);
+    double t0 = absl::GetFlag(FLAGS_t0) < 0.0 ? t_first : absl::GetFlag(FLAGS_t0);
+    double t1 = absl::GetFlag(FLAGS_t1) < 0.0 ? t_last : absl::GetFlag(FLAGS_t1);
+    int pixels = std::max(absl::GetFlag(FLAGS_pixels), 1);
+
+    std::vector<mjpc::TelemetryPyramid::Column> columns(pixels);
+    int level = pyramid.Query(channel, t0, t1, pixels, columns.data());
+    fprintf(stderr, "%llu samples, %d levels, query level %d\n",
+            static_cast<unsigned long long>(pyramid.NumSamples()), pyramid.NumLevels(), level);
+
+    printf("t_begin,t_end,min,max,mean,count\n");
+    double width = (t1 - t0) / pixels;
+    for (int i = 0; i < pixels; i++) {
+        const mjpc::TelemetryPyramid::Column& column = columns[i];
+        if (column.count == 0) continue;
+        printf("%.6f,%.6f,%.9g,%.9g,%.9g,%u\n", t0 + i * width, t0 + (i + 1) * width,
+               column.min, column.max, column.mean, column.count);
+    }
+    return 0;
+}
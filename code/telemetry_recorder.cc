@@ -0,0 +1,151 @@
+#include "mjpc/telemetry_recorder.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace mjpc {
+
+namespace {
+
+struct ChannelInfo {
+    const char* name;
+    int mantissa_bits;   // 默认精度
+};
+
+// 相对精度 2^-bits：12 位约 2.4e-4，16 位约 1.5e-5，20 位约 1e-6，52 位无损。
+// 位置/里程按绝对量记录，需要更多位数才能保留毫米级的变化。
+const ChannelInfo kChannels[CHANNEL_COUNT] = {
+    {"speed_ms", 16},
+    {"rpm", 12},
+    {"fuel", 16},
+    {"temperature", 12},
+    {"gear", 52},
+    {"throttle", 12},
+    {"brake", 12},
+    {"steering", 12},
+    {"acceleration", 12},
+    {"car_x", 20},
+    {"car_y", 20},
+    {"car_z", 16},
+    {"car_heading", 16},
+    {"battery_level", 16},
+    {"trip_distance", 20},
+    {"autopilot", 52},
+    {"warning", 52},
+};
+
+}  // namespace
+
+const char* TelemetryChannelName(int channel) {
+    if (channel < 0 || channel >= CHANNEL_COUNT) return "unknown";
+    return kChannels[channel].name;
+}
+
+void ExtractTelemetryChannels(const DashboardData& data, double values[CHANNEL_COUNT]) {
+    values[CHANNEL_SPEED] = data.speed_ms;
+    values[CHANNEL_RPM] = data.rpm;
+    values[CHANNEL_FUEL] = data.fuel;
+    values[CHANNEL_TEMPERATURE] = data.temperature;
+    values[CHANNEL_GEAR] = data.gear;
+    values[CHANNEL_THROTTLE] = data.throttle;
+    values[CHANNEL_BRAKE] = data.brake;
+    values[CHANNEL_STEERING] = data.steering;
+    values[CHANNEL_ACCELERATION] = data.acceleration;
+    values[CHANNEL_CAR_X] = data.car_x;
+    values[CHANNEL_CAR_Y] = data.car_y;
+    values[CHANNEL_CAR_Z] = data.car_z;
+    values[CHANNEL_HEADING] = data.car_heading;
+    values[CHANNEL_BATTERY] = data.battery_level;
+    values[CHANNEL_TRIP] = data.trip_distance;
+    values[CHANNEL_AUTOPILOT] = data.autopilot ? 1.0 : 0.0;
+    values[CHANNEL_WARNING] = data.warning ? 1.0 : 0.0;
+}
+
+// ============ TelemetryRecorder ============
+TelemetryRecorder::TelemetryRecorder() {
+    for (int i = 0; i < CHANNEL_COUNT; i++) {
+        mantissa_bits_[i] = kChannels[i].mantissa_bits;
+    }
+    pyramid_.Reset(CHANNEL_COUNT);
+}
+
+void TelemetryRecorder::SetMantissaBits(int channel, int bits) {
+    if (channel < 0 || channel >= CHANNEL_COUNT) return;
+    mantissa_bits_[channel] = bits;
+}
+
+void TelemetryRecorder::SetLossless() {
+    for (int i = 0; i < CHANNEL_COUNT; i++) mantissa_bits_[i] = 52;
+}
+
+bool TelemetryRecorder::Open(const std::string& path, int block_size) {
+    std::vector<std::string> names(CHANNEL_COUNT);
+    std::vector<int> bits(CHANNEL_COUNT);
+    for (int i = 0; i < CHANNEL_COUNT; i++) {
+        names[i] = kChannels[i].name;
+        bits[i] = mantissa_bits_[i];
+    }
+    pyramid_.Reset(CHANNEL_COUNT);
+    path_ = path;
+    return writer_.Open(path, names, bits, block_size);
+}
+
+bool TelemetryRecorder::Record(double time, const DashboardData& data) {
+    double values[CHANNEL_COUNT];
+    ExtractTelemetryChannels(data, values);
+
+    if (pyramid_.NumSamples() > 0 && time < last_time_) {
+        pyramid_.Reset(CHANNEL_COUNT);
+    }
+    pyramid_.Append(time, values);
+    last_time_ = time;
+
+    if (!writer_.IsOpen()) return true;
+    return writer_.Append(static_cast<int64_t>(llround(time * 1.0e9)), values);
+}
+
+void TelemetryRecorder::Trim(size_t max_bytes) {
+    size_t pending = writer_.PendingBytes();
+    pyramid_.Trim(max_bytes > pending ? max_bytes - pending : 0);
+}
+
+bool TelemetryRecorder::Close() {
+    if (!writer_.IsOpen()) return true;
+    bool ok = writer_.Close();
+    if (!pyramid_.Trimmed()) return pyramid_.Save(TelemetryIndexPath(path_)) && ok;
+    // 内存中的细层级已被淘汰：从文件重建（不替换仪表盘仍在查询的内存金字塔）
+    remove(TelemetryIndexPath(path_).c_str());
+    TelemetryPyramid rebuilt;
+    return LoadOrBuildTelemetryIndex(path_, &rebuilt) && ok;
+}
+
+// ============ 离线索引 ============
+bool LoadOrBuildTelemetryIndex(const std::string& telemetry_path, TelemetryPyramid* pyramid) {
+    std::string index_path = TelemetryIndexPath(telemetry_path);
+    if (pyramid->Load(index_path) && !pyramid->Trimmed()) return true;
+
+    TelemetryReader reader;
+    if (!reader.Open(telemetry_path)) return false;
+    int num_channels = static_cast<int>(reader.Channels().size());
+    pyramid->Reset(num_channels);
+
+    TelemetryBlock block;
+    std::vector<double> values(num_channels);
+    double last_time = 0.0;
+    while (reader.ReadBlock(&block)) {
+        for (int i = 0; i < block.count; i++) {
+            double time = block.timestamps[i] * 1.0e-9;
+            if (pyramid->NumSamples() > 0 && time < last_time) pyramid->Reset(num_channels);
+            last_time = time;
+            for (int c = 0; c < num_channels; c++) {
+                values[c] = block.values[static_cast<size_t>(c) * block.count + i];
+            }
+            pyramid->Append(time, values.data());
+        }
+    }
+    pyramid->Save(index_path);
+    return pyramid->NumSamples() > 0;
+}
+
+}  // namespace mjpc
@@ -0,0 +1,90 @@
+#ifndef MJPC_TELEMETRY_RECORDER_H_
+#define MJPC_TELEMETRY_RECORDER_H_
+
+#include <cstdint>
+#include <string>
+
+#include "mjpc/dashboard_data.h"
+#include "mjpc/telemetry_codec.h"
+#include "mjpc/telemetry_pyramid.h"
+
+namespace mjpc {
+
+// 记录的遥测通道（DashboardData 中的数值字段）
+enum TelemetryChannel {
+    CHANNEL_SPEED,           // m/s
+    CHANNEL_RPM,
+    CHANNEL_FUEL,
+    CHANNEL_TEMPERATURE,
+    CHANNEL_GEAR,
+    CHANNEL_THROTTLE,
+    CHANNEL_BRAKE,
+    CHANNEL_STEERING,
+    CHANNEL_ACCELERATION,
+    CHANNEL_CAR_X,
+    CHANNEL_CAR_Y,
+    CHANNEL_CAR_Z,
+    CHANNEL_HEADING,
+    CHANNEL_BATTERY,
+    CHANNEL_TRIP,
+    CHANNEL_AUTOPILOT,
+    CHANNEL_WARNING,
+    CHANNEL_COUNT
+};
+
+const char* TelemetryChannelName(int channel);
+
+// DashboardData -> 通道数组
+void ExtractTelemetryChannels(const DashboardData& data, double values[CHANNEL_COUNT]);
+
+// ============ 遥测记录器 ============
+// 把每个物理步（或每次 Update）的 DashboardData 流式写入列式压缩文件。
+// 默认按通道截断尾数（相对误差约 1e-4 到 1e-6，低于仪表显示精度），
+// 截断后的数值尾部全为零，XOR 编码只需存少量有效位。
+//
+// 同时在内存中维护 min/max/mean 金字塔（未打开文件时也维护），供仪表盘
+// 趋势图查询；Close 时写出旁路索引 <path>.idx 供离线工具使用。
+// 仿真时间回退（重置）时金字塔从头开始，索引只覆盖最后一段连续时间。
+class TelemetryRecorder {
+public:
+    TelemetryRecorder();
+
+    // 通道精度（尾数保留位数，52 为无损），需在 Open 之前设置
+    void SetMantissaBits(int channel, int bits);
+    void SetLossless();
+
+    bool Open(const std::string& path, int block_size = 4096);
+    // time 为仿真时间 (s)，以纳秒整数存储；未打开文件时只更新金字塔
+    bool Record(double time, const DashboardData& data);
+    // 写出剩余数据块和索引文件。金字塔被 Trim 过时不保存内存中的金字塔，
+    // 而是扫描刚写完的遥测文件重建完整索引
+    bool Close();
+
+    const TelemetryPyramid& Pyramid() const { return pyramid_; }
+
+    // 内存占用：未写出的编码块 + 金字塔索引
+    size_t MemoryBytes() const { return writer_.PendingBytes() + pyramid_.MemoryBytes(); }
+    // 超过 max_bytes 时淘汰金字塔细层级的旧桶（旧数据降采样，文件不受影响）
+    void Trim(size_t max_bytes);
+
+    bool IsOpen() const { return writer_.IsOpen(); }
+    uint64_t SamplesWritten() const { return writer_.SamplesWritten(); }
+    uint64_t BytesWritten() const { return writer_.BytesWritten(); }
+
+    // 等价的原始 DashboardData 记录字节数（用于计算压缩比）
+    uint64_t RawBytes() const { return writer_.SamplesWritten() * sizeof(DashboardData); }
+
+private:
+    TelemetryWriter writer_;
+    TelemetryPyramid pyramid_;
+    std::string path_;
+    double last_time_ = 0.0;
+    int mantissa_bits_[CHANNEL_COUNT];
+};
+
+// 读取遥测文件的索引；索引缺失、损坏或被淘汰过细层级时扫描遥测文件重建并写回
+bool LoadOrBuildTelemetryIndex(const std::string& telemetry_path, TelemetryPyramid* pyramid);
+
+}  // namespace mjpc
+
+#endif  // MJPC_TELEMETRY_RECORDER_H_
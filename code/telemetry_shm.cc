@@ -0,0 +1,147 @@
+#include "mjpc/telemetry_shm.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MJPC_HAVE_POSIX_SHM 1
+#endif
+
+namespace mjpc {
+
+// ============ 发布者 ============
+bool TelemetryShmPublisher::Open(const std::string& name) {
+    Close();
+#ifdef MJPC_HAVE_POSIX_SHM
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "TelemetryShmPublisher: shm_open(%s) failed: %s\n", name.c_str(), strerror(errno));
+        return false;
+    }
+    if (ftruncate(fd, sizeof(TelemetryShmSegment)) != 0) {
+        fprintf(stderr, "TelemetryShmPublisher: ftruncate(%s) failed: %s\n", name.c_str(), strerror(errno));
+        close(fd);
+        return false;
+    }
+    void* memory = mmap(nullptr, sizeof(TelemetryShmSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+        fprintf(stderr, "TelemetryShmPublisher: mmap(%s) failed: %s\n", name.c_str(), strerror(errno));
+        return false;
+    }
+
+    // 先让旧读者看到无效的 magic，初始化完成后再写入
+    TelemetryShmSegment* segment = static_cast<TelemetryShmSegment*>(memory);
+    segment->magic = 0;
+    std::atomic_thread_fence(std::memory_order_release);
+    new (&segment->snapshot) SeqLock<TelemetrySnapshot>();
+    segment->version = TelemetrySnapshot::kVersion;
+    segment->snapshot_size = sizeof(TelemetrySnapshot);
+    segment->reserved = 0;
+    std::atomic_thread_fence(std::memory_order_release);
+    segment->magic = TelemetryShmSegment::kMagic;
+
+    segment_ = segment;
+    name_ = name;
+    frames_ = 0;
+    return true;
+#else
+    (void)name;
+    return false;
+#endif
+}
+
+void TelemetryShmPublisher::Close() {
+#ifdef MJPC_HAVE_POSIX_SHM
+    if (!segment_) return;
+    munmap(segment_, sizeof(TelemetryShmSegment));
+    shm_unlink(name_.c_str());
+#endif
+    segment_ = nullptr;
+}
+
+void TelemetryShmPublisher::Publish(const TelemetrySnapshot& snapshot) {
+    if (!segment_) return;
+    TelemetrySnapshot frame = snapshot;
+    frame.frame = ++frames_;
+    segment_->snapshot.Write(frame);
+}
+
+// ============ 读者 ============
+bool TelemetryShmReader::Open(const std::string& name) {
+    Close();
+#ifdef MJPC_HAVE_POSIX_SHM
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(TelemetryShmSegment))) {
+        close(fd);
+        return false;
+    }
+    void* memory = mmap(nullptr, sizeof(TelemetryShmSegment), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) return false;
+
+    const TelemetryShmSegment* segment = static_cast<const TelemetryShmSegment*>(memory);
+    if (segment->magic != TelemetryShmSegment::kMagic ||
+        segment->version != TelemetrySnapshot::kVersion ||
+        segment->snapshot_size != sizeof(TelemetrySnapshot)) {
+        fprintf(stderr, "TelemetryShmReader: %s has an incompatible layout\n", name.c_str());
+        munmap(const_cast<TelemetryShmSegment*>(segment), sizeof(TelemetryShmSegment));
+        return false;
+    }
+    segment_ = segment;
+    last_sequence_ = 0;
+    name_ = name;
+    device_ = static_cast<uint64_t>(info.st_dev);
+    inode_ = static_cast<uint64_t>(info.st_ino);
+    return true;
+#else
+    (void)name;
+    return false;
+#endif
+}
+
+void TelemetryShmReader::Close() {
+#ifdef MJPC_HAVE_POSIX_SHM
+    if (segment_) munmap(const_cast<TelemetryShmSegment*>(segment_), sizeof(TelemetryShmSegment));
+#endif
+    segment_ = nullptr;
+}
+
+bool TelemetryShmReader::Read(TelemetrySnapshot* snapshot) const {
+    if (!segment_ || !snapshot) return false;
+    uint64_t sequence = 0;
+    if (!segment_->snapshot.Read(snapshot, &sequence)) return false;
+    if (sequence == 0) return false;   // 还没有发布过
+    last_sequence_ = sequence;
+    return true;
+}
+
+bool TelemetryShmReader::HasUpdate() const {
+    return segment_ && segment_->snapshot.Sequence() != last_sequence_;
+}
+
+bool TelemetryShmReader::Stale() const {
+    if (!segment_) return false;
+#ifdef MJPC_HAVE_POSIX_SHM
+    // 发布者 Close 时 shm_unlink，重启后创建的是新 inode；旧映射仍可读但不再更新
+    int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+    if (fd < 0) return true;
+    struct stat info;
+    bool stale = fstat(fd, &info) != 0 || static_cast<uint64_t>(info.st_dev) != device_ ||
+                 static_cast<uint64_t>(info.st_ino) != inode_;
+    close(fd);
+    return stale;
+#else
+    return false;
+#endif
+}
+
+}  // namespace mjpc
@@ -0,0 +1,84 @@
+#ifndef MJPC_TELEMETRY_SHM_H_
+#define MJPC_TELEMETRY_SHM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "mjpc/dashboard_data.h"
+#include "mjpc/seqlock.h"
+
+namespace mjpc {
+
+// ============ 共享内存遥测发布 ============
+// 仿真进程把 TelemetrySnapshot 写入 POSIX 共享内存段（/dev/shm 下），
+// 段内数据由 SeqLock 保护。发布只是几十次内存写入，没有系统调用和锁；
+// 任意数量的本机读者按各自频率轮询，读到半写的数据时自动重试。
+// 非 POSIX 平台上 Open 返回 false。
+
+constexpr const char* kDefaultTelemetryShmName = "/mjpc_telemetry";
+
+// 共享内存段布局
+struct TelemetryShmSegment {
+    static constexpr uint32_t kMagic = 0x4d4a5453;   // "MJTS"
+
+    uint32_t magic;
+    uint32_t version;          // TelemetrySnapshot::kVersion
+    uint32_t snapshot_size;    // sizeof(TelemetrySnapshot)
+    uint32_t reserved;
+    SeqLock<TelemetrySnapshot> snapshot;
+};
+
+class TelemetryShmPublisher {
+public:
+    TelemetryShmPublisher() = default;
+    ~TelemetryShmPublisher() { Close(); }
+    TelemetryShmPublisher(const TelemetryShmPublisher&) = delete;
+    TelemetryShmPublisher& operator=(const TelemetryShmPublisher&) = delete;
+
+    // 创建（或接管同名的旧段）并映射，成功返回 true
+    bool Open(const std::string& name = kDefaultTelemetryShmName);
+    // 解除映射并删除共享内存段
+    void Close();
+    bool IsOpen() const { return segment_ != nullptr; }
+
+    // 写入一个快照（frame 字段由发布者填写）
+    void Publish(const TelemetrySnapshot& snapshot);
+    uint64_t FramesPublished() const { return frames_; }
+
+private:
+    TelemetryShmSegment* segment_ = nullptr;
+    std::string name_;
+    uint64_t frames_ = 0;
+};
+
+class TelemetryShmReader {
+public:
+    TelemetryShmReader() = default;
+    ~TelemetryShmReader() { Close(); }
+    TelemetryShmReader(const TelemetryShmReader&) = delete;
+    TelemetryShmReader& operator=(const TelemetryShmReader&) = delete;
+
+    // 只读映射已有的段；段不存在或版本不匹配时返回 false
+    bool Open(const std::string& name = kDefaultTelemetryShmName);
+    void Close();
+    bool IsOpen() const { return segment_ != nullptr; }
+
+    // 读取最新快照；还没有发布过或持续读到半写的数据时返回 false
+    bool Read(TelemetrySnapshot* snapshot) const;
+    // 自上次 Read 成功以来是否有新快照（只读一次序号）
+    bool HasUpdate() const;
+    // 映射的段是否已被删除或被同名的新段替换（发布者重启）：重新 shm_open 并比较
+    // inode。需要一次系统调用，应在 HasUpdate 为 false 时才检查
+    bool Stale() const;
+
+private:
+    const TelemetryShmSegment* segment_ = nullptr;
+    mutable uint64_t last_sequence_ = 0;
+    std::string name_;
+    uint64_t device_ = 0, inode_ = 0;
+};
+
+}  // namespace mjpc
+
+#endif  // MJPC_TELEMETRY_SHM_H_
@@ -0,0 +1,115 @@
+#include "mjpc/alert_rules.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace mjpc {
+namespace {
+
+AlertSignals Signal(AlertSignal signal, double value) {
+    AlertSignals signals;
+    signals.value[signal] = value;
+    return signals;
+}
+
+TEST(AlertRulesTest, DefaultRulesFoundByName) {
+    AlertRuleSet rules;
+    ASSERT_EQ(rules.NumRules(), 4);
+    int overheat = rules.Find(AlertRuleSet::kOverheat);
+    ASSERT_GE(overheat, 0);
+    EXPECT_STREQ(rules.Name(overheat), "overheat");
+    EXPECT_EQ(rules.Bit("overheat"), AlertMask(1) << overheat);
+    EXPECT_EQ(rules.Find("missing"), -1);
+    EXPECT_EQ(rules.Bit("missing"), 0u);
+}
+
+TEST(AlertRulesTest, CompileErrorsKeepPreviousRules) {
+    AlertRuleSet rules;
+    ASSERT_TRUE(rules.Compile("hot: temperature > 50"));
+    const struct {
+        const char* text;
+        const char* error;
+    } kCases[] = {
+        {"hot temperature > 50", "alert rule 1: expected 'name: signal > value'"},
+        {"hot: warp > 1", "alert rule 1: unknown signal 'warp'"},
+        {"hot: temperature >= 50", "alert rule 1: expected '>' or '<', got '>='"},
+        {"hot: temperature > fifty", "alert rule 1: invalid threshold 'fifty'"},
+        {"hot: temperature > 50 for", "alert rule 1: 'for' needs a number"},
+        {"hot: temperature > 50 for -1", "alert rule 1: unexpected 'for -1'"},
+        {"hot: temperature > 50 clear 60", "alert rule 1: clear 60 is past threshold 50"},
+        {"a: rpm > 1; a: rpm > 2", "alert rule 2: duplicate name 'a'"},
+        {"# comment\nok: fuel < 10\n: fuel < 5", "alert rule 2: name must be 1-15 characters"},
+    };
+    for (const auto& test : kCases) {
+        std::string error;
+        EXPECT_FALSE(rules.Compile(test.text, &error)) << test.text;
+        EXPECT_EQ(error, test.error) << test.text;
+    }
+    ASSERT_EQ(rules.NumRules(), 1);
+    EXPECT_STREQ(rules.Name(0), "hot");
+}
+
+// 超过阈值触发，回落到阈值和解除值之间时保持，低于解除值才解除
+TEST(AlertRulesTest, Hysteresis) {
+    AlertRuleSet rules;
+    ASSERT_TRUE(rules.Compile("hot: temperature > 100 clear 95; cold: temperature < 10 clear 12"));
+    AlertState state;
+    EXPECT_EQ(rules.Evaluate(Signal(ALERT_TEMPERATURE, 99.0), 0.1, &state), 0u);
+    EXPECT_EQ(rules.Evaluate(Signal(ALERT_TEMPERATURE, 101.0), 0.1, &state), 1u);
+    EXPECT_EQ(state.raised, 1u);
+    EXPECT_EQ(rules.Evaluate(Signal(ALERT_TEMPERATURE, 97.0), 0.1, &state), 1u);
+    EXPECT_EQ(state.raised, 0u);
+    EXPECT_EQ(rules.Evaluate(Signal(ALERT_TEMPERATURE, 94.0), 0.1, &state), 0u);
+    EXPECT_EQ(state.cleared, 1u);
+
+    // '<' 规则方向相反
+    EXPECT_EQ(rules.Evaluate(Signal(ALERT_TEMPERATURE, 9.0), 0.1, &state), 2u);
+    EXPECT_EQ(rules.Evaluate(Signal(ALERT_TEMPERATURE, 11.0), 0.1, &state), 2u);
+    EXPECT_EQ(rules.Evaluate(Signal(ALERT_TEMPERATURE, 13.0), 0.1, &state), 0u);
+
+    // dt <= 0 时不改变状态
+    EXPECT_EQ(rules.Evaluate(Signal(ALERT_TEMPERATURE, 200.0), 0.0, &state), 0u);
+    EXPECT_EQ(state.raised, 0u);
+}
+
+// for：条件须持续 raise 延时才触发；hold：解除条件须持续 clear 延时才解除。
+// 中途条件中断时计时清零。步长 0.25 s 在 float 中精确。
+TEST(AlertRulesTest, RaiseAndClearDelays) {
+    AlertRuleSet rules;
+    ASSERT_TRUE(rules.Compile("fast: speed_kmh > 100 for 0.5 hold 1"));
+    AlertState state;
+    const double dt = 0.25;
+    EXPECT_EQ(rules.Evaluate(Signal(ALERT_SPEED_KMH, 120.0), dt, &state), 0u);
+    EXPECT_EQ(rules.Evaluate(Signal(ALERT_SPEED_KMH, 80.0), dt, &state), 0u);
+    EXPECT_EQ(rules.Evaluate(Signal(ALERT_SPEED_KMH, 120.0), dt, &state), 0u);
+    EXPECT_EQ(rules.Evaluate(Signal(ALERT_SPEED_KMH, 120.0), dt, &state), 1u);
+    EXPECT_EQ(state.raised, 1u);
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(rules.Evaluate(Signal(ALERT_SPEED_KMH, 80.0), dt, &state), 1u) << i;
+    }
+    EXPECT_EQ(rules.Evaluate(Signal(ALERT_SPEED_KMH, 120.0), dt, &state), 1u);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(rules.Evaluate(Signal(ALERT_SPEED_KMH, 80.0), dt, &state), 1u) << i;
+    }
+    EXPECT_EQ(rules.Evaluate(Signal(ALERT_SPEED_KMH, 80.0), dt, &state), 0u);
+    EXPECT_EQ(state.cleared, 1u);
+}
+
+// rate 规则比较每秒变化率；第一步没有上一帧，变化率为 0
+TEST(AlertRulesTest, RateRules) {
+    AlertRuleSet rules;
+    ASSERT_TRUE(rules.Compile("hard_brake: speed_ms rate < -5; overspeed: speed_ms > 30"));
+    AlertState state;
+    EXPECT_EQ(rules.Evaluate(Signal(ALERT_SPEED_MS, 20.0), 0.1, &state), 0u);
+    EXPECT_DOUBLE_EQ(state.rate[ALERT_SPEED_MS], 0.0);
+    EXPECT_EQ(rules.Evaluate(Signal(ALERT_SPEED_MS, 19.7), 0.1, &state), 0u);
+    EXPECT_NEAR(rules.Value(0, Signal(ALERT_SPEED_MS, 19.7), state), -3.0, 1e-9);
+    EXPECT_EQ(rules.Evaluate(Signal(ALERT_SPEED_MS, 18.9), 0.1, &state), 1u);
+    EXPECT_NEAR(state.rate[ALERT_SPEED_MS], -8.0, 1e-9);
+    EXPECT_EQ(rules.Evaluate(Signal(ALERT_SPEED_MS, 18.9), 0.1, &state), 0u);
+}
+
+}  // namespace
+}  // namespace mjpc
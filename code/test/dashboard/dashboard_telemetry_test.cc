@@ -0,0 +1,87 @@
+#include "mjpc/dashboard_telemetry.h"
+
+#include <mujoco/mujoco.h>
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "mjpc/dashboard_data.h"
+#include "mjpc/rate_scheduler.h"
+
+namespace mjpc {
+namespace {
+
+// 单个带自由关节的车身，没有车轮关节（传动系统保持怠速）
+constexpr char kCarXml[] = R"(
+<mujoco>
+  <worldbody>
+    <body name="car" pos="0 0 0.1">
+      <freejoint/>
+      <geom type="box" size="0.2 0.1 0.05" mass="1"/>
+    </body>
+  </worldbody>
+</mujoco>
+)";
+
+class DashboardTelemetryTest : public testing::Test {
+protected:
+    void SetUp() override {
+        std::string path = testing::TempDir() + "dashboard_telemetry_test.xml";
+        FILE* file = fopen(path.c_str(), "w");
+        ASSERT_NE(file, nullptr);
+        fputs(kCarXml, file);
+        fclose(file);
+        char error[1000] = "";
+        model_ = mj_loadXML(path.c_str(), nullptr, error, sizeof(error));
+        std::remove(path.c_str());
+        ASSERT_NE(model_, nullptr) << error;
+        data_ = mj_makeData(model_);
+    }
+
+    void TearDown() override {
+        if (data_) mj_deleteData(data_);
+        if (model_) mj_deleteModel(model_);
+    }
+
+    // 以 1 kHz 驱动积分器 seconds 秒，运动字段按 motion_hz 刷新（0 为每步），
+    // 其余字段每步刷新。车速直接写入 qvel，在运动刷新的间隔内也在变化。
+    DashboardData Drive(double motion_hz, double seconds) {
+        TelemetryIntegrator integrator;
+        RateScheduler scheduler;
+        int motion = scheduler.Add("motion", motion_hz);
+        DashboardData data;
+        int steps = static_cast<int>(seconds * 1000.0);
+        for (int i = 0; i <= steps; i++) {
+            data_->time = 0.001 * i;
+            data_->qvel[0] = 10.0 + 8.0 * sin(3.0 * data_->time);
+            uint32_t groups = TELEMETRY_ALL & ~TELEMETRY_MOTION;
+            if (RateScheduler::Due(scheduler.Advance(data_->time), motion)) {
+                groups |= TELEMETRY_MOTION;
+            }
+            integrator.Step(model_, data_, &data, groups);
+        }
+        return data;
+    }
+
+    mjModel* model_ = nullptr;
+    mjData* data_ = nullptr;
+};
+
+// 行程和电量按每步车速积分，与运动字段的刷新频率无关
+TEST_F(DashboardTelemetryTest, TripIndependentOfMotionRate) {
+    const double seconds = 10.0;
+    DashboardData every_step = Drive(RateScheduler::kEveryAdvance, seconds);
+    DashboardData slow = Drive(2.0, seconds);
+
+    EXPECT_DOUBLE_EQ(every_step.trip_distance, slow.trip_distance);
+    EXPECT_DOUBLE_EQ(every_step.battery_level, slow.battery_level);
+
+    // 车速 10 + 8 sin(3t) 的积分
+    double expected_km = (10.0 * seconds + 8.0 / 3.0 * (1.0 - cos(3.0 * seconds))) / 1000.0;
+    EXPECT_NEAR(every_step.trip_distance, expected_km, 1e-4);
+}
+
+}  // namespace
+}  // namespace mjpc
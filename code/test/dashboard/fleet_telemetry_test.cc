@@ -0,0 +1,122 @@
+#include "mjpc/fleet_telemetry.h"
+
+#include <mujoco/mujoco.h>
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace mjpc {
+namespace {
+
+// 车辆数不是任何 SIMD 宽度（2、4）的整数倍；另有一个不以 car 开头的自由 body
+constexpr int kVehicles = 7;
+
+std::string FleetXml() {
+    std::string xml = "<mujoco><worldbody>\n";
+    for (int i = 0; i < kVehicles; i++) {
+        char body[160];
+        snprintf(body, sizeof(body),
+                 "<body name=\"car%d\" pos=\"%d 0 0.1\"><freejoint/>"
+                 "<geom type=\"box\" size=\"0.2 0.1 0.05\" mass=\"1\"/></body>\n", i, 2 * i);
+        xml += body;
+    }
+    xml += "<body name=\"crate\" pos=\"0 5 0.1\"><freejoint/><geom size=\"0.1\" mass=\"1\"/></body>\n";
+    xml += "</worldbody></mujoco>\n";
+    return xml;
+}
+
+class FleetTelemetryTest : public testing::Test {
+protected:
+    void SetUp() override {
+        std::string path = testing::TempDir() + "fleet_telemetry_test.xml";
+        FILE* file = fopen(path.c_str(), "w");
+        ASSERT_NE(file, nullptr);
+        fputs(FleetXml().c_str(), file);
+        fclose(file);
+        char error[1000] = "";
+        model_ = mj_loadXML(path.c_str(), nullptr, error, sizeof(error));
+        std::remove(path.c_str());
+        ASSERT_NE(model_, nullptr) << error;
+        data_ = mj_makeData(model_);
+    }
+
+    void TearDown() override {
+        if (data_) mj_deleteData(data_);
+        if (model_) mj_deleteModel(model_);
+    }
+
+    // 第 i 辆车：位置、绕 z 轴的朝向和水平速度随 step 变化
+    void Pose(const FleetTelemetry& fleet, int step) {
+        // 四个象限、±π 边界、零四元数，以及令 atan2 两个参数都为 0 的四元数
+        // (0.5, -0.5, 0.5, 0.5)（车身侧翻，偏航角无定义）
+        static const double kYaw[kVehicles] = {0.3, 2.0, -2.5, -0.7, M_PI, 0.0, 0.0};
+        for (int i = 0; i < fleet.NumVehicles(); i++) {
+            int joint = model_->body_jntadr[fleet.BodyId(i)];
+            double* q = data_->qpos + model_->jnt_qposadr[joint];
+            double* v = data_->qvel + model_->jnt_dofadr[joint];
+            q[0] = 2.0 * i + 0.1 * step;
+            q[1] = -1.5 * i + 0.05 * step * step;
+            q[2] = 0.1;
+            double yaw = kYaw[i] + 0.01 * step;
+            q[3] = cos(0.5 * yaw);
+            q[4] = 0.0;
+            q[5] = 0.0;
+            q[6] = sin(0.5 * yaw);
+            if (i == 5) q[3] = q[4] = q[5] = q[6] = 0.0;
+            if (i == 6) {
+                q[3] = 0.5;
+                q[4] = -0.5;
+                q[5] = 0.5;
+                q[6] = 0.5;
+            }
+            v[0] = (i - 3) * 1.5 + 0.2 * step;
+            v[1] = 0.5 * i - 0.1 * step * step;
+        }
+    }
+
+    mjModel* model_ = nullptr;
+    mjData* data_ = nullptr;
+};
+
+void ExpectMatch(const FleetTelemetry& simd, const FleetTelemetry& reference, int step) {
+    for (int i = 0; i < reference.NumVehicles(); i++) {
+        EXPECT_EQ(simd.X()[i], reference.X()[i]) << "step " << step << " vehicle " << i;
+        EXPECT_EQ(simd.Y()[i], reference.Y()[i]) << "step " << step << " vehicle " << i;
+        EXPECT_NEAR(simd.Yaw()[i], reference.Yaw()[i], 1e-14) << "step " << step << " vehicle " << i;
+        EXPECT_NEAR(simd.Speed()[i], reference.Speed()[i], 1e-14) << "step " << step << " vehicle " << i;
+        EXPECT_NEAR(simd.Accel()[i], reference.Accel()[i], 1e-9) << "step " << step << " vehicle " << i;
+    }
+}
+
+TEST_F(FleetTelemetryTest, ExtractMatchesReference) {
+    FleetTelemetry simd, reference;
+    ASSERT_EQ(simd.Bind(model_, "car"), kVehicles);
+    ASSERT_EQ(reference.Bind(model_, "car"), kVehicles);
+    SCOPED_TRACE(FleetTelemetry::KernelName());
+
+    // 前进 5 步，再回退到 0 时刻（仿真重置）继续 2 步
+    const double times[] = {0.0, 0.01, 0.02, 0.03, 0.04, 0.0, 0.01};
+    for (int step = 0; step < 7; step++) {
+        data_->time = times[step];
+        Pose(simd, step);
+        simd.Extract(data_);
+        reference.ExtractReference(data_);
+        ExpectMatch(simd, reference, step);
+        if (step == 0 || step == 5) {
+            // 第一步和时间回退的一步没有差分，加速度为 0
+            for (int i = 0; i < kVehicles; i++) EXPECT_EQ(simd.Accel()[i], 0.0) << "step " << step;
+        }
+    }
+
+    // 朝向覆盖四个象限，退化的两辆车朝向为 0
+    EXPECT_NEAR(simd.Yaw()[1], 2.06, 1e-12);
+    EXPECT_NEAR(simd.Yaw()[2], -2.44, 1e-12);
+    EXPECT_EQ(simd.Yaw()[5], 0.0);
+    EXPECT_EQ(simd.Yaw()[6], 0.0);
+}
+
+}  // namespace
+}  // namespace mjpc
@@ -0,0 +1,83 @@
+#include "mjpc/quality_governor.h"
+
+#include "gtest/gtest.h"
+
+namespace mjpc {
+namespace {
+
+// 60 fps 目标周期 16.7 ms：工作时间 > 15 ms 降级，< 10 ms 计为可升级窗口
+QualityGovernorOptions TestOptions() {
+    QualityGovernorOptions options;
+    options.target_fps = 60.0;
+    options.window = 4;
+    options.degrade_ratio = 0.9;
+    options.restore_ratio = 0.6;
+    options.restore_windows = 2;
+    return options;
+}
+
+// 连续记录 frames 帧相同的工作时间，返回级别改变的次数
+int Feed(QualityGovernor* governor, double frame_ms, int frames) {
+    int changes = 0;
+    for (int i = 0; i < frames; i++) changes += governor->AddFrame(frame_ms);
+    return changes;
+}
+
+TEST(QualityGovernorTest, DegradesAfterOneSlowWindow) {
+    QualityGovernor governor(TestOptions());
+    EXPECT_EQ(Feed(&governor, 20.0, 3), 0);
+    EXPECT_TRUE(governor.AddFrame(20.0));
+    EXPECT_EQ(governor.Level(), 1);
+    EXPECT_DOUBLE_EQ(governor.AverageFrameMs(), 20.0);
+
+    // 每个慢窗口降一级，直到 max_level
+    EXPECT_EQ(Feed(&governor, 20.0, 4 * kQualityLevels), kQualityLevels - 2);
+    EXPECT_EQ(governor.Level(), kQualityLevels - 1);
+}
+
+TEST(QualityGovernorTest, DeadBandHoldsLevel) {
+    QualityGovernor governor(TestOptions());
+    governor.SetLevel(2);
+    EXPECT_EQ(Feed(&governor, 12.0, 40), 0);
+    EXPECT_EQ(governor.Level(), 2);
+}
+
+TEST(QualityGovernorTest, RestoresAfterConsecutiveFastWindows) {
+    QualityGovernor governor(TestOptions());
+    Feed(&governor, 20.0, 4);
+    ASSERT_EQ(governor.Level(), 1);
+
+    // 一个快窗口不够；中间插入一个死区窗口会重新计数
+    EXPECT_EQ(Feed(&governor, 5.0, 4), 0);
+    EXPECT_EQ(Feed(&governor, 12.0, 4), 0);
+    EXPECT_EQ(Feed(&governor, 5.0, 4), 0);
+    EXPECT_EQ(Feed(&governor, 5.0, 4), 1);
+    EXPECT_EQ(governor.Level(), 0);
+}
+
+TEST(QualityGovernorTest, BacksOffWhenRestoreFailsImmediately) {
+    QualityGovernor governor(TestOptions());
+    Feed(&governor, 20.0, 4);
+    Feed(&governor, 5.0, 8);
+    ASSERT_EQ(governor.Level(), 0);
+
+    // 升级后的第一个窗口就降回：下次升级需要的窗口数加倍（2 -> 4）
+    EXPECT_EQ(Feed(&governor, 20.0, 4), 1);
+    EXPECT_EQ(governor.Level(), 1);
+    EXPECT_EQ(Feed(&governor, 5.0, 3 * 4), 0);
+    EXPECT_EQ(governor.Level(), 1);
+    EXPECT_EQ(Feed(&governor, 5.0, 4), 1);
+    EXPECT_EQ(governor.Level(), 0);
+    EXPECT_EQ(governor.NumChanges(), 4);
+}
+
+TEST(QualityGovernorTest, IgnoresStalls) {
+    QualityGovernor governor(TestOptions());
+    EXPECT_EQ(Feed(&governor, 1000.0, 40), 0);
+    EXPECT_EQ(Feed(&governor, 0.0, 40), 0);
+    EXPECT_EQ(governor.Level(), 0);
+    EXPECT_DOUBLE_EQ(governor.AverageFrameMs(), 0.0);
+}
+
+}  // namespace
+}  // namespace mjpc
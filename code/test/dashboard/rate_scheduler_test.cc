@@ -0,0 +1,116 @@
+#include "mjpc/rate_scheduler.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace mjpc {
+namespace {
+
+// 以 1 ms 步长从 first 推进到 last（tick 序号，含两端），返回 task 到期的 tick
+std::vector<int> DueTicks(RateScheduler* scheduler, int task, int first, int last) {
+    std::vector<int> ticks;
+    for (int i = first; i <= last; i++) {
+        if (RateScheduler::Due(scheduler->Advance(0.001 * i), task)) ticks.push_back(i);
+    }
+    return ticks;
+}
+
+TEST(RateSchedulerTest, EveryAdvanceTaskFiresOnEveryCall) {
+    RateScheduler scheduler;
+    int every = scheduler.Add("every", RateScheduler::kEveryAdvance);
+    int slow = scheduler.Add("slow", 10.0);
+    EXPECT_EQ(scheduler.Find("slow"), slow);
+    EXPECT_EQ(scheduler.Find("missing"), -1);
+
+    uint32_t due = scheduler.Advance(0.0);
+    EXPECT_TRUE(RateScheduler::Due(due, every));
+    EXPECT_TRUE(RateScheduler::Due(due, slow));
+    // 时间不变或只推进不到一个 tick 时仍然到期
+    for (double time : {0.0, 0.0, 0.0004, 0.0004, 0.002}) {
+        due = scheduler.Advance(time);
+        EXPECT_TRUE(RateScheduler::Due(due, every)) << time;
+        EXPECT_FALSE(RateScheduler::Due(due, slow)) << time;
+    }
+}
+
+// 两次 Advance 之间错过多个周期时只触发一次，之后仍在原相位上
+TEST(RateSchedulerTest, MissedPeriodsKeepPhase) {
+    RateScheduler scheduler;
+    int task = scheduler.Add("task", 10.0);
+    EXPECT_TRUE(RateScheduler::Due(scheduler.Advance(0.0), task));
+    EXPECT_FALSE(RateScheduler::Due(scheduler.Advance(0.05), task));
+    EXPECT_TRUE(RateScheduler::Due(scheduler.Advance(0.1), task));
+    // 错过 0.2、0.3、0.4
+    EXPECT_TRUE(RateScheduler::Due(scheduler.Advance(0.45), task));
+    EXPECT_FALSE(RateScheduler::Due(scheduler.Advance(0.499), task));
+    EXPECT_TRUE(RateScheduler::Due(scheduler.Advance(0.5), task));
+    EXPECT_EQ(DueTicks(&scheduler, task, 501, 1000), (std::vector<int>{600, 700, 800, 900, 1000}));
+}
+
+// 周期超过 kSlots 个 tick 的任务每圈都经过自己的槽位，只在到期的那一圈触发
+TEST(RateSchedulerTest, WheelWrapsForLongPeriods) {
+    RateScheduler scheduler;
+    int medium = scheduler.Add("medium", 1000.0 / 150.0);   // 150 tick
+    int slow = scheduler.Add("slow", 1.0);                  // 1000 tick
+    int fast = scheduler.Add("fast", 1000.0 / 40.0);        // 40 tick
+    ASSERT_GT(150, RateScheduler::kSlots);
+
+    std::vector<int> medium_ticks, slow_ticks, fast_ticks;
+    for (int i = 0; i <= 3000; i++) {
+        uint32_t due = scheduler.Advance(0.001 * i);
+        if (RateScheduler::Due(due, medium)) medium_ticks.push_back(i);
+        if (RateScheduler::Due(due, slow)) slow_ticks.push_back(i);
+        if (RateScheduler::Due(due, fast)) fast_ticks.push_back(i);
+    }
+    ASSERT_EQ(medium_ticks.size(), 21u);
+    for (int k = 0; k < 21; k++) EXPECT_EQ(medium_ticks[k], 150 * k);
+    EXPECT_EQ(slow_ticks, (std::vector<int>{0, 1000, 2000, 3000}));
+    ASSERT_EQ(fast_ticks.size(), 76u);
+    for (int k = 0; k < 76; k++) EXPECT_EQ(fast_ticks[k], 40 * k);
+
+    // 一次跨越多圈
+    EXPECT_TRUE(RateScheduler::Due(scheduler.Advance(10.0), slow));
+    EXPECT_EQ(DueTicks(&scheduler, slow, 10001, 12000), (std::vector<int>{11000, 12000}));
+}
+
+// 改频率后下一次 Advance 立即到期，之后从该时刻起按新周期计，旧的到期时刻作废
+TEST(RateSchedulerTest, SetRateWhileScheduled) {
+    RateScheduler scheduler;
+    int task = scheduler.Add("task", 10.0);
+    EXPECT_TRUE(RateScheduler::Due(scheduler.Advance(0.0), task));
+    EXPECT_FALSE(RateScheduler::Due(scheduler.Advance(0.03), task));
+
+    scheduler.SetRate(task, 50.0);
+    EXPECT_EQ(scheduler.Rate(task), 50.0);
+    EXPECT_EQ(DueTicks(&scheduler, task, 31, 120), (std::vector<int>{31, 51, 71, 91, 111}));
+
+    // 改为每次 Advance，再改回有限频率
+    scheduler.SetRate(task, RateScheduler::kEveryAdvance);
+    EXPECT_EQ(DueTicks(&scheduler, task, 121, 125).size(), 5u);
+    scheduler.SetRate(task, 100.0);
+    EXPECT_EQ(DueTicks(&scheduler, task, 126, 150), (std::vector<int>{126, 136, 146}));
+}
+
+// 时间回退视为仿真重置：所有任务立即到期，之后从回退后的时刻起按周期计
+TEST(RateSchedulerTest, ResetOnTimeRewind) {
+    RateScheduler scheduler;
+    int task = scheduler.Add("task", 10.0);
+    int other = scheduler.Add("other", 4.0);
+    DueTicks(&scheduler, task, 0, 420);
+
+    uint32_t due = scheduler.Advance(0.05);
+    EXPECT_TRUE(RateScheduler::Due(due, task));
+    EXPECT_TRUE(RateScheduler::Due(due, other));
+    EXPECT_EQ(DueTicks(&scheduler, task, 51, 400), (std::vector<int>{150, 250, 350}));
+
+    // 显式 Reset 同样使所有任务在下一次 Advance 到期
+    scheduler.Reset();
+    due = scheduler.Advance(0.401);
+    EXPECT_TRUE(RateScheduler::Due(due, task));
+    EXPECT_TRUE(RateScheduler::Due(due, other));
+    EXPECT_EQ(DueTicks(&scheduler, task, 402, 600), (std::vector<int>{501}));
+}
+
+}  // namespace
+}  // namespace mjpc
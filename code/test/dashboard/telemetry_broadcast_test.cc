@@ -0,0 +1,131 @@
+#include "mjpc/telemetry_broadcast.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "mjpc/dashboard_data.h"
+#include "mjpc/telemetry_recorder.h"
+
+namespace mjpc {
+namespace {
+
+// 以 dt 为步长发布 count 帧，速度等于帧序号（从 first 开始）
+void PublishFrames(TelemetryBroadcaster* broadcaster, int first, int count, double dt) {
+    DashboardData data;
+    for (int i = first; i < first + count; i++) {
+        data.speed_ms = i;
+        data.rpm = 1000.0 + i;
+        broadcaster->Publish(i * dt, data);
+    }
+}
+
+std::vector<BroadcastFrame> Drain(TelemetryBroadcaster* broadcaster, int id) {
+    std::vector<BroadcastFrame> frames;
+    while (broadcaster->Next(id, &frames, 1000, 0.0) > 0) {}
+    return frames;
+}
+
+TEST(TelemetryBroadcastTest, DropOldestKeepsNewestFrames) {
+    TelemetryBroadcaster broadcaster;
+    BroadcastOptions options;
+    options.channels = 1u << CHANNEL_SPEED;
+    options.queue_capacity = 4;
+    options.overflow = BROADCAST_DROP_OLDEST;
+    int id = broadcaster.Subscribe(options);
+
+    PublishFrames(&broadcaster, 0, 10, 0.01);
+    std::vector<BroadcastFrame> frames = Drain(&broadcaster, id);
+    ASSERT_EQ(frames.size(), 4u);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(frames[i].num_values, 1);
+        EXPECT_EQ(frames[i].values[0], 6 + i);
+        EXPECT_EQ(frames[i].sequence, static_cast<uint64_t>(7 + i));
+    }
+    BroadcastStats stats = broadcaster.Stats(id);
+    EXPECT_EQ(stats.dropped, 6u);
+    EXPECT_EQ(stats.coalesced, 0u);
+    EXPECT_EQ(stats.delivered, 4u);
+}
+
+TEST(TelemetryBroadcastTest, CoalesceOverwritesNewestFrame) {
+    TelemetryBroadcaster broadcaster;
+    BroadcastOptions options;
+    options.channels = (1u << CHANNEL_SPEED) | (1u << CHANNEL_RPM);
+    options.queue_capacity = 4;
+    options.overflow = BROADCAST_COALESCE;
+    int id = broadcaster.Subscribe(options);
+
+    PublishFrames(&broadcaster, 0, 10, 0.01);
+    std::vector<BroadcastFrame> frames = Drain(&broadcaster, id);
+    ASSERT_EQ(frames.size(), 4u);
+    // 前 3 帧保持不变，最后一帧为最新状态；通道按编号升序
+    EXPECT_EQ(frames[0].values[0], 0.0);
+    EXPECT_EQ(frames[2].values[0], 2.0);
+    EXPECT_EQ(frames[3].values[0], 9.0);
+    EXPECT_EQ(frames[3].num_values, 2);
+    EXPECT_EQ(frames[3].values[1], 1009.0);
+    EXPECT_EQ(broadcaster.Stats(id).coalesced, 6u);
+    EXPECT_EQ(broadcaster.Stats(id).dropped, 0u);
+}
+
+TEST(TelemetryBroadcastTest, DownsamplesBySimulationTime) {
+    TelemetryBroadcaster broadcaster;
+    BroadcastOptions options;
+    options.rate_hz = 10.0;
+    int id = broadcaster.Subscribe(options);
+    BroadcastOptions full;
+    int full_id = broadcaster.Subscribe(full);
+
+    // 1 s 的 1 kHz 帧：10 Hz 订阅者收到 10 帧，间隔 0.1 s（采样时刻的舍入误差可能
+    // 使某一帧落到下一步）
+    PublishFrames(&broadcaster, 0, 1000, 0.001);
+    std::vector<BroadcastFrame> frames = Drain(&broadcaster, id);
+    ASSERT_EQ(frames.size(), 10u);
+    for (int i = 0; i < 10; i++) EXPECT_NEAR(frames[i].time, 0.1 * i, 0.0015);
+    EXPECT_EQ(frames[0].num_values, CHANNEL_COUNT);
+    EXPECT_EQ(Drain(&broadcaster, full_id).size(), 256u);
+
+    // 仿真时间回退后重新开始采样
+    PublishFrames(&broadcaster, 0, 1, 0.001);
+    frames = Drain(&broadcaster, id);
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0].time, 0.0);
+}
+
+TEST(TelemetryBroadcastTest, NextTimesOutAndWakesOnPublish) {
+    TelemetryBroadcaster broadcaster;
+    int id = broadcaster.Subscribe(BroadcastOptions());
+    std::vector<BroadcastFrame> frames;
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(broadcaster.Next(id, &frames, 10, 0.05), 0);
+    double waited = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_GE(waited, 0.04);
+    EXPECT_TRUE(frames.empty());
+
+    std::thread publisher([&broadcaster]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        PublishFrames(&broadcaster, 0, 1, 0.01);
+    });
+    EXPECT_EQ(broadcaster.Next(id, &frames, 10, 5.0), 1);
+    publisher.join();
+}
+
+TEST(TelemetryBroadcastTest, UnsubscribeWakesWaitingConsumer) {
+    TelemetryBroadcaster broadcaster;
+    int id = broadcaster.Subscribe(BroadcastOptions());
+    std::vector<BroadcastFrame> frames;
+    std::thread closer([&broadcaster, id]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        broadcaster.Unsubscribe(id);
+    });
+    EXPECT_EQ(broadcaster.Next(id, &frames, 10, 5.0), -1);
+    closer.join();
+    EXPECT_EQ(broadcaster.NumSubscribers(), 0);
+    EXPECT_EQ(broadcaster.Next(id, &frames, 10, 0.0), -1);
+}
+
+}  // namespace
+}  // namespace mjpc
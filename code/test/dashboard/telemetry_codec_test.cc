@@ -0,0 +1,135 @@
+#include "mjpc/telemetry_codec.h"
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace mjpc {
+namespace {
+
+std::string TempPath(const char* name) {
+    return testing::TempDir() + name;
+}
+
+// 写入 samples 个样本：固定步长的时间戳中夹杂抖动和大跳变，数值为平滑信号加常量、
+// 符号切换和非有限值
+void WriteTestFile(const std::string& path, const std::vector<int>& mantissa_bits,
+                   int samples, int block_size, std::vector<int64_t>* timestamps,
+                   std::vector<std::vector<double>>* values) {
+    TelemetryWriter writer;
+    ASSERT_TRUE(writer.Open(path, {"speed", "constant", "sign", "special"}, mantissa_bits,
+                            block_size));
+    timestamps->clear();
+    values->assign(4, std::vector<double>());
+    int64_t t = 1000;
+    for (int i = 0; i < samples; i++) {
+        t += 2000000 + (i % 7 == 0 ? 37 : 0) + (i % 50 == 0 ? 900000000 : 0);
+        double row[4] = {30.0 + 25.0 * std::sin(0.01 * i), 42.5, i % 3 == 0 ? -1.25 : 7.0,
+                         i % 11 == 0 ? std::numeric_limits<double>::infinity() : 1e-300 * i};
+        ASSERT_TRUE(writer.Append(t, row));
+        timestamps->push_back(t);
+        for (int c = 0; c < 4; c++) (*values)[c].push_back(row[c]);
+    }
+    ASSERT_TRUE(writer.Close());
+}
+
+// 读出全部块，按通道拼接
+void ReadAll(const std::string& path, std::vector<int64_t>* timestamps,
+             std::vector<std::vector<double>>* values, int* blocks) {
+    TelemetryReader reader;
+    ASSERT_TRUE(reader.Open(path));
+    int num_channels = static_cast<int>(reader.Channels().size());
+    timestamps->clear();
+    values->assign(num_channels, std::vector<double>());
+    *blocks = 0;
+    TelemetryBlock block;
+    while (reader.ReadBlock(&block)) {
+        (*blocks)++;
+        timestamps->insert(timestamps->end(), block.timestamps.begin(), block.timestamps.end());
+        for (int c = 0; c < num_channels; c++) {
+            const double* column = block.values.data() + static_cast<size_t>(c) * block.count;
+            (*values)[c].insert((*values)[c].end(), column, column + block.count);
+        }
+    }
+}
+
+TEST(TelemetryCodecTest, LosslessRoundTrip) {
+    std::string path = TempPath("codec_lossless.mjtl");
+    std::vector<int64_t> timestamps, read_timestamps;
+    std::vector<std::vector<double>> values, read_values;
+    WriteTestFile(path, {}, 1000, 256, &timestamps, &values);
+
+    int blocks = 0;
+    ReadAll(path, &read_timestamps, &read_values, &blocks);
+    EXPECT_EQ(blocks, 4);
+    EXPECT_EQ(read_timestamps, timestamps);
+    ASSERT_EQ(read_values.size(), values.size());
+    for (size_t c = 0; c < values.size(); c++) {
+        ASSERT_EQ(read_values[c].size(), values[c].size());
+        for (size_t i = 0; i < values[c].size(); i++) {
+            EXPECT_EQ(read_values[c][i], values[c][i]) << "channel " << c << " sample " << i;
+        }
+    }
+    std::remove(path.c_str());
+}
+
+TEST(TelemetryCodecTest, TruncatedRoundTripMatchesHeader) {
+    // 超出 [0, 52] 的位数被限制：-3 -> 0，60 -> 52（无损）
+    std::string path = TempPath("codec_truncated.mjtl");
+    std::vector<int> bits = {20, -3, 60, 10};
+    std::vector<int64_t> timestamps, read_timestamps;
+    std::vector<std::vector<double>> values, read_values;
+    WriteTestFile(path, bits, 700, 300, &timestamps, &values);
+
+    TelemetryReader reader;
+    ASSERT_TRUE(reader.Open(path));
+    EXPECT_EQ(reader.MantissaBits(), (std::vector<int>{20, 0, 52, 10}));
+    reader.Close();
+
+    int blocks = 0;
+    ReadAll(path, &read_timestamps, &read_values, &blocks);
+    EXPECT_EQ(blocks, 3);
+    EXPECT_EQ(read_timestamps, timestamps);
+    const int clamped[4] = {20, 0, 52, 10};
+    for (size_t c = 0; c < values.size(); c++) {
+        ASSERT_EQ(read_values[c].size(), values[c].size());
+        for (size_t i = 0; i < values[c].size(); i++) {
+            EXPECT_EQ(read_values[c][i], TruncateMantissa(values[c][i], clamped[c]))
+                << "channel " << c << " sample " << i;
+        }
+    }
+    std::remove(path.c_str());
+}
+
+TEST(TelemetryCodecTest, RejectsCorruptColumnLengths) {
+    std::string path = TempPath("codec_corrupt.mjtl");
+    std::vector<int64_t> timestamps;
+    std::vector<std::vector<double>> values;
+    WriteTestFile(path, {}, 100, 4096, &timestamps, &values);
+
+    // 文件头 12 字节 + 每通道 (1 + 名称 + 1)；块的列长度表在 24 + 16 * 4 字节之后
+    size_t header = 12;
+    for (const char* name : {"speed", "constant", "sign", "special"}) {
+        header += 2 + std::string(name).size();
+    }
+    size_t table = header + 24 + 16 * 4;
+    FILE* file = fopen(path.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(fseek(file, static_cast<long>(table + 4), SEEK_SET), 0);
+    const uint8_t huge[4] = {0xFF, 0xFF, 0xFF, 0x7F};
+    ASSERT_EQ(fwrite(huge, 1, 4, file), 4u);
+    fclose(file);
+
+    TelemetryReader reader;
+    ASSERT_TRUE(reader.Open(path));
+    TelemetryBlock block;
+    EXPECT_FALSE(reader.ReadBlock(&block));
+    std::remove(path.c_str());
+}
+
+}  // namespace
+}  // namespace mjpc
@@ -0,0 +1,112 @@
+#include "mjpc/telemetry_pyramid.h"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "mjpc/dashboard_data.h"
+#include "mjpc/telemetry_recorder.h"
+
+namespace mjpc {
+namespace {
+
+std::string TempPath(const char* name) {
+    return testing::TempDir() + name;
+}
+
+// 1 kHz 的锯齿信号：值等于样本序号，便于核对每列的 min/max/样本数
+void Fill(TelemetryPyramid* pyramid, int samples) {
+    pyramid->Reset(1);
+    for (int i = 0; i < samples; i++) {
+        double value = i;
+        pyramid->Append(0.001 * i, &value);
+    }
+}
+
+TEST(TelemetryPyramidTest, QueryCoversEveryColumn) {
+    TelemetryPyramid pyramid;
+    Fill(&pyramid, 100000);
+    std::vector<TelemetryPyramid::Column> columns(200);
+    ASSERT_GE(pyramid.Query(0, 0.0, 99.999, 200, columns.data()), 0);
+    uint64_t total = 0;
+    for (int i = 0; i < 200; i++) {
+        EXPECT_GT(columns[i].count, 0u) << "column " << i;
+        total += columns[i].count;
+    }
+    EXPECT_EQ(total, 100000u);
+}
+
+// 淘汰后旧数据只剩粗层级的桶，每个桶跨越多个像素列：不能只落在中点那一列
+TEST(TelemetryPyramidTest, QueryAfterTrimSpreadsCoarseBuckets) {
+    TelemetryPyramid pyramid;
+    Fill(&pyramid, 200000);
+    size_t before = pyramid.MemoryBytes();
+    ASSERT_GT(pyramid.Trim(before / 8), 0u);
+    EXPECT_TRUE(pyramid.Trimmed());
+
+    const int pixels = 1000;
+    std::vector<TelemetryPyramid::Column> columns(pixels);
+    ASSERT_GE(pyramid.Query(0, 0.0, 199.999, pixels, columns.data()), 0);
+    for (int i = 0; i < pixels; i++) {
+        ASSERT_GT(columns[i].count, 0u) << "column " << i;
+        // 桶的 min/max 覆盖该列的时间段
+        double column_first = 200.0 * i / pixels * 1000.0;
+        EXPECT_LE(columns[i].min, column_first + 1.0) << "column " << i;
+        EXPECT_GE(columns[i].max, column_first) << "column " << i;
+    }
+
+    // 窗口只截取一个粗桶的中间部分时，每列仍有数据
+    std::vector<TelemetryPyramid::Column> narrow(10);
+    ASSERT_GE(pyramid.Query(0, 10.0, 10.1, 10, narrow.data()), 0);
+    for (int i = 0; i < 10; i++) EXPECT_GT(narrow[i].count, 0u) << "column " << i;
+}
+
+TEST(TelemetryPyramidTest, TrimReleasesCapacity) {
+    TelemetryPyramid pyramid;
+    Fill(&pyramid, 200000);
+    size_t before = pyramid.MemoryBytes();
+    size_t budget = before / 4;
+    pyramid.Trim(budget);
+    size_t after = pyramid.MemoryBytes();
+    EXPECT_LE(after, budget);
+
+    // 保留的容量足够继续追加一段而不再次超出预算
+    for (int i = 200000; i < 201000; i++) {
+        double value = i;
+        pyramid.Append(0.001 * i, &value);
+    }
+    EXPECT_LE(pyramid.MemoryBytes(), budget);
+}
+
+// 记录器被 Trim 过时，Close 写出的索引仍覆盖全部样本的完整分辨率
+TEST(TelemetryPyramidTest, RecorderRebuildsTrimmedIndex) {
+    std::string path = TempPath("pyramid_test.mjtl");
+    std::remove(TelemetryIndexPath(path).c_str());
+    TelemetryRecorder recorder;
+    ASSERT_TRUE(recorder.Open(path));
+    DashboardData data;
+    const int samples = 50000;
+    for (int i = 0; i < samples; i++) {
+        data.speed_ms = i % 100;
+        ASSERT_TRUE(recorder.Record(0.002 * i, data));
+        if (i % 1000 == 999) recorder.Trim(64 << 10);
+    }
+    ASSERT_TRUE(recorder.Pyramid().Trimmed());
+    ASSERT_TRUE(recorder.Close());
+
+    TelemetryPyramid index;
+    ASSERT_TRUE(index.Load(TelemetryIndexPath(path)));
+    EXPECT_FALSE(index.Trimmed());
+    EXPECT_EQ(index.NumSamples(), static_cast<uint64_t>(samples));
+
+    TelemetryPyramid loaded;
+    ASSERT_TRUE(LoadOrBuildTelemetryIndex(path, &loaded));
+    EXPECT_FALSE(loaded.Trimmed());
+    std::remove(path.c_str());
+    std::remove(TelemetryIndexPath(path).c_str());
+}
+
+}  // namespace
+}  // namespace mjpc